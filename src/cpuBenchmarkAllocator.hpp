@@ -0,0 +1,542 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the harness run arena as the bump allocator.
+
+#ifndef _CPUBENCHMARKALLOCATOR_HPP_
+#define _CPUBENCHMARKALLOCATOR_HPP_
+
+#define ALLOCATOR_OPERATIONS_DEFAULT (1 << 22) // Allocate and free pairs per thread
+#define ALLOCATOR_LIVE 4096 // Objects held live per round, also the cross thread batch
+#define ALLOCATOR_FIXED_BYTES 64 // Object size of the fixed size pattern
+#define ALLOCATOR_CLASS_MIN_SHIFT 4 // Size classes are powers of two from 16 bytes ...
+#define ALLOCATOR_CLASS_COUNT 9 // ... to 4 KiB, also the largest random size
+#define ALLOCATOR_SLAB_BYTES (1 << 20) // Pools carve their blocks from slabs of this size
+#define ALLOCATOR_MAILBOX_DEPTH 2 // Full batches a producer may run ahead of its consumer
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum allocatorKind_e {
+  ak_malloc_e = 0, // C library malloc and free
+  ak_pool_e = 1, // Per thread size class free lists over slabs, remote frees through a locked list
+  ak_arena_e = 2, // Per thread run arena, free does nothing and the arena is reset per round
+  ak_count_e = 3
+} allocatorKind_et;
+
+typedef enum allocatorPattern_e {
+  ap_fixedLifo_e = 0, // ALLOCATOR_FIXED_BYTES objects, freed newest first
+  ap_randomSize_e = 1, // Log uniform sizes up to 4 KiB, freed in random order
+  ap_crossThread_e = 2, // Random sizes allocated by one thread and freed by its partner
+  ap_count_e = 3
+} allocatorPattern_et;
+
+// Size class allocator owned by one thread; other threads may only return blocks to it.
+typedef struct allocatorPool {
+  void *freeList[ALLOCATOR_CLASS_COUNT]; // Intrusive singly linked free blocks per class
+  void *remoteList[ALLOCATOR_CLASS_COUNT]; // Blocks freed by other threads, written under remoteLock with atomics
+  pthread_mutex_t remoteLock;
+  uint8_t *slabCursor; // Next unused byte of the newest slab
+  uint8_t *slabEnd;
+  std::vector<void *> slabs; // Every slab, returned when the pool is destroyed
+} allocatorPool_t;
+
+typedef struct allocatorBlock {
+  void *address;
+  size_t bytes;
+} allocatorBlock_t;
+
+// Hands full batches from a producer to its consumer.
+typedef struct allocatorMailbox {
+  pthread_mutex_t lock;
+  pthread_cond_t changed;
+  size_t produced; // Batches published
+  size_t consumed; // Batches freed
+  std::vector<allocatorBlock_t> batches[ALLOCATOR_MAILBOX_DEPTH + 1]; // Batch n lives in n % (depth + 1)
+} allocatorMailbox_t;
+
+typedef struct alignas(CACHE_LINE_SIZE) allocatorThread {
+  allocatorKind_et kind; // Allocator under test
+  allocatorPattern_et pattern; // Allocation pattern
+  size_t threadIndex; // Odd threads of the cross thread pattern are consumers
+  size_t operations; // Allocate and free pairs of this thread
+  uint64_t randomState; // Per thread xorshift for sizes and order
+  allocatorPool_t *pool; // Own pool, or the producer's pool for a consumer
+  allocatorMailbox_t *mailbox; // Shared by a producer and consumer pair
+  pthread_barrier_t *startBarrier; // Releases all threads at once
+  size_t corrupt; // Blocks whose tag did not survive until the free
+  double timeDelta; // Time for the pattern
+} allocatorThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *allocatorKindName(allocatorKind_et kind);
+
+const char *allocatorPatternName(allocatorPattern_et pattern);
+
+size_t allocatorClass(size_t bytes);
+
+void allocatorPoolInit(allocatorPool_t &pool);
+
+void allocatorPoolDestroy(allocatorPool_t &pool);
+
+void *allocatorPoolAllocate(allocatorPool_t &pool, size_t bytes);
+
+void allocatorPoolFree(allocatorPool_t &pool, void *address, size_t bytes);
+
+void allocatorPoolFreeRemote(allocatorPool_t &pool, void *address, size_t bytes);
+
+size_t allocatorRandomBytes(uint64_t &randomState);
+
+void *allocatorAllocate(allocatorThread_t *threadInfo, runArena_t &arena, size_t bytes);
+
+void allocatorFree(allocatorThread_t *threadInfo, void *address, size_t bytes);
+
+void *allocator_Pthread(void *inArgs);
+
+void allocatorMeasure(FILE *fileContext, allocatorKind_et kind, allocatorPattern_et pattern, size_t threadCount,
+                      size_t operations);
+
+int testharness_Allocator(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the allocator.
+*****************************************************************************/
+const char *allocatorKindName(allocatorKind_et kind) {
+  const char *kindName;
+  switch (kind) {
+    case ak_malloc_e:
+      kindName = "malloc";
+      break;
+    case ak_pool_e:
+      kindName = "size_class_pool";
+      break;
+    case ak_arena_e:
+      kindName = "bump_arena";
+      break;
+    default:
+      kindName = "unknown";
+      break;
+  }
+  return kindName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the pattern.
+*****************************************************************************/
+const char *allocatorPatternName(allocatorPattern_et pattern) {
+  const char *patternName;
+  switch (pattern) {
+    case ap_fixedLifo_e:
+      patternName = "fixed_lifo";
+      break;
+    case ap_randomSize_e:
+      patternName = "random_size";
+      break;
+    case ap_crossThread_e:
+      patternName = "cross_thread";
+      break;
+    default:
+      patternName = "unknown";
+      break;
+  }
+  return patternName;
+}
+
+/******************************************************************************
+*
+* @return  index of the smallest size class holding bytes.
+*****************************************************************************/
+size_t allocatorClass(size_t bytes) {
+  size_t sizeClass = 0;
+
+  while ((((size_t) 1 << (ALLOCATOR_CLASS_MIN_SHIFT + sizeClass)) < bytes) &&
+         (sizeClass < (ALLOCATOR_CLASS_COUNT - 1))) {
+    sizeClass++;
+  }
+  return sizeClass;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+void allocatorPoolInit(allocatorPool_t &pool) {
+  for (size_t sizeClass = 0; sizeClass < ALLOCATOR_CLASS_COUNT; sizeClass++) {
+    pool.freeList[sizeClass] = NULL;
+    pool.remoteList[sizeClass] = NULL;
+  }
+  pthread_mutex_init(&pool.remoteLock, NULL);
+  pool.slabCursor = NULL;
+  pool.slabEnd = NULL;
+  pool.slabs.clear();
+  return;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+void allocatorPoolDestroy(allocatorPool_t &pool) {
+  for (size_t slab = 0; slab < pool.slabs.size(); slab++) {
+    free(pool.slabs[slab]);
+  }
+  pool.slabs.clear();
+  pthread_mutex_destroy(&pool.remoteLock);
+  return;
+}
+
+/******************************************************************************
+* Pops the local free list, takes the whole remote list when the local one is
+* empty, and carves a new block from the slab last.
+* @return  block of at least bytes, NULL when out of memory.
+*****************************************************************************/
+void *allocatorPoolAllocate(allocatorPool_t &pool, size_t bytes) {
+  const size_t sizeClass = allocatorClass(bytes);
+  const size_t classBytes = (size_t) 1 << (ALLOCATOR_CLASS_MIN_SHIFT + sizeClass);
+  void *block = pool.freeList[sizeClass];
+
+  // Lock free peek, a block pushed meanwhile is picked up on a later miss.
+  if ((NULL == block) && (NULL != __atomic_load_n(&pool.remoteList[sizeClass], __ATOMIC_RELAXED))) {
+    pthread_mutex_lock(&pool.remoteLock);
+    block = pool.remoteList[sizeClass];
+    __atomic_store_n(&pool.remoteList[sizeClass], NULL, __ATOMIC_RELAXED);
+    pthread_mutex_unlock(&pool.remoteLock);
+  }
+  if (NULL != block) {
+    pool.freeList[sizeClass] = *(void **) block;
+    return block;
+  }
+  if ((NULL == pool.slabCursor) || ((size_t) (pool.slabEnd - pool.slabCursor) < classBytes)) {
+    pool.slabCursor = (uint8_t *) aligned_alloc(CACHE_LINE_SIZE, ALLOCATOR_SLAB_BYTES);
+    if (NULL == pool.slabCursor) {
+      return NULL;
+    }
+    pool.slabs.push_back(pool.slabCursor);
+    pool.slabEnd = pool.slabCursor + ALLOCATOR_SLAB_BYTES;
+  }
+  block = pool.slabCursor;
+  pool.slabCursor += classBytes;
+  return block;
+}
+
+/******************************************************************************
+* Free by the owning thread.
+* @return  None
+*****************************************************************************/
+void allocatorPoolFree(allocatorPool_t &pool, void *address, size_t bytes) {
+  const size_t sizeClass = allocatorClass(bytes);
+
+  *(void **) address = pool.freeList[sizeClass];
+  pool.freeList[sizeClass] = address;
+  return;
+}
+
+/******************************************************************************
+* Free by any other thread, the owner picks the block up on its next miss.
+* @return  None
+*****************************************************************************/
+void allocatorPoolFreeRemote(allocatorPool_t &pool, void *address, size_t bytes) {
+  const size_t sizeClass = allocatorClass(bytes);
+
+  pthread_mutex_lock(&pool.remoteLock);
+  *(void **) address = pool.remoteList[sizeClass];
+  __atomic_store_n(&pool.remoteList[sizeClass], address, __ATOMIC_RELAXED);
+  pthread_mutex_unlock(&pool.remoteLock);
+  return;
+}
+
+/******************************************************************************
+* Draws a size class uniformly, then a size uniformly within that class, so
+* every class from 16 bytes to 4 KiB is hit equally.
+* @return  request size in bytes.
+*****************************************************************************/
+size_t allocatorRandomBytes(uint64_t &randomState) {
+  size_t sizeClass, lowBytes, highBytes;
+
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 7;
+  randomState ^= randomState << 17;
+  sizeClass = (size_t) ((randomState >> 32) % ALLOCATOR_CLASS_COUNT);
+  highBytes = (size_t) 1 << (ALLOCATOR_CLASS_MIN_SHIFT + sizeClass);
+  lowBytes = (sizeClass == 0) ? 0 : (highBytes >> 1);
+  return lowBytes + 1 + (size_t) ((randomState & 0xFFFFFFFF) % (highBytes - lowBytes));
+}
+
+/******************************************************************************
+*
+* @return  block of at least bytes, NULL when out of memory.
+*****************************************************************************/
+void *allocatorAllocate(allocatorThread_t *threadInfo, runArena_t &arena, size_t bytes) {
+  void *address;
+  switch (threadInfo->kind) {
+    case ak_pool_e:
+      address = allocatorPoolAllocate(*threadInfo->pool, bytes);
+      break;
+    case ak_arena_e:
+      address = arenaAllocateUnlocked(arena, bytes, alignof(max_align_t));
+      break;
+    case ak_malloc_e:
+    default:
+      address = malloc(bytes);
+      break;
+  }
+  return address;
+}
+
+/******************************************************************************
+* Consumers of the cross thread pattern free into the producer's pool.
+* @return  None
+*****************************************************************************/
+void allocatorFree(allocatorThread_t *threadInfo, void *address, size_t bytes) {
+  switch (threadInfo->kind) {
+    case ak_pool_e:
+      if (ap_crossThread_e == threadInfo->pattern) {
+        allocatorPoolFreeRemote(*threadInfo->pool, address, bytes);
+      } else {
+        allocatorPoolFree(*threadInfo->pool, address, bytes);
+      }
+      break;
+    case ak_arena_e:
+      break;
+    case ak_malloc_e:
+    default:
+      free(address);
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* Runs rounds of ALLOCATOR_LIVE allocations followed by their frees. Every
+* block is tagged with its size in the first and last byte, checked before
+* the free.
+* @return  the thread arguments.
+*****************************************************************************/
+void *allocator_Pthread(void *inArgs) {
+  allocatorThread_t *threadInfo = (allocatorThread_t *) inArgs;
+  allocatorMailbox_t *mailbox = threadInfo->mailbox;
+  const bool isConsumer = (ap_crossThread_e == threadInfo->pattern) && (0 != (threadInfo->threadIndex & 1));
+  const size_t rounds = (threadInfo->operations + ALLOCATOR_LIVE - 1) / ALLOCATOR_LIVE;
+  std::vector<allocatorBlock_t> local(ALLOCATOR_LIVE);
+  std::vector<allocatorBlock_t> *batch;
+  runArena_t arena = {PTHREAD_MUTEX_INITIALIZER, NULL, NULL, NULL, 0};
+  uint8_t *block;
+  size_t swapIndex;
+  double timeStart;
+
+  auto tagIsValid = [](const allocatorBlock_t &entry) -> bool {
+    const uint8_t *bytes = (const uint8_t *) entry.address;
+    return (NULL != bytes) && ((uint8_t) entry.bytes == bytes[0]) && ((uint8_t) entry.bytes == bytes[entry.bytes - 1]);
+  };
+
+  pthread_barrier_wait(threadInfo->startBarrier);
+  timeStart = getTime();
+  for (size_t round = 0; round < rounds; round++) {
+    if (isConsumer) {
+      pthread_mutex_lock(&mailbox->lock);
+      while (mailbox->consumed == mailbox->produced) {
+        pthread_cond_wait(&mailbox->changed, &mailbox->lock);
+      }
+      batch = &mailbox->batches[mailbox->consumed % (ALLOCATOR_MAILBOX_DEPTH + 1)];
+      pthread_mutex_unlock(&mailbox->lock);
+      for (size_t index = 0; index < ALLOCATOR_LIVE; index++) {
+        threadInfo->corrupt += tagIsValid((*batch)[index]) ? 0 : 1;
+        allocatorFree(threadInfo, (*batch)[index].address, (*batch)[index].bytes);
+      }
+      pthread_mutex_lock(&mailbox->lock);
+      mailbox->consumed++;
+      pthread_cond_broadcast(&mailbox->changed);
+      pthread_mutex_unlock(&mailbox->lock);
+      continue;
+    }
+    batch = &local;
+    if (ap_crossThread_e == threadInfo->pattern) {
+      pthread_mutex_lock(&mailbox->lock);
+      while ((mailbox->produced - mailbox->consumed) >= ALLOCATOR_MAILBOX_DEPTH) {
+        pthread_cond_wait(&mailbox->changed, &mailbox->lock);
+      }
+      batch = &mailbox->batches[mailbox->produced % (ALLOCATOR_MAILBOX_DEPTH + 1)];
+      pthread_mutex_unlock(&mailbox->lock);
+    }
+    for (size_t index = 0; index < ALLOCATOR_LIVE; index++) {
+      (*batch)[index].bytes = (ap_fixedLifo_e == threadInfo->pattern) ? ALLOCATOR_FIXED_BYTES :
+                              allocatorRandomBytes(threadInfo->randomState);
+      block = (uint8_t *) allocatorAllocate(threadInfo, arena, (*batch)[index].bytes);
+      (*batch)[index].address = block;
+      if (NULL != block) {
+        block[0] = (uint8_t) (*batch)[index].bytes;
+        block[(*batch)[index].bytes - 1] = (uint8_t) (*batch)[index].bytes;
+      }
+    }
+    switch (threadInfo->pattern) {
+      case ap_crossThread_e:
+        pthread_mutex_lock(&mailbox->lock);
+        mailbox->produced++;
+        pthread_cond_broadcast(&mailbox->changed);
+        pthread_mutex_unlock(&mailbox->lock);
+        break;
+      case ap_randomSize_e:
+        for (size_t index = ALLOCATOR_LIVE - 1; index > 0; index--) {
+          threadInfo->randomState ^= threadInfo->randomState << 13;
+          threadInfo->randomState ^= threadInfo->randomState >> 7;
+          threadInfo->randomState ^= threadInfo->randomState << 17;
+          swapIndex = (size_t) (threadInfo->randomState % (index + 1));
+          std::swap(local[index], local[swapIndex]);
+        }
+        for (size_t index = 0; index < ALLOCATOR_LIVE; index++) {
+          threadInfo->corrupt += tagIsValid(local[index]) ? 0 : 1;
+          allocatorFree(threadInfo, local[index].address, local[index].bytes);
+        }
+        break;
+      case ap_fixedLifo_e:
+      default:
+        for (size_t index = ALLOCATOR_LIVE; index > 0; index--) {
+          threadInfo->corrupt += tagIsValid(local[index - 1]) ? 0 : 1;
+          allocatorFree(threadInfo, local[index - 1].address, local[index - 1].bytes);
+        }
+        break;
+    }
+    if (ak_arena_e == threadInfo->kind) {
+      arenaReset(arena);
+    }
+  }
+  threadInfo->timeDelta = getTime() - timeStart;
+  arenaRelease(arena);
+  return inArgs;
+}
+
+/******************************************************************************
+* One allocator and pattern on a team of threads, each with its own pool;
+* the cross thread pattern pairs every producer with the next thread.
+* @return  None
+*****************************************************************************/
+void allocatorMeasure(FILE *fileContext, allocatorKind_et kind, allocatorPattern_et pattern, size_t threadCount,
+                      size_t operations) {
+  const size_t pairs = (threadCount + 1) / 2;
+  std::vector<allocatorThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  std::vector<allocatorPool_t> pools(threadCount);
+  std::vector<allocatorMailbox_t> mailboxes(pairs);
+  pthread_barrier_t startBarrier;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  size_t corrupt = 0, producers = 0, rounds = (operations + ALLOCATOR_LIVE - 1) / ALLOCATOR_LIVE;
+  double timeDelta = 0.0;
+  bool isValid;
+
+  pthread_barrier_init(&startBarrier, NULL, threadCount);
+  for (size_t pair = 0; pair < pairs; pair++) {
+    pthread_mutex_init(&mailboxes[pair].lock, NULL);
+    pthread_cond_init(&mailboxes[pair].changed, NULL);
+    mailboxes[pair].produced = 0;
+    mailboxes[pair].consumed = 0;
+    for (size_t slot = 0; slot <= ALLOCATOR_MAILBOX_DEPTH; slot++) {
+      mailboxes[pair].batches[slot].resize(ALLOCATOR_LIVE);
+    }
+  }
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    allocatorPoolInit(pools[threadIndex]);
+  }
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    threadInfo[threadIndex].kind = kind;
+    threadInfo[threadIndex].pattern = pattern;
+    threadInfo[threadIndex].threadIndex = threadIndex;
+    threadInfo[threadIndex].operations = operations;
+    threadInfo[threadIndex].randomState = 0x9E3779B97F4A7C15ULL * (threadIndex + 1);
+    // A consumer returns blocks to its producer's pool.
+    threadInfo[threadIndex].pool = ((ap_crossThread_e == pattern) && (0 != (threadIndex & 1))) ?
+                                   &pools[threadIndex - 1] : &pools[threadIndex];
+    threadInfo[threadIndex].mailbox = &mailboxes[threadIndex / 2];
+    threadInfo[threadIndex].startBarrier = &startBarrier;
+    threadInfo[threadIndex].corrupt = 0;
+    threadInfo[threadIndex].timeDelta = 0.0;
+    threadArgs[threadIndex] = &threadInfo[threadIndex];
+  }
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  isValid = threadTeamRun(allocator_Pthread, threadArgs, true);
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  pthread_barrier_destroy(&startBarrier);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    timeDelta = std::max(timeDelta, threadInfo[threadIndex].timeDelta);
+    corrupt += threadInfo[threadIndex].corrupt;
+    producers += ((ap_crossThread_e == pattern) && (0 != (threadIndex & 1))) ? 0 : 1;
+    allocatorPoolDestroy(pools[threadIndex]);
+  }
+  for (size_t pair = 0; pair < pairs; pair++) {
+    pthread_mutex_destroy(&mailboxes[pair].lock);
+    pthread_cond_destroy(&mailboxes[pair].changed);
+  }
+  // Pairs count once, by the producing thread.
+  operations = producers * rounds * ALLOCATOR_LIVE;
+  resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %f, %f, %f, %zu, %d", allocatorKindName(kind),
+                 allocatorPatternName(pattern), threadCount, operations, timeDelta,
+                 (operations > 0) ? ((timeDelta * 1e9) / ((double) operations / (double) producers)) : 0.0,
+                 (timeDelta > 0.0) ? ((double) operations / timeDelta / 1e6) : 0.0, corrupt,
+                 (isValid && (0 == corrupt)) ? 1 : 0);
+  return;
+}
+
+/******************************************************************************
+* Measures malloc, a size class pool and the bump arena on fixed size LIFO,
+* random size random order and cross thread free patterns, for thread counts
+* doubling up to the thread count. The cross thread pattern needs a
+* producer and consumer pair, so it starts at two threads.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Allocator(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Allocator, Pattern, Threads, Allocate Free Pairs, Time for Operations, "
+                            "Nanoseconds per Pair per Thread, Million Pairs per Second, Corrupt Blocks, Verified";
+  size_t operations = (options.iterations > 0) ? options.iterations : ALLOCATOR_OPERATIONS_DEFAULT;
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  size_t threadFirst, threadLast;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("The bump arena has no free, it is released after every round of %d allocations.\n", ALLOCATOR_LIVE);
+  fileContext = resultFileOpen("Allocator", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  for (size_t pattern = 0; pattern < ap_count_e; pattern++) {
+    for (size_t kind = 0; kind < ak_count_e; kind++) {
+      // An arena cannot take frees from another thread.
+      if ((ap_crossThread_e == pattern) && (ak_arena_e == kind)) {
+        continue;
+      }
+      threadFirst = (ap_crossThread_e == pattern) ? 2 : 1;
+      threadLast = (ap_crossThread_e == pattern) ? std::max((size_t) 2, threadMax & ~(size_t) 1) : threadMax;
+      for (size_t threadCount = threadFirst; threadCount <= threadLast;) {
+        allocatorMeasure(fileContext, (allocatorKind_et) kind, (allocatorPattern_et) pattern, threadCount, operations);
+        if ((threadCount < threadLast) && ((2 * threadCount) > threadLast)) {
+          threadCount = threadLast;
+        } else {
+          threadCount *= 2;
+        }
+      }
+    }
+  }
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKALLOCATOR_HPP_
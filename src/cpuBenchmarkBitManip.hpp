@@ -0,0 +1,487 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKBITMANIP_HPP_
+#define _CPUBENCHMARKBITMANIP_HPP_
+
+#include <utility>
+
+// Bit manipulation extensions are compiled per function and selected at run time.
+#if defined(__x86_64__) | defined(__i386__)
+#define BITMANIP_EXTENSION_ENABLE 1
+#define BITMANIP_TARGET "popcnt,lzcnt,bmi,bmi2"
+#else
+#define BITMANIP_EXTENSION_ENABLE 0
+#endif
+
+#define BITMANIP_ITERATIONS_DEFAULT (1 << 24)
+#define BITMANIP_ARRAY_SIZE (1 << 12) // Power of two, the index wraps with a mask.
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum bitManipOp_e {
+  bo_popcount_e = 0,
+  bo_lzcnt_e = 1,
+  bo_tzcnt_e = 2,
+  bo_shiftLeft_e = 3,
+  bo_shiftRight_e = 4,
+  bo_rotateLeft_e = 5,
+  bo_rotateRight_e = 6,
+  bo_pext_e = 7,
+  bo_pdep_e = 8,
+  bo_bswap_e = 9,
+  bo_and_e = 10,
+  bo_or_e = 11,
+  bo_xor_e = 12,
+  bo_count_e = 13
+} bitManipOp_et;
+
+typedef enum bitManipImplementation_e {
+  bi_hardware_e = 0, // Extension instruction, or plain code when the operation is in the base ISA
+  bi_software_e = 1, // Portable fallback used when the extension is missing
+  bi_count_e = 2
+} bitManipImplementation_et;
+
+typedef struct bitManipOpInfo {
+  const char *name; // Printable operation name
+  const char *isa; // Instruction set extension of the hardware implementation
+  bool hasExtension; // Hardware implementation needs BITMANIP_TARGET
+  bool hasSoftware; // A portable fallback exists
+} bitManipOpInfo_t;
+
+const bitManipOpInfo_t bitManipOpTable[bo_count_e] = {
+  {"popcount", "POPCNT", true, true},
+  {"lzcnt", "LZCNT", true, true},
+  {"tzcnt", "BMI1", true, true},
+  {"shift_left", "base", false, false},
+  {"shift_right", "base", false, false},
+  {"rotate_left", "base", false, false},
+  {"rotate_right", "base", false, false},
+  {"pext", "BMI2", true, true},
+  {"pdep", "BMI2", true, true},
+  {"bswap", "base", false, true},
+  {"and", "base", false, false},
+  {"or", "base", false, false},
+  {"xor", "base", false, false}
+};
+
+typedef struct bitManipTiming {
+  double timeDelta; // Seconds for the loop
+  uint64_t cycleDelta; // Time stamp counter cycles for the loop
+} bitManipTiming_t;
+
+template<class unsignedType>
+using bitManipMeasure_ft = bitManipTiming_t (*)(const unsignedType *a, const unsignedType *b, unsignedType *out,
+                                               size_t iterations);
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+uint64_t bitManipPopcountSoftware(uint64_t x);
+
+uint64_t bitManipLzcntSoftware(uint64_t x);
+
+uint64_t bitManipPextSoftware(uint64_t x, uint64_t mask);
+
+uint64_t bitManipPdepSoftware(uint64_t x, uint64_t mask);
+
+template<size_t op, class unsignedType>
+unsignedType bitManipBaseline(unsignedType a, unsignedType b);
+
+template<size_t op, class unsignedType>
+unsignedType bitManipSoftware(unsignedType a, unsignedType b);
+
+#if BITMANIP_EXTENSION_ENABLE
+template<size_t op, class unsignedType>
+__attribute__((target(BITMANIP_TARGET))) unsignedType bitManipExtension(unsignedType a, unsignedType b);
+
+template<size_t op, class unsignedType>
+__attribute__((noinline, target(BITMANIP_TARGET), optimize("no-tree-vectorize")))
+bitManipTiming_t bitManipMeasureExtension(const unsignedType *a, const unsignedType *b, unsignedType *out,
+                                          size_t iterations);
+#endif // BITMANIP_EXTENSION_ENABLE
+
+template<size_t op, class unsignedType, bool isSoftware>
+bitManipTiming_t bitManipMeasure(const unsignedType *a, const unsignedType *b, unsignedType *out, size_t iterations);
+
+template<class unsignedType, size_t... op>
+void bitManipMeasureTableFill(bitManipMeasure_ft<unsignedType> measureTable[bi_count_e][bo_count_e],
+                              std::index_sequence<op...>);
+
+template<class classType>
+void bitManipMeasureType(FILE *fileContext, size_t iterations, bool isExtensionAvailable);
+
+int testharness_BitManip(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+* SWAR population count.
+* @return  number of set bits.
+*****************************************************************************/
+inline uint64_t bitManipPopcountSoftware(uint64_t x) {
+  x = x - ((x >> 1) & 0x5555555555555555ULL);
+  x = (x & 0x3333333333333333ULL) + ((x >> 2) & 0x3333333333333333ULL);
+  x = (x + (x >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+  return (x * 0x0101010101010101ULL) >> 56;
+}
+
+/******************************************************************************
+* Binary search for the highest set bit.
+* @return  leading zeros of the 64 bit value, 64 for zero.
+*****************************************************************************/
+inline uint64_t bitManipLzcntSoftware(uint64_t x) {
+  uint64_t count = 0;
+
+  if (0 == x) {
+    return 64;
+  }
+  if (x <= 0x00000000FFFFFFFFULL) {
+    count += 32;
+    x <<= 32;
+  }
+  if (x <= 0x0000FFFFFFFFFFFFULL) {
+    count += 16;
+    x <<= 16;
+  }
+  if (x <= 0x00FFFFFFFFFFFFFFULL) {
+    count += 8;
+    x <<= 8;
+  }
+  if (x <= 0x0FFFFFFFFFFFFFFFULL) {
+    count += 4;
+    x <<= 4;
+  }
+  if (x <= 0x3FFFFFFFFFFFFFFFULL) {
+    count += 2;
+    x <<= 2;
+  }
+  if (x <= 0x7FFFFFFFFFFFFFFFULL) {
+    count += 1;
+  }
+  return count;
+}
+
+/******************************************************************************
+* Gathers the bits of x selected by mask into the low bits, one mask bit at a
+* time.
+* @return  extracted bits.
+*****************************************************************************/
+inline uint64_t bitManipPextSoftware(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+
+  for (uint64_t bit = 1; 0 != mask; bit <<= 1) {
+    if (0 != (x & mask & (0 - mask))) {
+      result |= bit;
+    }
+    mask &= mask - 1;
+  }
+  return result;
+}
+
+/******************************************************************************
+* Scatters the low bits of x to the positions selected by mask.
+* @return  deposited bits.
+*****************************************************************************/
+inline uint64_t bitManipPdepSoftware(uint64_t x, uint64_t mask) {
+  uint64_t result = 0;
+
+  for (uint64_t bit = 1; 0 != mask; bit <<= 1) {
+    if (0 != (x & bit)) {
+      result |= mask & (0 - mask);
+    }
+    mask &= mask - 1;
+  }
+  return result;
+}
+
+/******************************************************************************
+* Operations of the base instruction set; counts and bit extract/deposit use
+* the compiler builtins or the fallbacks, whichever the target provides.
+* @return  op applied to a, with b as shift amount or mask.
+*****************************************************************************/
+template<size_t op, class unsignedType>
+inline unsignedType bitManipBaseline(unsignedType a, unsignedType b) {
+  constexpr unsigned width = sizeof(unsignedType) * CHAR_BIT;
+  unsigned shift = (unsigned) b & (width - 1);
+
+  if constexpr (bo_shiftLeft_e == op) {
+    return (unsignedType) (a << shift);
+  } else if constexpr (bo_shiftRight_e == op) {
+    return (unsignedType) (a >> shift);
+  } else if constexpr (bo_rotateLeft_e == op) {
+    return (unsignedType) ((a << shift) | (a >> ((width - shift) & (width - 1))));
+  } else if constexpr (bo_rotateRight_e == op) {
+    return (unsignedType) ((a >> shift) | (a << ((width - shift) & (width - 1))));
+  } else if constexpr (bo_bswap_e == op) {
+    if constexpr (1 == sizeof(unsignedType)) {
+      return a;
+    } else if constexpr (2 == sizeof(unsignedType)) {
+      return __builtin_bswap16(a);
+    } else if constexpr (4 == sizeof(unsignedType)) {
+      return __builtin_bswap32(a);
+    } else {
+      return __builtin_bswap64(a);
+    }
+  } else if constexpr (bo_and_e == op) {
+    return (unsignedType) (a & b);
+  } else if constexpr (bo_or_e == op) {
+    return (unsignedType) (a | b);
+  } else if constexpr (bo_xor_e == op) {
+    return (unsignedType) (a ^ b);
+  } else {
+    return bitManipSoftware<op, unsignedType>(a, b);
+  }
+}
+
+/******************************************************************************
+* Portable fallbacks, no instruction set extension required.
+* @return  op applied to a, with b as mask.
+*****************************************************************************/
+template<size_t op, class unsignedType>
+inline unsignedType bitManipSoftware(unsignedType a, unsignedType b) {
+  constexpr unsigned width = sizeof(unsignedType) * CHAR_BIT;
+
+  if constexpr (bo_popcount_e == op) {
+    return (unsignedType) bitManipPopcountSoftware(a);
+  } else if constexpr (bo_lzcnt_e == op) {
+    return (unsignedType) (bitManipLzcntSoftware(a) - (64 - width));
+  } else if constexpr (bo_tzcnt_e == op) {
+    return (0 == a) ? (unsignedType) width : (unsignedType) bitManipPopcountSoftware((a & (0 - a)) - 1);
+  } else if constexpr (bo_pext_e == op) {
+    return (unsignedType) bitManipPextSoftware(a, b);
+  } else if constexpr (bo_pdep_e == op) {
+    return (unsignedType) bitManipPdepSoftware(a, b);
+  } else if constexpr (bo_bswap_e == op) {
+    unsignedType result = 0;
+    for (size_t byte = 0; byte < sizeof(unsignedType); byte++) {
+      result = (unsignedType) ((result << CHAR_BIT) | ((a >> (CHAR_BIT * byte)) & 0xFF));
+    }
+    return result;
+  } else {
+    return bitManipBaseline<op, unsignedType>(a, b);
+  }
+}
+
+#if BITMANIP_EXTENSION_ENABLE
+/******************************************************************************
+* Extension instructions. Widths below 32 bits use the 32 bit forms, with
+* the count adjusted (lzcnt) or a sentinel bit at the type width (tzcnt).
+* @return  op applied to a, with b as mask.
+*****************************************************************************/
+template<size_t op, class unsignedType>
+__attribute__((target(BITMANIP_TARGET))) inline unsignedType bitManipExtension(unsignedType a, unsignedType b) {
+  constexpr unsigned width = sizeof(unsignedType) * CHAR_BIT;
+
+  if constexpr (bo_popcount_e == op) {
+    return (unsignedType) __builtin_popcountll(a);
+  } else if constexpr ((bo_lzcnt_e == op) && (width <= 32)) {
+    return (unsignedType) (_lzcnt_u32(a) - (32 - width));
+  } else if constexpr (bo_lzcnt_e == op) {
+    return (unsignedType) _lzcnt_u64(a);
+  } else if constexpr ((bo_tzcnt_e == op) && (width < 32)) {
+    return (unsignedType) _tzcnt_u32((uint32_t) a | (1U << width));
+  } else if constexpr ((bo_tzcnt_e == op) && (width == 32)) {
+    return (unsignedType) _tzcnt_u32(a);
+  } else if constexpr (bo_tzcnt_e == op) {
+    return (unsignedType) _tzcnt_u64(a);
+  } else if constexpr ((bo_pext_e == op) && (width <= 32)) {
+    return (unsignedType) _pext_u32(a, b);
+  } else if constexpr (bo_pext_e == op) {
+    return (unsignedType) _pext_u64(a, b);
+  } else if constexpr ((bo_pdep_e == op) && (width <= 32)) {
+    return (unsignedType) _pdep_u32(a, b);
+  } else if constexpr (bo_pdep_e == op) {
+    return (unsignedType) _pdep_u64(a, b);
+  } else {
+    return bitManipBaseline<op, unsignedType>(a, b);
+  }
+}
+
+/******************************************************************************
+* Independent operations over the operand arrays, compiled for the
+* extension set; only called when the processor reports all of it.
+* @return  loop time and cycles.
+*****************************************************************************/
+template<size_t op, class unsignedType>
+__attribute__((noinline, target(BITMANIP_TARGET), optimize("no-tree-vectorize")))
+bitManipTiming_t bitManipMeasureExtension(const unsignedType *a, const unsignedType *b, unsignedType *out,
+                                          size_t iterations) {
+  bitManipTiming_t timing;
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    out[index] = bitManipExtension<op, unsignedType>(a[index], b[index]);
+    index = (index + 1) & (BITMANIP_ARRAY_SIZE - 1);
+  }
+  timing.cycleDelta = getCycleCount() - cycleStart;
+  timing.timeDelta = getTime() - timeStart;
+  return timing;
+}
+#endif // BITMANIP_EXTENSION_ENABLE
+
+/******************************************************************************
+* Same loop as bitManipMeasureExtension for the base instruction set or the
+* software fallback. Vectorization is off so scalar instruction cost is
+* measured.
+* @return  loop time and cycles.
+*****************************************************************************/
+template<size_t op, class unsignedType, bool isSoftware>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+bitManipTiming_t bitManipMeasure(const unsignedType *a, const unsignedType *b, unsignedType *out, size_t iterations) {
+  bitManipTiming_t timing;
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    if constexpr (isSoftware) {
+      out[index] = bitManipSoftware<op, unsignedType>(a[index], b[index]);
+    } else {
+      out[index] = bitManipBaseline<op, unsignedType>(a[index], b[index]);
+    }
+    index = (index + 1) & (BITMANIP_ARRAY_SIZE - 1);
+  }
+  timing.cycleDelta = getCycleCount() - cycleStart;
+  timing.timeDelta = getTime() - timeStart;
+  return timing;
+}
+
+/******************************************************************************
+* Hardware entries of extension operations point at the extension loop;
+* every other entry uses the base instruction set loop.
+* @return  None
+*****************************************************************************/
+template<class unsignedType, size_t... op>
+void bitManipMeasureTableFill(bitManipMeasure_ft<unsignedType> measureTable[bi_count_e][bo_count_e],
+                              std::index_sequence<op...>) {
+#if BITMANIP_EXTENSION_ENABLE
+  ((measureTable[bi_hardware_e][op] = bitManipOpTable[op].hasExtension ?
+                                      bitManipMeasureExtension<op, unsignedType> :
+                                      bitManipMeasure<op, unsignedType, false>), ...);
+#else // !BITMANIP_EXTENSION_ENABLE
+  ((measureTable[bi_hardware_e][op] = bitManipMeasure<op, unsignedType, false>), ...);
+#endif // BITMANIP_EXTENSION_ENABLE
+  ((measureTable[bi_software_e][op] = bitManipMeasure<op, unsignedType, true>), ...);
+  return;
+}
+
+/******************************************************************************
+* Measures every operation on one integer type. Signed types are measured on
+* their unsigned counterpart, the instructions do not depend on the sign.
+* Operands have random runs of leading and trailing zeros.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void bitManipMeasureType(FILE *fileContext, size_t iterations, bool isExtensionAvailable) {
+  typedef typename std::make_unsigned<classType>::type unsignedType;
+  const char *implementationNames[bi_count_e] = {"hardware", "software"};
+  constexpr unsigned width = sizeof(unsignedType) * CHAR_BIT;
+  bitManipMeasure_ft<unsignedType> measureTable[bi_count_e][bo_count_e];
+  std::vector<unsignedType> a(BITMANIP_ARRAY_SIZE), b(BITMANIP_ARRAY_SIZE), out(BITMANIP_ARRAY_SIZE);
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  bitManipTiming_t timing;
+  uint64_t value;
+  bool isMeasured;
+
+  bitManipMeasureTableFill<unsignedType>(measureTable, std::make_index_sequence<bo_count_e>{});
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  for (size_t index = 0; index < BITMANIP_ARRAY_SIZE; index++) {
+    value = ((uint64_t) (gauss_rand<double>(1) * 4294967295.0) << 32) ^
+            (uint64_t) (gauss_rand<double>(1) * 4294967295.0);
+    value = (unsignedType) value;
+    value >>= (size_t) (gauss_rand<double>(1) * width) % width;
+    value <<= (size_t) (gauss_rand<double>(1) * width) % width;
+    a[index] = (unsignedType) value;
+    b[index] = (unsignedType) (((uint64_t) (gauss_rand<double>(1) * 4294967295.0) << 32) ^
+                               (uint64_t) (gauss_rand<double>(1) * 4294967295.0));
+  }
+
+  for (size_t op = 0; op < bo_count_e; op++) {
+    for (size_t implementation = 0; implementation < bi_count_e; implementation++) {
+      if (bi_hardware_e == implementation) {
+        isMeasured = !bitManipOpTable[op].hasExtension || isExtensionAvailable;
+      } else {
+        isMeasured = bitManipOpTable[op].hasSoftware;
+      }
+      if (!isMeasured) {
+        continue;
+      }
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timing = measureTable[implementation][op](a.data(), b.data(), out.data(), iterations);
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %s, %zu, %f, %f, %f, %f",
+                     bitManipOpTable[op].name, typeNameBuffer, implementationNames[implementation],
+                     (bi_hardware_e == implementation) ? bitManipOpTable[op].isa : "none", iterations,
+                     timing.timeDelta, (timing.timeDelta * 1e9) / (double) iterations,
+                     (double) timing.cycleDelta / (double) iterations,
+                     (timing.timeDelta > 0.0) ? ((double) iterations / timing.timeDelta) : 0.0);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures popcount, leading/trailing zero count, shifts, rotates, bit
+* extract/deposit, byte swap and logic operations for every integer type,
+* with the extension instruction and the portable fallback.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_BitManip(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Operation, Type System, Implementation, ISA, Operations, Time for Operations, "
+                            "Nanoseconds per Operation, Cycles per Operation, Operations per Second";
+  size_t iterations = (options.iterations > 0) ? options.iterations : BITMANIP_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  bool isExtensionAvailable = false;
+  FILE *fileContext;
+
+#if BITMANIP_EXTENSION_ENABLE
+  isExtensionAvailable = __builtin_cpu_supports("popcnt") && __builtin_cpu_supports("lzcnt") &&
+                         __builtin_cpu_supports("bmi") && __builtin_cpu_supports("bmi2");
+#endif // BITMANIP_EXTENSION_ENABLE
+  if (!isExtensionAvailable) {
+    printf("POPCNT, LZCNT, BMI1 and BMI2 are not all available, only the software fallbacks are measured.\n");
+  }
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("BitManip", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  bitManipMeasureType<int8_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<uint8_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<int16_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<uint16_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<int32_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<uint32_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<int64_t>(fileContext, iterations, isExtensionAvailable);
+  bitManipMeasureType<uint64_t>(fileContext, iterations, isExtensionAvailable);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKBITMANIP_HPP_
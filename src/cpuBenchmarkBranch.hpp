@@ -0,0 +1,320 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKBRANCH_HPP_
+#define _CPUBENCHMARKBRANCH_HPP_
+
+#include <utility>
+
+#define BRANCH_ITERATIONS_DEFAULT (1 << 26)
+#define BRANCH_ARRAY_SIZE (1 << 16) // Power of two, the index wraps with a mask instead of a branch.
+#define BRANCH_TARGETS_MAX 32
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum branchPattern_e {
+  bp_predictable_e = 0, // Always taken, or always the same target
+  bp_random_e = 1, // Uniform random outcome or target
+  bp_periodic_e = 2, // Random outcome or target repeated every pattern length
+  bp_count_e = 3
+} branchPattern_et;
+
+typedef enum branchKernel_e {
+  bk_conditionalBranchy_e = 0, // if/else on the pattern bit
+  bk_conditionalBranchless_e = 1, // Same operation computed with a select mask
+  bk_indirect_e = 2, // Call through a table of targets
+  bk_count_e = 3
+} branchKernel_et;
+
+typedef int64_t (*branchTarget_ft)(int64_t accumulator, int64_t value);
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *branchPatternName(branchPattern_et pattern);
+
+const char *branchKernelName(branchKernel_et kernel);
+
+template<size_t targetIndex>
+int64_t branchIndirectTarget(int64_t accumulator, int64_t value);
+
+template<size_t... targetIndex>
+void branchTargetTableFill(branchTarget_ft targetTable[], std::index_sequence<targetIndex...>);
+
+void branchPatternFill(std::vector<uint8_t> &pattern, branchPattern_et patternType, size_t patternLength,
+                       size_t targetCount);
+
+int64_t branchConditionalBranchy(const uint8_t *pattern, const int64_t *values, size_t iterations);
+
+int64_t branchConditionalBranchless(const uint8_t *pattern, const int64_t *values, size_t iterations);
+
+int64_t branchIndirect(const uint8_t *pattern, const int64_t *values, const branchTarget_ft *targetTable,
+                       size_t iterations);
+
+int testharness_Branch(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the branch pattern.
+*****************************************************************************/
+const char *branchPatternName(branchPattern_et pattern) {
+  const char *patternName;
+  switch (pattern) {
+    case bp_predictable_e:
+      patternName = "predictable";
+      break;
+    case bp_random_e:
+      patternName = "random";
+      break;
+    case bp_periodic_e:
+      patternName = "periodic";
+      break;
+    default:
+      patternName = "unknown";
+      break;
+  }
+  return patternName;
+}
+
+/******************************************************************************
+*
+* @return  printable name and implementation of the branch kernel.
+*****************************************************************************/
+const char *branchKernelName(branchKernel_et kernel) {
+  const char *kernelName;
+  switch (kernel) {
+    case bk_conditionalBranchy_e:
+      kernelName = "conditional, branchy";
+      break;
+    case bk_conditionalBranchless_e:
+      kernelName = "conditional, branchless";
+      break;
+    case bk_indirect_e:
+      kernelName = "indirect, table";
+      break;
+    default:
+      kernelName = "unknown, unknown";
+      break;
+  }
+  return kernelName;
+}
+
+/******************************************************************************
+* One indirect branch target. Every index is a distinct function so the
+* table holds distinct addresses.
+* @return  updated accumulator.
+*****************************************************************************/
+template<size_t targetIndex>
+__attribute__((noinline)) int64_t branchIndirectTarget(int64_t accumulator, int64_t value) {
+  return (accumulator ^ (value + (int64_t) targetIndex)) + (int64_t) targetIndex;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+template<size_t... targetIndex>
+void branchTargetTableFill(branchTarget_ft targetTable[], std::index_sequence<targetIndex...>) {
+  ((targetTable[targetIndex] = branchIndirectTarget<targetIndex>), ...);
+  return;
+}
+
+/******************************************************************************
+* Fills the outcome (targetCount of 1) or target index sequence.
+* @return  None
+*****************************************************************************/
+void branchPatternFill(std::vector<uint8_t> &pattern, branchPattern_et patternType, size_t patternLength,
+                       size_t targetCount) {
+  std::vector<uint8_t> period(patternLength);
+  size_t outcomes = std::max(targetCount, (size_t) 2);
+
+  for (size_t index = 0; index < patternLength; index++) {
+    period[index] = (uint8_t) ((size_t) (gauss_rand<double>(1) * outcomes) % outcomes);
+  }
+  for (size_t index = 0; index < pattern.size(); index++) {
+    switch (patternType) {
+      case bp_predictable_e:
+        pattern[index] = (targetCount > 1) ? 0 : 1;
+        break;
+      case bp_random_e:
+        pattern[index] = (uint8_t) ((size_t) (gauss_rand<double>(1) * outcomes) % outcomes);
+        break;
+      case bp_periodic_e:
+        pattern[index] = period[index % patternLength];
+        break;
+      default:
+        asserterror();
+        break;
+    }
+    if (1 == targetCount) {
+      pattern[index] = pattern[index] & 1;
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Adds or subtracts each value depending on the pattern bit. The arms hold
+* distinct volatile asm statements so the compiler cannot if-convert them.
+* @return  accumulator to keep the loop alive.
+*****************************************************************************/
+int64_t branchConditionalBranchy(const uint8_t *pattern, const int64_t *values, size_t iterations) {
+  int64_t accumulator = 0;
+  size_t index = 0;
+  for (size_t count = 0; count < iterations; count++) {
+    if (pattern[index]) {
+      accumulator += values[index];
+      __asm__ __volatile__("# branch taken");
+    } else {
+      accumulator -= values[index];
+      __asm__ __volatile__("# branch not taken");
+    }
+    index = (index + 1) & (BRANCH_ARRAY_SIZE - 1);
+  }
+  return accumulator;
+}
+
+/******************************************************************************
+* Same operation as branchConditionalBranchy using a select mask (cmov like).
+* @return  accumulator to keep the loop alive.
+*****************************************************************************/
+int64_t branchConditionalBranchless(const uint8_t *pattern, const int64_t *values, size_t iterations) {
+  int64_t accumulator = 0;
+  int64_t selectMask;
+  size_t index = 0;
+  for (size_t count = 0; count < iterations; count++) {
+    selectMask = -(int64_t) pattern[index];
+    accumulator += (values[index] & selectMask) - (values[index] & ~selectMask);
+    index = (index + 1) & (BRANCH_ARRAY_SIZE - 1);
+  }
+  return accumulator;
+}
+
+/******************************************************************************
+* Calls through the target table in the order given by the pattern.
+* @return  accumulator to keep the loop alive.
+*****************************************************************************/
+int64_t branchIndirect(const uint8_t *pattern, const int64_t *values, const branchTarget_ft *targetTable,
+                       size_t iterations) {
+  int64_t accumulator = 0;
+  size_t index = 0;
+  for (size_t count = 0; count < iterations; count++) {
+    accumulator = targetTable[pattern[index]](accumulator, values[index]);
+    index = (index + 1) & (BRANCH_ARRAY_SIZE - 1);
+  }
+  return accumulator;
+}
+
+/******************************************************************************
+* Measures conditional branches (branchy and branchless) and indirect branches
+* with predictable, random and periodic patterns. The misprediction penalty is
+* the random minus predictable cost divided by the expected miss rate of the
+* random pattern; periodic rows report the miss rate that penalty implies.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Branch(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Kernel, Implementation, Pattern, Pattern Length, Targets, Branches, Time for Operations, "
+                            "Cycles per Branch, Nanoseconds per Branch, Misprediction Penalty Cycles, "
+                            "Estimated Miss Rate";
+  size_t iterations = (options.iterations > 0) ? options.iterations : BRANCH_ITERATIONS_DEFAULT;
+  size_t patternLength = options.patternLength;
+  size_t targetCount = std::min(options.targetCount, (size_t) BRANCH_TARGETS_MAX);
+  size_t kernelTargets;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  std::vector<uint8_t> pattern(BRANCH_ARRAY_SIZE);
+  std::vector<int64_t> values(BRANCH_ARRAY_SIZE);
+  branchTarget_ft targetTable[BRANCH_TARGETS_MAX];
+  volatile int64_t branchSink = 0;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency[bp_count_e];
+  double timeDelta[bp_count_e];
+  double cyclesPerBranch[bp_count_e];
+  double expectedMissRate;
+  double penaltyCycles;
+  double missRate;
+  double timeStart;
+  uint64_t cycleStart;
+  FILE *fileContext;
+
+  branchTargetTableFill(targetTable, std::make_index_sequence<BRANCH_TARGETS_MAX>{});
+  for (size_t index = 0; index < BRANCH_ARRAY_SIZE; index++) {
+    values[index] = (int64_t) (gauss_rand<double>(1) * 1024.0) + 1;
+  }
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("Branch", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+
+  for (size_t kernel = 0; kernel < bk_count_e; kernel++) {
+    kernelTargets = (bk_indirect_e == kernel) ? targetCount : 1;
+    for (size_t patternType = 0; patternType < bp_count_e; patternType++) {
+      branchPatternFill(pattern, (branchPattern_et) patternType, patternLength, kernelTargets);
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timeStart = getTime();
+      cycleStart = getCycleCount();
+      switch (kernel) {
+        case bk_conditionalBranchy_e:
+          branchSink = branchConditionalBranchy(pattern.data(), values.data(), iterations);
+          break;
+        case bk_conditionalBranchless_e:
+          branchSink = branchConditionalBranchless(pattern.data(), values.data(), iterations);
+          break;
+        case bk_indirect_e:
+          branchSink = branchIndirect(pattern.data(), values.data(), targetTable, iterations);
+          break;
+        default:
+          asserterror();
+          break;
+      }
+      cyclesPerBranch[patternType] = (double) (getCycleCount() - cycleStart) / (double) iterations;
+      timeDelta[patternType] = getTime() - timeStart;
+      frequency[patternType] = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+    }
+
+    // Random outcomes miss half of the time, random targets miss (N-1)/N of the time.
+    expectedMissRate = (bk_indirect_e == kernel) ? ((double) (kernelTargets - 1) / (double) kernelTargets) : 0.5;
+    penaltyCycles = 0.0;
+    if ((bk_conditionalBranchless_e != kernel) && (expectedMissRate > 0.0)) {
+      penaltyCycles = (cyclesPerBranch[bp_random_e] - cyclesPerBranch[bp_predictable_e]) / expectedMissRate;
+    }
+    for (size_t patternType = 0; patternType < bp_count_e; patternType++) {
+      missRate = 0.0;
+      if (penaltyCycles > 0.0) {
+        missRate = (cyclesPerBranch[patternType] - cyclesPerBranch[bp_predictable_e]) / penaltyCycles;
+        missRate = std::min(std::max(missRate, 0.0), 1.0);
+      }
+      resultPrintRow(fileContext, true, &frequency[patternType], "%s, %s, %zu, %zu, %zu, %f, %f, %f, %f, %f",
+                     branchKernelName((branchKernel_et) kernel),
+                     branchPatternName((branchPattern_et) patternType),
+                     (bp_periodic_e == patternType) ? patternLength : (size_t) BRANCH_ARRAY_SIZE,
+                     kernelTargets, iterations, timeDelta[patternType], cyclesPerBranch[patternType],
+                     (timeDelta[patternType] * 1e9) / (double) iterations,
+                     (bp_predictable_e == patternType) ? 0.0 : penaltyCycles, missRate);
+    }
+  }
+  (void) branchSink;
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKBRANCH_HPP_
@@ -0,0 +1,599 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the roofline family for buffer alignment.
+
+#ifndef _CPUBENCHMARKCHECKSUM_HPP_
+#define _CPUBENCHMARKCHECKSUM_HPP_
+
+// Hardware CRC variants are compiled per function and selected at run time.
+#if defined(__x86_64__) | defined(__i386__)
+#define CHECKSUM_EXTENSION_ENABLE 1
+#define CHECKSUM_TARGET_SSE42 "sse4.2"
+#define CHECKSUM_TARGET_PCLMUL "pclmul,sse4.1"
+#else
+#define CHECKSUM_EXTENSION_ENABLE 0
+#endif
+
+#define CHECKSUM_BYTES_MIN 64 // Default sweep of the buffer, grows by CHECKSUM_BYTES_STEP ...
+#define CHECKSUM_BYTES_MAX (1ULL << 30) // ... up to this many, -n selects a single size
+#define CHECKSUM_BYTES_STEP 4
+#define CHECKSUM_BYTES_PER_MEASUREMENT (1ULL << 28) // Small buffers repeat until about this much was hashed
+#define CHECKSUM_CRC32_POLYNOMIAL 0x104C11DB7ULL // IEEE 802.3, zlib and gzip, normal form with the x^32 term
+#define CHECKSUM_CRC32C_POLYNOMIAL 0x11EDC6F41ULL // Castagnoli, iSCSI, ext4 and SSE4.2
+#define CHECKSUM_ADLER32_MODULUS 65521
+#define CHECKSUM_ADLER32_DEFER 5552 // Longest run of bytes before the sums can overflow 32 bits
+#define CHECKSUM_FNV64_BASIS 0xCBF29CE484222325ULL
+#define CHECKSUM_FNV64_PRIME 0x00000100000001B3ULL
+#define CHECKSUM_XXH64_PRIME1 0x9E3779B185EBCA87ULL
+#define CHECKSUM_XXH64_PRIME2 0xC2B2AE3D27D4EB4FULL
+#define CHECKSUM_XXH64_PRIME3 0x165667B19E3779F9ULL
+#define CHECKSUM_XXH64_PRIME4 0x85EBCA77C2B2AE63ULL
+#define CHECKSUM_XXH64_PRIME5 0x27D4EB2F165667C5ULL
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum checksumAlgorithm_e {
+  ck_crc32Bytewise_e = 0, // One table lookup per byte
+  ck_crc32Slice8_e = 1, // Eight table lookups per 8 byte word
+  ck_crc32Pclmul_e = 2, // Carry-less multiply folding of four 128 bit lanes, Barrett reduction
+  ck_crc32cBytewise_e = 3,
+  ck_crc32cSlice8_e = 4,
+  ck_crc32cSse42_e = 5, // crc32 instruction on 8 byte words, one dependency chain
+  ck_crc32cPclmul_e = 6,
+  ck_adler32_e = 7, // Two running sums, modulo deferred per CHECKSUM_ADLER32_DEFER bytes
+  ck_xxhash64_e = 8, // Four multiply-rotate lanes over 32 byte stripes
+  ck_fnv1a64_e = 9, // Xor then multiply per byte
+  ck_count_e = 10
+} checksumAlgorithm_et;
+
+typedef struct checksumAlgorithmInfo {
+  const char *name; // Printable algorithm name
+  const char *isa; // Instruction set extension used
+  checksumAlgorithm_et reference; // Algorithm producing the same value, compared per buffer
+} checksumAlgorithmInfo_t;
+
+const checksumAlgorithmInfo_t checksumAlgorithmTable[ck_count_e] = {
+  {"crc32_bytewise", "base", ck_crc32Bytewise_e},
+  {"crc32_slice8", "base", ck_crc32Bytewise_e},
+  {"crc32_pclmul", "PCLMUL", ck_crc32Bytewise_e},
+  {"crc32c_bytewise", "base", ck_crc32cBytewise_e},
+  {"crc32c_slice8", "base", ck_crc32cBytewise_e},
+  {"crc32c_sse42", "SSE4.2", ck_crc32cBytewise_e},
+  {"crc32c_pclmul", "PCLMUL", ck_crc32cBytewise_e},
+  {"adler32", "base", ck_adler32_e},
+  {"xxhash64", "base", ck_xxhash64_e},
+  {"fnv1a64", "base", ck_fnv1a64_e}
+};
+
+// Tables and folding constants of one reflected CRC.
+typedef struct checksumCrc {
+  uint32_t table[8][256]; // Slice by 8 tables, table[0] alone is the bytewise table
+  alignas(16) uint64_t fold[8]; // x^544, x^480, x^160, x^96, x^64 remainders, zero, reflected polynomial, Barrett mu
+} checksumCrc_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+uint64_t checksumReflect(uint64_t value, size_t bits);
+
+void checksumCrcInit(checksumCrc_t &crc, uint64_t polynomial);
+
+uint32_t checksumCrcBytewise(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state);
+
+uint32_t checksumCrcSlice8(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state);
+
+#if CHECKSUM_EXTENSION_ENABLE
+__attribute__((target(CHECKSUM_TARGET_SSE42)))
+uint32_t checksumCrc32cSse42(const uint8_t *buffer, size_t length, uint32_t state);
+
+__attribute__((target(CHECKSUM_TARGET_PCLMUL)))
+uint32_t checksumCrcPclmul(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state);
+#endif // CHECKSUM_EXTENSION_ENABLE
+
+uint32_t checksumAdler32(const uint8_t *buffer, size_t length, uint32_t adler);
+
+uint64_t checksumXxhash64(const uint8_t *buffer, size_t length, uint64_t seed);
+
+uint64_t checksumFnv1a64(const uint8_t *buffer, size_t length, uint64_t hash);
+
+uint64_t checksumSeed(checksumAlgorithm_et algorithm);
+
+uint64_t checksumCompute(checksumAlgorithm_et algorithm, const checksumCrc_t &crc32, const checksumCrc_t &crc32c,
+                         const uint8_t *buffer, size_t length, uint64_t seed);
+
+int testharness_Checksum(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  the low bits of value in reverse order.
+*****************************************************************************/
+uint64_t checksumReflect(uint64_t value, size_t bits) {
+  uint64_t reflected = 0;
+
+  for (size_t bit = 0; bit < bits; bit++) {
+    if (0 != ((value >> bit) & 1)) {
+      reflected |= 1ULL << (bits - 1 - bit);
+    }
+  }
+  return reflected;
+}
+
+/******************************************************************************
+* Builds the lookup tables and the carry-less folding constants of a
+* reflected CRC from its normal form polynomial, so both CRCs share one code
+* path and the constants need no transcription.
+* @return  None
+*****************************************************************************/
+void checksumCrcInit(checksumCrc_t &crc, uint64_t polynomial) {
+  const size_t foldExponents[5] = {4 * 128 + 32, 4 * 128 - 32, 128 + 32, 128 - 32, 64};
+  const uint32_t reflected = (uint32_t) checksumReflect(polynomial, 32);
+  uint64_t remainder, quotient;
+  uint32_t entry;
+
+  for (size_t index = 0; index < 256; index++) {
+    entry = (uint32_t) index;
+    for (size_t bit = 0; bit < 8; bit++) {
+      entry = (0 != (entry & 1)) ? ((entry >> 1) ^ reflected) : (entry >> 1);
+    }
+    crc.table[0][index] = entry;
+  }
+  for (size_t slice = 1; slice < 8; slice++) {
+    for (size_t index = 0; index < 256; index++) {
+      entry = crc.table[slice - 1][index];
+      crc.table[slice][index] = (entry >> 8) ^ crc.table[0][entry & 0xFF];
+    }
+  }
+  // x^n mod P, bit reflected and shifted up one for the reflected multiply.
+  for (size_t constant = 0; constant < 5; constant++) {
+    remainder = 1;
+    for (size_t power = 0; power < foldExponents[constant]; power++) {
+      remainder <<= 1;
+      remainder ^= (0 != (remainder >> 32)) ? polynomial : 0;
+    }
+    crc.fold[constant] = checksumReflect(remainder, 32) << 1;
+  }
+  crc.fold[5] = 0;
+  // Barrett constant mu = floor(x^64 / P), by long division.
+  remainder = 0;
+  quotient = 0;
+  for (int bit = 64; bit >= 0; bit--) {
+    remainder = (remainder << 1) | ((64 == bit) ? 1 : 0);
+    if (0 != (remainder >> 32)) {
+      remainder ^= polynomial;
+      quotient |= 1ULL << bit;
+    }
+  }
+  crc.fold[6] = checksumReflect(polynomial, 33);
+  crc.fold[7] = checksumReflect(quotient, 33);
+  return;
+}
+
+/******************************************************************************
+* State is the running CRC register, already inverted.
+* @return  CRC register after the buffer.
+*****************************************************************************/
+__attribute__((noinline))
+uint32_t checksumCrcBytewise(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state) {
+  for (size_t index = 0; index < length; index++) {
+    state = crc.table[0][(state ^ buffer[index]) & 0xFF] ^ (state >> 8);
+  }
+  return state;
+}
+
+/******************************************************************************
+* Little endian slice by 8, the word is loaded with memcpy so any alignment
+* is legal.
+* @return  CRC register after the buffer.
+*****************************************************************************/
+__attribute__((noinline))
+uint32_t checksumCrcSlice8(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state) {
+  uint64_t word;
+
+  while (length >= 8) {
+    memcpy(&word, buffer, sizeof(word));
+    word ^= state;
+    state = crc.table[7][word & 0xFF] ^ crc.table[6][(word >> 8) & 0xFF] ^
+            crc.table[5][(word >> 16) & 0xFF] ^ crc.table[4][(word >> 24) & 0xFF] ^
+            crc.table[3][(word >> 32) & 0xFF] ^ crc.table[2][(word >> 40) & 0xFF] ^
+            crc.table[1][(word >> 48) & 0xFF] ^ crc.table[0][word >> 56];
+    buffer += 8;
+    length -= 8;
+  }
+  return checksumCrcBytewise(crc, buffer, length, state);
+}
+
+#if CHECKSUM_EXTENSION_ENABLE
+/******************************************************************************
+* The crc32 instruction computes CRC32C only; a single chain is bound by its
+* three cycle latency.
+* @return  CRC register after the buffer.
+*****************************************************************************/
+__attribute__((noinline, target(CHECKSUM_TARGET_SSE42)))
+uint32_t checksumCrc32cSse42(const uint8_t *buffer, size_t length, uint32_t state) {
+  uint64_t word, wide = state;
+
+  while (length >= 8) {
+    memcpy(&word, buffer, sizeof(word));
+    wide = _mm_crc32_u64(wide, word);
+    buffer += 8;
+    length -= 8;
+  }
+  state = (uint32_t) wide;
+  while (length > 0) {
+    state = _mm_crc32_u8(state, *buffer);
+    buffer++;
+    length--;
+  }
+  return state;
+}
+
+/******************************************************************************
+* Folds four 128 bit lanes 64 bytes at a time, then one lane, then reduces
+* to 32 bits with a Barrett step (Intel, "Fast CRC Computation for Generic
+* Polynomials Using PCLMULQDQ"). Buffers under 64 bytes and the tail past the
+* last 16 byte block go through slice by 8.
+* @return  CRC register after the buffer.
+*****************************************************************************/
+__attribute__((noinline, target(CHECKSUM_TARGET_PCLMUL)))
+uint32_t checksumCrcPclmul(const checksumCrc_t &crc, const uint8_t *buffer, size_t length, uint32_t state) {
+  const __m128i lowMask = _mm_setr_epi32(~0, 0, ~0, 0);
+  __m128i x0, x1, x2, x3, x4, x5, x6, x7, x8;
+
+  if (length < 64) {
+    return checksumCrcSlice8(crc, buffer, length, state);
+  }
+  x1 = _mm_xor_si128(_mm_loadu_si128((const __m128i *) (buffer + 0x00)), _mm_cvtsi32_si128((int) state));
+  x2 = _mm_loadu_si128((const __m128i *) (buffer + 0x10));
+  x3 = _mm_loadu_si128((const __m128i *) (buffer + 0x20));
+  x4 = _mm_loadu_si128((const __m128i *) (buffer + 0x30));
+  buffer += 64;
+  length -= 64;
+  x0 = _mm_load_si128((const __m128i *) &crc.fold[0]);
+  while (length >= 64) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x6 = _mm_clmulepi64_si128(x2, x0, 0x00);
+    x7 = _mm_clmulepi64_si128(x3, x0, 0x00);
+    x8 = _mm_clmulepi64_si128(x4, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x2 = _mm_clmulepi64_si128(x2, x0, 0x11);
+    x3 = _mm_clmulepi64_si128(x3, x0, 0x11);
+    x4 = _mm_clmulepi64_si128(x4, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, x5), _mm_loadu_si128((const __m128i *) (buffer + 0x00)));
+    x2 = _mm_xor_si128(_mm_xor_si128(x2, x6), _mm_loadu_si128((const __m128i *) (buffer + 0x10)));
+    x3 = _mm_xor_si128(_mm_xor_si128(x3, x7), _mm_loadu_si128((const __m128i *) (buffer + 0x20)));
+    x4 = _mm_xor_si128(_mm_xor_si128(x4, x8), _mm_loadu_si128((const __m128i *) (buffer + 0x30)));
+    buffer += 64;
+    length -= 64;
+  }
+  // Four lanes into one.
+  x0 = _mm_load_si128((const __m128i *) &crc.fold[2]);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x2), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x3), x5);
+  x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+  x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+  x1 = _mm_xor_si128(_mm_xor_si128(x1, x4), x5);
+  while (length >= 16) {
+    x5 = _mm_clmulepi64_si128(x1, x0, 0x00);
+    x1 = _mm_clmulepi64_si128(x1, x0, 0x11);
+    x1 = _mm_xor_si128(_mm_xor_si128(x1, _mm_loadu_si128((const __m128i *) buffer)), x5);
+    buffer += 16;
+    length -= 16;
+  }
+  // 128 bits to 64 bits.
+  x2 = _mm_clmulepi64_si128(x1, x0, 0x10);
+  x1 = _mm_xor_si128(_mm_srli_si128(x1, 8), x2);
+  x0 = _mm_loadl_epi64((const __m128i *) &crc.fold[4]);
+  x2 = _mm_srli_si128(x1, 4);
+  x1 = _mm_and_si128(x1, lowMask);
+  x1 = _mm_xor_si128(_mm_clmulepi64_si128(x1, x0, 0x00), x2);
+  // Barrett reduction to 32 bits.
+  x0 = _mm_load_si128((const __m128i *) &crc.fold[6]);
+  x2 = _mm_and_si128(x1, lowMask);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x10);
+  x2 = _mm_and_si128(x2, lowMask);
+  x2 = _mm_clmulepi64_si128(x2, x0, 0x00);
+  x1 = _mm_xor_si128(x1, x2);
+  state = (uint32_t) _mm_extract_epi32(x1, 1);
+  return checksumCrcSlice8(crc, buffer, length, state);
+}
+#endif // CHECKSUM_EXTENSION_ENABLE
+
+/******************************************************************************
+*
+* @return  Adler-32 of the buffer continued from adler.
+*****************************************************************************/
+__attribute__((noinline))
+uint32_t checksumAdler32(const uint8_t *buffer, size_t length, uint32_t adler) {
+  uint32_t sumA = adler & 0xFFFF, sumB = adler >> 16;
+  size_t run;
+
+  while (length > 0) {
+    run = (length < CHECKSUM_ADLER32_DEFER) ? length : CHECKSUM_ADLER32_DEFER;
+    length -= run;
+    for (size_t index = 0; index < run; index++) {
+      sumA += buffer[index];
+      sumB += sumA;
+    }
+    buffer += run;
+    sumA %= CHECKSUM_ADLER32_MODULUS;
+    sumB %= CHECKSUM_ADLER32_MODULUS;
+  }
+  return (sumB << 16) | sumA;
+}
+
+/******************************************************************************
+* XXH64 of the buffer with the given seed.
+* @return  64 bit hash.
+*****************************************************************************/
+__attribute__((noinline))
+uint64_t checksumXxhash64(const uint8_t *buffer, size_t length, uint64_t seed) {
+  const uint8_t *end = buffer + length;
+  uint64_t hash, word, lane[4];
+  uint32_t half;
+
+  auto round = [](uint64_t accumulator, uint64_t input) -> uint64_t {
+    accumulator += input * CHECKSUM_XXH64_PRIME2;
+    accumulator = (accumulator << 31) | (accumulator >> 33);
+    return accumulator * CHECKSUM_XXH64_PRIME1;
+  };
+  auto rotate = [](uint64_t value, int bits) -> uint64_t { return (value << bits) | (value >> (64 - bits)); };
+
+  if (length >= 32) {
+    lane[0] = seed + CHECKSUM_XXH64_PRIME1 + CHECKSUM_XXH64_PRIME2;
+    lane[1] = seed + CHECKSUM_XXH64_PRIME2;
+    lane[2] = seed;
+    lane[3] = seed - CHECKSUM_XXH64_PRIME1;
+    while ((end - buffer) >= 32) {
+      for (size_t index = 0; index < 4; index++) {
+        memcpy(&word, buffer + 8 * index, sizeof(word));
+        lane[index] = round(lane[index], word);
+      }
+      buffer += 32;
+    }
+    hash = rotate(lane[0], 1) + rotate(lane[1], 7) + rotate(lane[2], 12) + rotate(lane[3], 18);
+    for (size_t index = 0; index < 4; index++) {
+      hash = (hash ^ round(0, lane[index])) * CHECKSUM_XXH64_PRIME1 + CHECKSUM_XXH64_PRIME4;
+    }
+  } else {
+    hash = seed + CHECKSUM_XXH64_PRIME5;
+  }
+  hash += (uint64_t) length;
+  while ((end - buffer) >= 8) {
+    memcpy(&word, buffer, sizeof(word));
+    hash ^= round(0, word);
+    hash = rotate(hash, 27) * CHECKSUM_XXH64_PRIME1 + CHECKSUM_XXH64_PRIME4;
+    buffer += 8;
+  }
+  if ((end - buffer) >= 4) {
+    memcpy(&half, buffer, sizeof(half));
+    hash ^= (uint64_t) half * CHECKSUM_XXH64_PRIME1;
+    hash = rotate(hash, 23) * CHECKSUM_XXH64_PRIME2 + CHECKSUM_XXH64_PRIME3;
+    buffer += 4;
+  }
+  while (buffer < end) {
+    hash ^= (uint64_t) (*buffer) * CHECKSUM_XXH64_PRIME5;
+    hash = rotate(hash, 11) * CHECKSUM_XXH64_PRIME1;
+    buffer++;
+  }
+  hash ^= hash >> 33;
+  hash *= CHECKSUM_XXH64_PRIME2;
+  hash ^= hash >> 29;
+  hash *= CHECKSUM_XXH64_PRIME3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+/******************************************************************************
+*
+* @return  FNV-1a 64 bit hash of the buffer continued from hash.
+*****************************************************************************/
+__attribute__((noinline))
+uint64_t checksumFnv1a64(const uint8_t *buffer, size_t length, uint64_t hash) {
+  for (size_t index = 0; index < length; index++) {
+    hash = (hash ^ buffer[index]) * CHECKSUM_FNV64_PRIME;
+  }
+  return hash;
+}
+
+/******************************************************************************
+*
+* @return  starting value of the algorithm for an empty message.
+*****************************************************************************/
+uint64_t checksumSeed(checksumAlgorithm_et algorithm) {
+  uint64_t seed;
+  switch (algorithm) {
+    case ck_adler32_e:
+      seed = 1;
+      break;
+    case ck_fnv1a64_e:
+      seed = CHECKSUM_FNV64_BASIS;
+      break;
+    default:
+      seed = 0;
+      break;
+  }
+  return seed;
+}
+
+/******************************************************************************
+* Continues the checksum of earlier data held in seed, CRCs are given and
+* returned in their final (inverted) form. XXH64 does not continue, the
+* previous hash is used as the seed instead.
+* @return  checksum of the buffer.
+*****************************************************************************/
+uint64_t checksumCompute(checksumAlgorithm_et algorithm, const checksumCrc_t &crc32, const checksumCrc_t &crc32c,
+                         const uint8_t *buffer, size_t length, uint64_t seed) {
+  const uint32_t state = ~((uint32_t) seed);
+  uint64_t result;
+  switch (algorithm) {
+    case ck_crc32Bytewise_e:
+      result = ~checksumCrcBytewise(crc32, buffer, length, state);
+      break;
+    case ck_crc32Slice8_e:
+      result = ~checksumCrcSlice8(crc32, buffer, length, state);
+      break;
+    case ck_crc32cBytewise_e:
+      result = ~checksumCrcBytewise(crc32c, buffer, length, state);
+      break;
+    case ck_crc32cSlice8_e:
+      result = ~checksumCrcSlice8(crc32c, buffer, length, state);
+      break;
+#if CHECKSUM_EXTENSION_ENABLE
+    case ck_crc32Pclmul_e:
+      result = ~checksumCrcPclmul(crc32, buffer, length, state);
+      break;
+    case ck_crc32cSse42_e:
+      result = ~checksumCrc32cSse42(buffer, length, state);
+      break;
+    case ck_crc32cPclmul_e:
+      result = ~checksumCrcPclmul(crc32c, buffer, length, state);
+      break;
+#endif // CHECKSUM_EXTENSION_ENABLE
+    case ck_adler32_e:
+      result = checksumAdler32(buffer, length, (uint32_t) seed);
+      break;
+    case ck_xxhash64_e:
+      result = checksumXxhash64(buffer, length, seed);
+      break;
+    case ck_fnv1a64_e:
+      result = checksumFnv1a64(buffer, length, seed);
+      break;
+    default:
+      result = 0;
+      break;
+  }
+  return result;
+}
+
+/******************************************************************************
+* Runs CRC32 and CRC32C (bytewise, slice by 8, SSE4.2 and PCLMUL folding),
+* Adler-32, XXH64 and FNV-1a over buffers from 64 bytes to 1 GiB. Small
+* buffers are repeated with each result seeding the next call, so the
+* checksum latency is part of the cost as it is in a storage path.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Checksum(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Algorithm, ISA, Buffer Bytes, Repetitions, Time for Operations, Nanoseconds per Call, "
+                            "Bytes per Cycle, Gigabytes per Second, Checksum, Matches Reference";
+  size_t bytesFirst = (options.iterations > 0) ? options.iterations : CHECKSUM_BYTES_MIN;
+  size_t bytesLast = (options.iterations > 0) ? options.iterations : CHECKSUM_BYTES_MAX;
+  size_t allocationBytes, repetitions;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  bool isSse42Available = false, isPclmulAvailable = false, isAvailable;
+  volatile uint64_t checksumSink = 0;
+  uint64_t checksum, checksumReference[ck_count_e], chain, cycleStart, cycleDelta, randomState = 0x9E3779B97F4A7C15ULL;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double timeStart, timeDelta;
+  checksumCrc_t *crc32, *crc32c;
+  uint8_t *buffer;
+  FILE *fileContext;
+
+#if CHECKSUM_EXTENSION_ENABLE
+  isSse42Available = __builtin_cpu_supports("sse4.2");
+  isPclmulAvailable = __builtin_cpu_supports("pclmul") && __builtin_cpu_supports("sse4.1");
+#endif // CHECKSUM_EXTENSION_ENABLE
+  if (!isSse42Available) {
+    printf("SSE4.2 is not available, the crc32 instruction variant is skipped.\n");
+  }
+  if (!isPclmulAvailable) {
+    printf("PCLMULQDQ is not available, the folding variants are skipped.\n");
+  }
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  allocationBytes = (bytesLast + ROOFLINE_VECTOR_BYTES - 1) & ~((size_t) ROOFLINE_VECTOR_BYTES - 1);
+  buffer = (uint8_t *) aligned_alloc(ROOFLINE_VECTOR_BYTES, allocationBytes);
+  crc32 = (checksumCrc_t *) aligned_alloc(CACHE_LINE_SIZE, sizeof(checksumCrc_t));
+  crc32c = (checksumCrc_t *) aligned_alloc(CACHE_LINE_SIZE, sizeof(checksumCrc_t));
+  if ((NULL == buffer) || (NULL == crc32) || (NULL == crc32c)) {
+    printf("Unable to allocate %zu bytes for the checksum buffer.\n", allocationBytes);
+    free(buffer);
+    free(crc32);
+    free(crc32c);
+    return EXIT_FAILURE;
+  }
+  checksumCrcInit(*crc32, CHECKSUM_CRC32_POLYNOMIAL);
+  checksumCrcInit(*crc32c, CHECKSUM_CRC32C_POLYNOMIAL);
+  for (size_t index = 0; index < allocationBytes; index += sizeof(randomState)) {
+    randomState ^= randomState << 13;
+    randomState ^= randomState >> 7;
+    randomState ^= randomState << 17;
+    memcpy(buffer + index, &randomState, sizeof(randomState));
+  }
+  fileContext = resultFileOpen("Checksum", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    free(buffer);
+    free(crc32);
+    free(crc32c);
+    return EXIT_FAILURE;
+  }
+  for (size_t bytes = bytesFirst; bytes <= bytesLast; bytes *= CHECKSUM_BYTES_STEP) {
+    repetitions = (bytes < CHECKSUM_BYTES_PER_MEASUREMENT) ? (CHECKSUM_BYTES_PER_MEASUREMENT / bytes) : 1;
+    for (size_t algorithm = 0; algorithm < ck_count_e; algorithm++) {
+      switch (algorithm) {
+        case ck_crc32cSse42_e:
+          isAvailable = isSse42Available;
+          break;
+        case ck_crc32Pclmul_e:
+        case ck_crc32cPclmul_e:
+          isAvailable = isPclmulAvailable;
+          break;
+        default:
+          isAvailable = true;
+          break;
+      }
+      if (!isAvailable) {
+        continue;
+      }
+      checksum = checksumCompute((checksumAlgorithm_et) algorithm, *crc32, *crc32c, buffer, bytes,
+                                 checksumSeed((checksumAlgorithm_et) algorithm));
+      checksumReference[algorithm] = checksum;
+      chain = checksum;
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timeStart = getTime();
+      cycleStart = getCycleCount();
+      for (size_t repetition = 0; repetition < repetitions; repetition++) {
+        chain = checksumCompute((checksumAlgorithm_et) algorithm, *crc32, *crc32c, buffer, bytes, chain);
+      }
+      cycleDelta = getCycleCount() - cycleStart;
+      timeDelta = getTime() - timeStart;
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %f, %f, %f, %f, 0x%016" PRIx64 ", %d",
+                     checksumAlgorithmTable[algorithm].name, checksumAlgorithmTable[algorithm].isa, bytes,
+                     repetitions, timeDelta, (timeDelta * 1e9) / (double) repetitions,
+                     (cycleDelta > 0) ? ((double) bytes * (double) repetitions / (double) cycleDelta) : 0.0,
+                     (timeDelta > 0.0) ? ((double) bytes * (double) repetitions / timeDelta / 1e9) : 0.0, checksum,
+                     (checksum == checksumReference[checksumAlgorithmTable[algorithm].reference]) ? 1 : 0);
+      checksumSink = chain;
+    }
+  }
+  resultFileClose(fileContext, fileNameAbsolute);
+  (void) checksumSink;
+  free(buffer);
+  free(crc32);
+  free(crc32c);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKCHECKSUM_HPP_
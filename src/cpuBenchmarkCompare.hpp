@@ -0,0 +1,463 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKCOMPARE_HPP_
+#define _CPUBENCHMARKCOMPARE_HPP_
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#define COMPARE_LINE_SIZE (4 * CHAR_BUFFER_SIZE) // Longest result file line that is read
+#define COMPARE_EXACT_PRODUCT_MAX 400 // Largest sample size product with an exact U distribution
+#define COMPARE_SAMPLES_ADVISED 4 // Samples per side below which no row can reach 5% significance
+#define COMPARE_KEY_SEPARATOR " | " // Joins the key cells of a row
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum compareVerdict_e {
+  cv_regression_e = 0, // Significant and worse than the threshold
+  cv_improvement_e = 1, // Significant and better than the threshold
+  cv_unchanged_e = 2, // Not significant or within the threshold
+  cv_count_e = 3
+} compareVerdict_et;
+
+// Samples of the compared metric for one row of a result file, one per repetition.
+typedef struct compareRow {
+  std::string key; // Key cells joined with COMPARE_KEY_SEPARATOR
+  std::vector<std::string> keyCells; // Leading cells of the row
+  std::vector<double> samples; // Metric values in file order
+} compareRow_t;
+
+// A result file reduced to the compared metric per row key.
+typedef struct compareFile {
+  std::string fingerprint; // Host fingerprint of the metadata block, empty when absent
+  std::map<std::string, std::string> metadata; // Every key and value of the metadata block
+  std::vector<std::string> columns; // Header cells
+  size_t keyColumns; // Leading cells that identify a row, type, operation and thread configuration
+  size_t metricColumn; // Column the samples come from
+  bool isHigherBetter; // Rates are better when higher, times and cycles when lower
+  std::vector<compareRow_t> rows; // In order of first appearance
+} compareFile_t;
+
+typedef struct compareResult {
+  const compareRow_t *baseline; // Row of the baseline file
+  const compareRow_t *candidate; // Row of the candidate file with the same key
+  double baselineMedian; // Median of the baseline samples
+  double candidateMedian; // Median of the candidate samples
+  double change; // Relative change of the medians in percent, positive is worse
+  double statisticU; // Mann-Whitney U of the baseline samples
+  double pValue; // Two sided probability of a shift at least this large by chance
+  compareVerdict_et verdict; // Ranking class of the row
+} compareResult_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *compareVerdictName(compareVerdict_et verdict);
+
+void compareSplitCells(const char *line, std::vector<std::string> &cells);
+
+bool compareIsMeasurement(const std::string &column);
+
+bool compareIsHigherBetter(const std::string &column);
+
+bool compareFileLoad(const char *fileName, const char *metric, compareFile_t &file);
+
+double compareMedian(std::vector<double> samples);
+
+double compareExactLowerTail(size_t leftCount, size_t rightCount, double statisticU);
+
+double compareMannWhitney(const std::vector<double> &left, const std::vector<double> &right, double &statisticU);
+
+bool compareResultOrder(const compareResult_t &left, const compareResult_t &right);
+
+int testharness_Compare(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the verdict.
+*****************************************************************************/
+const char *compareVerdictName(compareVerdict_et verdict) {
+  const char *verdictName;
+  switch (verdict) {
+    case cv_regression_e:
+      verdictName = "regression";
+      break;
+    case cv_improvement_e:
+      verdictName = "improvement";
+      break;
+    case cv_unchanged_e:
+      verdictName = "unchanged";
+      break;
+    default:
+      verdictName = "unknown";
+      break;
+  }
+  return verdictName;
+}
+
+/******************************************************************************
+* Splits a result line on commas, the blanks around every cell and the line
+* end are dropped. Empty cells are kept so columns stay aligned.
+* @return  None
+*****************************************************************************/
+void compareSplitCells(const char *line, std::vector<std::string> &cells) {
+  const char *cellStart = line;
+  const char *cellEnd;
+
+  cells.clear();
+  while (NULL != cellStart) {
+    cellEnd = strchr(cellStart, ',');
+    std::string cell = (NULL != cellEnd) ? std::string(cellStart, cellEnd - cellStart) : std::string(cellStart);
+    size_t first = cell.find_first_not_of(" \t\r\n");
+    size_t last = cell.find_last_not_of(" \t\r\n");
+    cells.push_back((std::string::npos == first) ? std::string() : cell.substr(first, last - first + 1));
+    cellStart = (NULL != cellEnd) ? (cellEnd + 1) : NULL;
+  }
+  return;
+}
+
+/******************************************************************************
+* The family headers list what was run first and what was measured after, the
+* first measured column is a total time or a rate. A few configuration columns
+* are ratios too and are named here so they stay part of the key.
+* @return  true if the column holds a measurement rather than configuration.
+*****************************************************************************/
+bool compareIsMeasurement(const std::string &column) {
+  const char *const configurationRatios[] = {"Arithmetic Intensity Operations per Byte", "Results per Call",
+                                             "Updates per Thread", "Working Set Bytes per Thread"};
+
+  for (size_t ratio = 0; ratio < (sizeof(configurationRatios) / sizeof(configurationRatios[0])); ratio++) {
+    if (0 == column.compare(configurationRatios[ratio])) {
+      return false;
+    }
+  }
+  return (0 == column.compare(0, 8, "Time for")) || (std::string::npos != column.find(" per "));
+}
+
+/******************************************************************************
+*
+* @return  true if a larger value of the column is the better result.
+*****************************************************************************/
+bool compareIsHigherBetter(const std::string &column) {
+  const char *const higherBetter[] = {"per Second", "per Watt", "Bytes per Cycle", "Fraction of"};
+
+  for (size_t phrase = 0; phrase < (sizeof(higherBetter) / sizeof(higherBetter[0])); phrase++) {
+    if (std::string::npos != column.find(higherBetter[phrase])) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************
+* Reads a result file written by resultFileOpen or the arithmetic threads.
+* The key is every column before the first measurement, or before the metric
+* column when it is named and comes earlier. Rows with the same key are the
+* repetitions of one measurement.
+* @return  true if the file was read and has a metric column.
+*****************************************************************************/
+bool compareFileLoad(const char *fileName, const char *metric, compareFile_t &file) {
+  const size_t prefixLength = strlen(HOST_METADATA_PREFIX);
+  std::map<std::string, size_t> rowIndex;
+  std::vector<std::string> cells;
+  std::vector<char> line(COMPARE_LINE_SIZE);
+  std::string key;
+  FILE *fileContext;
+  char *valueEnd;
+  double value;
+
+  file.fingerprint.clear();
+  file.metadata.clear();
+  file.columns.clear();
+  file.rows.clear();
+  fileContext = fopen(fileName, "r");
+  if (NULL == fileContext) {
+    fprintf(stderr, "Unable to read %s : %s.\n", fileName, strerror(errno));
+    return false;
+  }
+  while (NULL != fgets(line.data(), (int) line.size(), fileContext)) {
+    if ('#' == line[0]) {
+      const char *key = line.data() + prefixLength;
+      const char *separator = strstr(line.data(), ": ");
+      if ((0 == strncmp(line.data(), HOST_METADATA_PREFIX, prefixLength)) && (NULL != separator)) {
+        std::string value(separator + 2);
+        value.erase(value.find_last_not_of(" \t\r\n") + 1);
+        file.metadata[std::string(key, separator - key)] = value;
+      }
+      continue;
+    }
+    compareSplitCells(line.data(), cells);
+    if ((1 == cells.size()) && cells[0].empty()) {
+      continue;
+    }
+    if (file.columns.empty()) {
+      file.columns = cells;
+      file.keyColumns = file.columns.size();
+      for (size_t column = 0; column < file.columns.size(); column++) {
+        if (compareIsMeasurement(file.columns[column])) {
+          file.keyColumns = column;
+          break;
+        }
+      }
+      file.metricColumn = file.keyColumns;
+      if (NULL != metric) {
+        file.metricColumn = std::find(file.columns.begin(), file.columns.end(), metric) - file.columns.begin();
+        file.keyColumns = std::min(file.keyColumns, file.metricColumn);
+      }
+      if (file.metricColumn >= file.columns.size()) {
+        fprintf(stderr, "File %s has no %s column.\n", fileName, (NULL != metric) ? metric : "measurement");
+        fclose(fileContext);
+        return false;
+      }
+      file.isHigherBetter = compareIsHigherBetter(file.columns[file.metricColumn]);
+      continue;
+    }
+    if (cells.size() <= file.metricColumn) {
+      continue;
+    }
+    value = strtod(cells[file.metricColumn].c_str(), &valueEnd);
+    if (cells[file.metricColumn].empty() || ('\0' != *valueEnd)) {
+      continue;
+    }
+    key.clear();
+    for (size_t column = 0; column < file.keyColumns; column++) {
+      key += (0 == column) ? cells[column] : (COMPARE_KEY_SEPARATOR + cells[column]);
+    }
+    if (rowIndex.end() == rowIndex.find(key)) {
+      rowIndex[key] = file.rows.size();
+      file.rows.push_back(compareRow_t());
+      file.rows.back().key = key;
+      file.rows.back().keyCells.assign(cells.begin(), cells.begin() + file.keyColumns);
+    }
+    file.rows[rowIndex[key]].samples.push_back(value);
+  }
+  fclose(fileContext);
+  file.fingerprint = file.metadata["fingerprint"];
+  if (file.columns.empty()) {
+    fprintf(stderr, "File %s has no header line.\n", fileName);
+    return false;
+  }
+  return true;
+}
+
+/******************************************************************************
+*
+* @return  median of the samples, the mean of the middle pair for even counts.
+*****************************************************************************/
+double compareMedian(std::vector<double> samples) {
+  size_t middle = samples.size() / 2;
+  double median;
+
+  std::nth_element(samples.begin(), samples.begin() + middle, samples.end());
+  median = samples[middle];
+  if (0 == (samples.size() % 2)) {
+    median = (median + *std::max_element(samples.begin(), samples.begin() + middle)) / 2;
+  }
+  return median;
+}
+
+/******************************************************************************
+* Counts the orderings of the two samples by the number of pairs the left
+* sample wins, N(u; m, n) = N(u - n; m - 1, n) + N(u; m, n - 1).
+* @return  probability that U is at most statisticU when there is no shift.
+*****************************************************************************/
+double compareExactLowerTail(size_t leftCount, size_t rightCount, double statisticU) {
+  size_t pairCount = leftCount * rightCount;
+  size_t stride = pairCount + 1;
+  std::vector<double> counts((leftCount + 1) * (rightCount + 1) * stride, 0);
+  double lowerCount = 0, totalCount = 0;
+
+  for (size_t left = 0; left <= leftCount; left++) {
+    for (size_t right = 0; right <= rightCount; right++) {
+      double *cell = &counts[(left * (rightCount + 1) + right) * stride];
+      if ((0 == left) || (0 == right)) {
+        cell[0] = 1;
+        continue;
+      }
+      const double *lessLeft = &counts[((left - 1) * (rightCount + 1) + right) * stride];
+      const double *lessRight = &counts[(left * (rightCount + 1) + right - 1) * stride];
+      for (size_t wins = 0; wins <= (left * right); wins++) {
+        cell[wins] = ((wins >= right) ? lessLeft[wins - right] : 0) + lessRight[wins];
+      }
+    }
+  }
+  const double *distribution = &counts[(leftCount * (rightCount + 1) + rightCount) * stride];
+  for (size_t wins = 0; wins <= pairCount; wins++) {
+    totalCount += distribution[wins];
+    lowerCount += (wins <= statisticU) ? distribution[wins] : 0;
+  }
+  return lowerCount / totalCount;
+}
+
+/******************************************************************************
+* Mann-Whitney U test of a shift between two samples. Ties take their mean
+* rank. Small samples without ties use the exact distribution of U, larger or
+* tied samples the normal approximation with tie and continuity correction.
+* @return  two sided p value.
+*****************************************************************************/
+double compareMannWhitney(const std::vector<double> &left, const std::vector<double> &right, double &statisticU) {
+  size_t leftCount = left.size(), rightCount = right.size(), totalCount = leftCount + rightCount;
+  std::vector<std::pair<double, size_t> > pooled;
+  double rankSum = 0, tieSum = 0, mean, variance, deviation, pValue;
+  size_t first, last;
+
+  statisticU = 0;
+  if ((0 == leftCount) || (0 == rightCount)) {
+    return 1;
+  }
+  for (size_t sample = 0; sample < totalCount; sample++) {
+    pooled.push_back((sample < leftCount) ? std::make_pair(left[sample], (size_t) 0)
+                                          : std::make_pair(right[sample - leftCount], (size_t) 1));
+  }
+  std::sort(pooled.begin(), pooled.end());
+  for (first = 0; first < totalCount; first = last) {
+    for (last = first + 1; (last < totalCount) && (pooled[last].first == pooled[first].first); last++) {
+    }
+    double tiedRank = (double) (first + 1 + last) / 2;
+    double tieSize = (double) (last - first);
+    tieSum += (tieSize * tieSize * tieSize) - tieSize;
+    for (size_t sample = first; sample < last; sample++) {
+      rankSum += (0 == pooled[sample].second) ? tiedRank : 0;
+    }
+  }
+  statisticU = rankSum - ((double) leftCount * (leftCount + 1)) / 2;
+  mean = ((double) leftCount * rightCount) / 2;
+  if ((0 == tieSum) && ((leftCount * rightCount) <= COMPARE_EXACT_PRODUCT_MAX)) {
+    double tail = compareExactLowerTail(leftCount, rightCount, std::min(statisticU, 2 * mean - statisticU));
+    return std::min(1.0, 2 * tail);
+  }
+  variance = (((double) leftCount * rightCount) / 12) *
+             ((totalCount + 1) - tieSum / ((double) totalCount * (totalCount - 1)));
+  if (variance <= 0) {
+    return 1;
+  }
+  deviation = std::max(0.0, fabs(statisticU - mean) - 0.5);
+  pValue = erfc(deviation / sqrt(2 * variance));
+  return std::min(1.0, pValue);
+}
+
+/******************************************************************************
+* Regressions first, then improvements, then unchanged rows, each by the
+* size of the change.
+* @return  true if the left result ranks before the right one.
+*****************************************************************************/
+bool compareResultOrder(const compareResult_t &left, const compareResult_t &right) {
+  if (left.verdict != right.verdict) {
+    return left.verdict < right.verdict;
+  }
+  return fabs(left.change) > fabs(right.change);
+}
+
+/******************************************************************************
+* Compares a baseline and a candidate result file of the same family, run
+* with --repeat so every row has samples. Rows match on the host fingerprint
+* and the key columns. A row regresses when its shift is significant at the
+* --significance level and its median is worse by more than --threshold
+* percent.
+* @return  EXIT_SUCCESS if no row regressed, EXIT_FAILURE otherwise or when the
+*          files can not be compared.
+*****************************************************************************/
+int testharness_Compare(const benchmarkOptions_t &options) {
+  compareFile_t baseline, candidate;
+  std::map<std::string, const compareRow_t *> candidateRows;
+  std::vector<compareResult_t> results;
+  size_t verdictCount[cv_count_e] = {0};
+  size_t unmatchedCount, samplesFewest = SIZE_MAX;
+
+  if ((NULL == options.baselineFile) || (NULL == options.candidateFile)) {
+    fprintf(stderr, "Mode compare requires --baseline FILE and --candidate FILE.\n");
+    return EXIT_FAILURE;
+  }
+  if (!compareFileLoad(options.baselineFile, options.metric, baseline) ||
+      !compareFileLoad(options.candidateFile, options.metric, candidate)) {
+    return EXIT_FAILURE;
+  }
+  if (baseline.fingerprint != candidate.fingerprint) {
+    fprintf(stderr, "Host fingerprints differ, %s versus %s, no rows match.\n",
+            baseline.fingerprint.empty() ? "none" : baseline.fingerprint.c_str(),
+            candidate.fingerprint.empty() ? "none" : candidate.fingerprint.c_str());
+    return EXIT_FAILURE;
+  }
+  if ((baseline.keyColumns != candidate.keyColumns) ||
+      (baseline.columns[baseline.metricColumn] != candidate.columns[candidate.metricColumn]) ||
+      !std::equal(baseline.columns.begin(), baseline.columns.begin() + baseline.keyColumns,
+                  candidate.columns.begin())) {
+    fprintf(stderr, "Files %s and %s have different columns.\n", options.baselineFile, options.candidateFile);
+    return EXIT_FAILURE;
+  }
+
+  for (size_t row = 0; row < candidate.rows.size(); row++) {
+    candidateRows[candidate.rows[row].key] = &candidate.rows[row];
+  }
+  for (size_t row = 0; row < baseline.rows.size(); row++) {
+    if (candidateRows.end() == candidateRows.find(baseline.rows[row].key)) {
+      continue;
+    }
+    compareResult_t result;
+    result.baseline = &baseline.rows[row];
+    result.candidate = candidateRows[baseline.rows[row].key];
+    result.baselineMedian = compareMedian(result.baseline->samples);
+    result.candidateMedian = compareMedian(result.candidate->samples);
+    result.change = (0 != result.baselineMedian)
+                    ? (100 * (result.candidateMedian - result.baselineMedian) / fabs(result.baselineMedian)) : 0;
+    result.change = baseline.isHigherBetter ? -result.change : result.change;
+    result.pValue = compareMannWhitney(result.baseline->samples, result.candidate->samples, result.statisticU);
+    result.verdict = cv_unchanged_e;
+    if (result.pValue < options.significance) {
+      if (result.change > options.threshold) {
+        result.verdict = cv_regression_e;
+      } else if (result.change < -options.threshold) {
+        result.verdict = cv_improvement_e;
+      }
+    }
+    verdictCount[result.verdict]++;
+    samplesFewest = std::min(samplesFewest,
+                             std::min(result.baseline->samples.size(), result.candidate->samples.size()));
+    results.push_back(result);
+  }
+  unmatchedCount = (baseline.rows.size() - results.size()) + (candidate.rows.size() - results.size());
+  std::stable_sort(results.begin(), results.end(), compareResultOrder);
+
+  printf("Comparing %s of %s against %s, %s is better.\n", baseline.columns[baseline.metricColumn].c_str(),
+         options.candidateFile, options.baselineFile, baseline.isHigherBetter ? "higher" : "lower");
+  printf("%-11s %10s %16s %16s %8s %10s %9s  %s\n", "Verdict", "Change %", "Baseline Median", "Candidate Median",
+         "U", "p", "Samples", "Row");
+  for (size_t row = 0; row < results.size(); row++) {
+    const compareResult_t &result = results[row];
+    printf("%-11s %+10.2f %16.6g %16.6g %8.1f %10.3g %4zu/%-4zu  %s\n", compareVerdictName(result.verdict),
+           result.change, result.baselineMedian, result.candidateMedian, result.statisticU, result.pValue,
+           result.baseline->samples.size(), result.candidate->samples.size(), result.baseline->key.c_str());
+  }
+  printf("Compared %zu rows, %zu regressions, %zu improvements, %zu unchanged, %zu unmatched rows, "
+         "threshold %.2f%% at p < %.3g.\n", results.size(), verdictCount[cv_regression_e],
+         verdictCount[cv_improvement_e], verdictCount[cv_unchanged_e], unmatchedCount, options.threshold,
+         options.significance);
+  if (!results.empty() && (samplesFewest < COMPARE_SAMPLES_ADVISED)) {
+    printf("Some rows have %zu samples, too few to be significant, run both sides with --repeat %d or more.\n",
+           samplesFewest, COMPARE_SAMPLES_ADVISED);
+  }
+  return (0 == verdictCount[cv_regression_e]) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // _CPUBENCHMARKCOMPARE_HPP_
@@ -0,0 +1,400 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKDISPATCH_HPP_
+#define _CPUBENCHMARKDISPATCH_HPP_
+
+#include <functional>
+#include <variant>
+
+#define DISPATCH_ITERATIONS_DEFAULT (1 << 24)
+#define DISPATCH_ARRAY_SIZE (1 << 12) // Power of two, the index wraps with a mask.
+#define DISPATCH_TARGET_COUNT 4 // Distinct addition targets a megamorphic call site rotates through.
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum dispatchStyle_e {
+  ds_directTemplate_e = 0, // performOp<tFunctor>, resolved at compile time
+  ds_functionPointer_e = 1, // dispatchAdditionTarget<classType> through a pointer
+  ds_virtual_e = 2, // Virtual call on a dispatchOperationBase
+  ds_stdFunction_e = 3, // std::function holding the functor
+  ds_variantVisit_e = 4, // std::variant of functors with std::visit
+  ds_switch_e = 5, // Switch on TypeSystemEnumeration_t (monomorphic) or the target index (megamorphic)
+  ds_count_e = 6
+} dispatchStyle_et;
+
+// Every target performs the same addition, so call sites differ only in how many targets they reach. The index
+// reaches the generated code so identical code folding cannot merge the targets back into one address.
+template<size_t targetIndex, class classType>
+struct dispatchAdditionFunctor {
+  classType operator()(classType a, classType b) {
+    __asm__ volatile("" : : "i"(targetIndex));
+    return performOp<tAddition>(a, b);
+  }
+};
+
+template<class classType>
+struct dispatchOperationBase {
+  virtual ~dispatchOperationBase() {}
+
+  virtual classType apply(classType a, classType b) = 0;
+};
+
+template<size_t targetIndex, class classType>
+struct dispatchOperationVirtual : public dispatchOperationBase<classType> {
+  classType apply(classType a, classType b) override {
+    return dispatchAdditionFunctor<targetIndex, classType>()(a, b);
+  }
+};
+
+template<class classType>
+using dispatchVariant_t = std::variant<dispatchAdditionFunctor<0, classType>, dispatchAdditionFunctor<1, classType>,
+                                       dispatchAdditionFunctor<2, classType>, dispatchAdditionFunctor<3, classType>>;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *dispatchStyleName(dispatchStyle_et style);
+
+void dispatchSwitchAddition(TypeSystemEnumeration_t mt, dynamicCompact_t *r, const dynamicCompact_t *a,
+                            const dynamicCompact_t *b);
+
+template<size_t targetIndex, class classType>
+classType dispatchAdditionTarget(classType a, classType b);
+
+template<class classType>
+classType dispatchSwitchTarget(size_t target, classType a, classType b);
+
+template<class classType>
+classType dispatchRun(dispatchStyle_et style, bool isMegamorphic, const classType *operands,
+                      const uint8_t *operations, size_t iterations);
+
+template<class classType>
+void dispatchMeasureType(FILE *fileContext, size_t iterations);
+
+int testharness_Dispatch(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the dispatch style.
+*****************************************************************************/
+const char *dispatchStyleName(dispatchStyle_et style) {
+  const char *styleName;
+  switch (style) {
+    case ds_directTemplate_e:
+      styleName = "direct_template";
+      break;
+    case ds_functionPointer_e:
+      styleName = "function_pointer";
+      break;
+    case ds_virtual_e:
+      styleName = "virtual";
+      break;
+    case ds_stdFunction_e:
+      styleName = "std_function";
+      break;
+    case ds_variantVisit_e:
+      styleName = "variant_visit";
+      break;
+    case ds_switch_e:
+      styleName = "switch";
+      break;
+    default:
+      styleName = "unknown";
+      break;
+  }
+  return styleName;
+}
+
+/******************************************************************************
+* Type erased addition the way threadContextMeta_t carries operands: the
+* values live in dynamicCompact_t and the type is switched on every call.
+* @return  None, the sum is stored in the member of r selected by mt.
+*****************************************************************************/
+__attribute__((noinline)) void dispatchSwitchAddition(TypeSystemEnumeration_t mt, dynamicCompact_t *r,
+                                                      const dynamicCompact_t *a, const dynamicCompact_t *b) {
+  switch (mt) {
+    case tse_int8_e:
+      r->int8_data = performOp<tAddition>(a->int8_data, b->int8_data);
+      break;
+    case tse_uint8_e:
+      r->uint8_data = performOp<tAddition>(a->uint8_data, b->uint8_data);
+      break;
+    case tse_int16_e:
+      r->int16_data = performOp<tAddition>(a->int16_data, b->int16_data);
+      break;
+    case tse_uint16_e:
+      r->uint16_data = performOp<tAddition>(a->uint16_data, b->uint16_data);
+      break;
+    case tse_int32_e:
+      r->int32_data = performOp<tAddition>(a->int32_data, b->int32_data);
+      break;
+    case tse_uint32_e:
+      r->uint32_data = performOp<tAddition>(a->uint32_data, b->uint32_data);
+      break;
+    case tse_int64_e:
+      r->int64_data = performOp<tAddition>(a->int64_data, b->int64_data);
+      break;
+    case tse_uint64_e:
+      r->uint64_data = performOp<tAddition>(a->uint64_data, b->uint64_data);
+      break;
+    case tse_float_e:
+      r->float_data = performOp<tAddition>(a->float_data, b->float_data);
+      break;
+    case tse_double_e:
+      r->double_data = performOp<tAddition>(a->double_data, b->double_data);
+      break;
+    case tse_long_double_e:
+      r->longdouble_data = performOp<tAddition>(a->longdouble_data, b->longdouble_data);
+      break;
+    default:
+      asserterror();
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* One function pointer target. Every index is a distinct function so the
+* table holds distinct addresses.
+* @return  a + b
+*****************************************************************************/
+template<size_t targetIndex, class classType>
+__attribute__((noinline)) classType dispatchAdditionTarget(classType a, classType b) {
+  return dispatchAdditionFunctor<targetIndex, classType>()(a, b);
+}
+
+/******************************************************************************
+*
+* @return  result of the selected addition target.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline)) classType dispatchSwitchTarget(size_t target, classType a, classType b) {
+  classType r;
+  switch (target) {
+    case 0:
+      r = dispatchAdditionFunctor<0, classType>()(a, b);
+      break;
+    case 1:
+      r = dispatchAdditionFunctor<1, classType>()(a, b);
+      break;
+    case 2:
+      r = dispatchAdditionFunctor<2, classType>()(a, b);
+      break;
+    case 3:
+      r = dispatchAdditionFunctor<3, classType>()(a, b);
+      break;
+    default:
+      r = a;
+      asserterror();
+      break;
+  }
+  return r;
+}
+
+/******************************************************************************
+* Runs a dependent chain of additions through one dispatch style. Monomorphic
+* call sites always reach the first target; megamorphic call sites follow the
+* random target sequence. Targets are picked through a volatile index so the
+* compiler cannot resolve them at compile time.
+* @return  accumulator to keep the loop alive.
+*****************************************************************************/
+template<class classType>
+classType dispatchRun(dispatchStyle_et style, bool isMegamorphic, const classType *operands,
+                      const uint8_t *operations, size_t iterations) {
+  volatile size_t additionIndex = 0;
+  classType accumulator = 0;
+  size_t index = 0;
+  size_t target;
+  classType (*functionTable[DISPATCH_TARGET_COUNT])(classType, classType) = {
+    dispatchAdditionTarget<0, classType>, dispatchAdditionTarget<1, classType>,
+    dispatchAdditionTarget<2, classType>, dispatchAdditionTarget<3, classType>};
+  dispatchOperationVirtual<0, classType> virtualTarget0;
+  dispatchOperationVirtual<1, classType> virtualTarget1;
+  dispatchOperationVirtual<2, classType> virtualTarget2;
+  dispatchOperationVirtual<3, classType> virtualTarget3;
+  dispatchOperationBase<classType> *virtualTable[DISPATCH_TARGET_COUNT] = {
+    &virtualTarget0, &virtualTarget1, &virtualTarget2, &virtualTarget3};
+  std::function<classType(classType, classType)> stdFunctionTable[DISPATCH_TARGET_COUNT] = {
+    dispatchAdditionFunctor<0, classType>(), dispatchAdditionFunctor<1, classType>(),
+    dispatchAdditionFunctor<2, classType>(), dispatchAdditionFunctor<3, classType>()};
+  dispatchVariant_t<classType> variantTable[DISPATCH_TARGET_COUNT] = {
+    dispatchAdditionFunctor<0, classType>(), dispatchAdditionFunctor<1, classType>(),
+    dispatchAdditionFunctor<2, classType>(), dispatchAdditionFunctor<3, classType>()};
+  TypeSystemEnumeration_t mt = typelessClassify<classType>(accumulator);
+  dynamicCompact_t compactAccumulator, compactOperand;
+  classType (*functionSelect)(classType, classType) = functionTable[additionIndex];
+  dispatchOperationBase<classType> *virtualSelect = virtualTable[additionIndex];
+  std::function<classType(classType, classType)> &stdFunctionSelect = stdFunctionTable[additionIndex];
+  dispatchVariant_t<classType> &variantSelect = variantTable[additionIndex];
+
+  memset(&compactAccumulator, 0, sizeof(dynamicCompact_t));
+  memset(&compactOperand, 0, sizeof(dynamicCompact_t));
+  // One loop per style so the selection of the style itself is not part of the measured call.
+  switch (style) {
+    case ds_directTemplate_e:
+      for (size_t count = 0; count < iterations; count++) {
+        accumulator = performOp<tAddition>(accumulator, operands[index]);
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    case ds_functionPointer_e:
+      for (size_t count = 0; count < iterations; count++) {
+        target = operations[index];
+        accumulator = isMegamorphic ? functionTable[target](accumulator, operands[index])
+                                    : functionSelect(accumulator, operands[index]);
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    case ds_virtual_e:
+      for (size_t count = 0; count < iterations; count++) {
+        target = operations[index];
+        accumulator = isMegamorphic ? virtualTable[target]->apply(accumulator, operands[index])
+                                    : virtualSelect->apply(accumulator, operands[index]);
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    case ds_stdFunction_e:
+      for (size_t count = 0; count < iterations; count++) {
+        target = operations[index];
+        accumulator = isMegamorphic ? stdFunctionTable[target](accumulator, operands[index])
+                                    : stdFunctionSelect(accumulator, operands[index]);
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    case ds_variantVisit_e:
+      for (size_t count = 0; count < iterations; count++) {
+        target = operations[index];
+        accumulator = std::visit([&](auto &functor) { return functor(accumulator, operands[index]); },
+                                 isMegamorphic ? variantTable[target] : variantSelect);
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    case ds_switch_e:
+      for (size_t count = 0; count < iterations; count++) {
+        target = operations[index];
+        if (isMegamorphic) {
+          accumulator = dispatchSwitchTarget<classType>(target, accumulator, operands[index]);
+        } else {
+          memcpy(&compactAccumulator, &accumulator, sizeof(classType));
+          memcpy(&compactOperand, &operands[index], sizeof(classType));
+          dispatchSwitchAddition(mt, &compactAccumulator, &compactAccumulator, &compactOperand);
+          memcpy(&accumulator, &compactAccumulator, sizeof(classType));
+        }
+        index = (index + 1) & (DISPATCH_ARRAY_SIZE - 1);
+      }
+      break;
+    default:
+      asserterror();
+      break;
+  }
+  return accumulator;
+}
+
+/******************************************************************************
+* Measures every dispatch style for one type with monomorphic and
+* megamorphic call sites.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void dispatchMeasureType(FILE *fileContext, size_t iterations) {
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  std::vector<classType> operands(DISPATCH_ARRAY_SIZE);
+  std::vector<uint8_t> operations(DISPATCH_ARRAY_SIZE);
+  volatile classType dispatchSink;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double timeDelta;
+  double timeDirect = 0.0;
+  double timeStart;
+  uint64_t cycleStart;
+  uint64_t cycleDelta;
+  bool isMegamorphic;
+
+  // Operands of one keep the chain exact for every type; integer chains wrap.
+  for (size_t index = 0; index < DISPATCH_ARRAY_SIZE; index++) {
+    operands[index] = (classType) 1;
+    operations[index] = (uint8_t) ((size_t) (gauss_rand<double>(1) * DISPATCH_TARGET_COUNT) % DISPATCH_TARGET_COUNT);
+  }
+  typelessStringName<classType>(operands[0], typeNameBuffer, false);
+
+  for (size_t callSite = 0; callSite < 2; callSite++) {
+    isMegamorphic = (1 == callSite);
+    for (size_t style = 0; style < ds_count_e; style++) {
+      if (isMegamorphic && (ds_directTemplate_e == style)) {
+        // A compile time call site has one target by definition.
+        continue;
+      }
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timeStart = getTime();
+      cycleStart = getCycleCount();
+      dispatchSink = dispatchRun<classType>((dispatchStyle_et) style, isMegamorphic, operands.data(),
+                                            operations.data(), iterations);
+      cycleDelta = getCycleCount() - cycleStart;
+      timeDelta = getTime() - timeStart;
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      if (ds_directTemplate_e == style) {
+        timeDirect = timeDelta;
+      }
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %zu, %f, %f, %f, %f",
+                     typeNameBuffer, dispatchStyleName((dispatchStyle_et) style),
+                     isMegamorphic ? "megamorphic" : "monomorphic", iterations, timeDelta,
+                     (timeDelta * 1e9) / (double) iterations, (double) cycleDelta / (double) iterations,
+                     (timeDirect > 0.0) ? (timeDelta / timeDirect) : 0.0);
+    }
+  }
+  (void) dispatchSink;
+  return;
+}
+
+/******************************************************************************
+* Runs the same tAddition chain through every dispatch style for every type of
+* the type system.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Dispatch(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Type System, Dispatch, Call Site, Calls, Time for Operations, Nanoseconds per Call, "
+                            "Cycles per Call, Relative to Direct Template";
+  size_t iterations = (options.iterations > 0) ? options.iterations : DISPATCH_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  fileContext = resultFileOpen("Dispatch", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  dispatchMeasureType<int8_t>(fileContext, iterations);
+  dispatchMeasureType<uint8_t>(fileContext, iterations);
+  dispatchMeasureType<int16_t>(fileContext, iterations);
+  dispatchMeasureType<uint16_t>(fileContext, iterations);
+  dispatchMeasureType<int32_t>(fileContext, iterations);
+  dispatchMeasureType<uint32_t>(fileContext, iterations);
+  dispatchMeasureType<int64_t>(fileContext, iterations);
+  dispatchMeasureType<uint64_t>(fileContext, iterations);
+  dispatchMeasureType<float>(fileContext, iterations);
+  dispatchMeasureType<double>(fileContext, iterations);
+  dispatchMeasureType<long double>(fileContext, iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKDISPATCH_HPP_
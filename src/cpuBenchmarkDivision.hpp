@@ -0,0 +1,676 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKDIVISION_HPP_
+#define _CPUBENCHMARKDIVISION_HPP_
+
+#include <limits>
+#include <utility>
+
+#define DIVISION_ITERATIONS_DEFAULT (1 << 19)
+#define DIVISION_ARRAY_SIZE (1 << 12) // Power of two, the index wraps with a mask.
+#define DIVISION_BINS 4 // Operand bit-length bins per integer type, each a quarter of the magnitude bits
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum divisionStrategy_e {
+  dv_hardwareDivide_e = 0, // n / d, runtime divisor (div, idiv, divss, divsd)
+  dv_hardwareModulo_e = 1, // n % d, runtime divisor
+  dv_hardwareDivMod_e = 2, // n / d and n % d from the same divide, reported as q ^ r
+  dv_typelessDivide_e = 3, // typelessDivision, runtime divisor behind the zero branch
+  dv_constantDivide_e = 4, // n / D, divisor known at compile time
+  dv_constantModulo_e = 5, // n % D
+  dv_magicDivide_e = 6, // multiply-high and shifts with a precomputed magic number
+  dv_magicModulo_e = 7, // n - d * magic quotient
+  dv_reciprocalMultiply_e = 8, // n * (1 / d) with a precomputed reciprocal, floating point only
+  dv_reciprocalRefine_e = 9, // reciprocal estimate, Newton iterations and a residual correction, not correctly rounded
+  dv_count_e = 10 // Identity, the latency chain overhead
+} divisionStrategy_et;
+
+typedef struct divisionMagic {
+  uint64_t multiplier; // Low width bits of the width + 1 bit magic number
+  uint32_t shiftFirst; // 0 for the divisor 1, 1 otherwise
+  uint32_t shiftSecond; // ceil(log2(divisor)) - 1
+} divisionMagic_t;
+
+// Precomputed reciprocal, double for integer types so every 32 bit quotient is one correction away.
+template<class classType>
+using divisionReciprocal_t = typename std::conditional<std::is_floating_point<classType>::value, classType,
+                                                       double>::type;
+
+template<class classType>
+struct divisionOperands {
+  std::vector<classType> dividend;
+  std::vector<classType> divisor;
+  std::vector<divisionMagic_t> magic; // Per divisor, integer types
+  std::vector<divisionReciprocal_t<classType>> reciprocal; // Per divisor
+};
+
+typedef struct divisionTiming {
+  uint64_t throughputCycles; // Independent divisions
+  uint64_t latencyCycles; // Each dividend depends on the previous quotient
+  double throughputTime; // Seconds for the independent loop
+  frequencySample_t frequency; // Monitor values of both loops
+} divisionTiming_t;
+
+template<class classType>
+using divisionMeasure_ft = divisionTiming_t (*)(const divisionOperands<classType> &operands, classType *out,
+                                                size_t iterations);
+
+template<class classType>
+using divisionMismatch_ft = size_t (*)(const divisionOperands<classType> &operands, const classType *out,
+                                       size_t iterations);
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *divisionStrategyName(divisionStrategy_et strategy);
+
+template<class classType>
+bool divisionStrategySupported(divisionStrategy_et strategy);
+
+template<class classType>
+divisionMagic_t divisionMagicCompute(classType divisor);
+
+template<class classType>
+classType divisionMagicQuotient(classType dividend, classType divisor, const divisionMagic_t &magic);
+
+template<class classType>
+classType divisionReciprocalRefine(classType dividend, classType divisor, divisionReciprocal_t<classType> reciprocal);
+
+template<size_t strategy, class classType, int64_t constantDivisor>
+classType divisionApply(classType dividend, classType divisor, const divisionMagic_t &magic,
+                        divisionReciprocal_t<classType> reciprocal);
+
+template<size_t strategy, class classType, int64_t constantDivisor, bool isLatency>
+uint64_t divisionLoop(const divisionOperands<classType> &operands, classType *out, size_t iterations);
+
+template<size_t strategy, class classType, int64_t constantDivisor>
+divisionTiming_t divisionMeasure(const divisionOperands<classType> &operands, classType *out, size_t iterations);
+
+template<size_t strategy, class classType, int64_t constantDivisor>
+size_t divisionMismatches(const divisionOperands<classType> &operands, const classType *out, size_t iterations);
+
+template<class classType, size_t... strategy>
+void divisionMeasureTableFill(divisionMeasure_ft<classType> measureTable[dv_count_e],
+                              divisionMismatch_ft<classType> mismatchTable[dv_count_e], std::index_sequence<strategy...>);
+
+uint64_t divisionRandomBits(size_t bitsLow, size_t bitsHigh);
+
+template<class classType>
+void divisionOperandsFill(divisionOperands<classType> &operands, size_t dividendBitsLow, size_t dividendBitsHigh,
+                          size_t divisorBitsLow, size_t divisorBitsHigh);
+
+template<class classType>
+void divisionReport(FILE *fileContext, divisionStrategy_et strategy, const char *divisorText,
+                    const char *dividendBits, const char *divisorBits, size_t iterations,
+                    const divisionTiming_t &timing, const divisionTiming_t &chain, size_t mismatches);
+
+template<class classType, int64_t constantDivisor>
+void divisionMeasureConstant(FILE *fileContext, const divisionOperands<classType> &operands, classType *out,
+                             size_t iterations, const divisionTiming_t &chain, const char *dividendBits);
+
+template<class classType>
+void divisionMeasureType(FILE *fileContext, size_t iterations);
+
+int testharness_Division(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the division strategy.
+*****************************************************************************/
+const char *divisionStrategyName(divisionStrategy_et strategy) {
+  const char *strategyName;
+  switch (strategy) {
+    case dv_hardwareDivide_e:
+      strategyName = "hardware_divide";
+      break;
+    case dv_hardwareModulo_e:
+      strategyName = "hardware_modulo";
+      break;
+    case dv_hardwareDivMod_e:
+      strategyName = "hardware_divmod";
+      break;
+    case dv_typelessDivide_e:
+      strategyName = "typeless_divide";
+      break;
+    case dv_constantDivide_e:
+      strategyName = "constant_divide";
+      break;
+    case dv_constantModulo_e:
+      strategyName = "constant_modulo";
+      break;
+    case dv_magicDivide_e:
+      strategyName = "magic_divide";
+      break;
+    case dv_magicModulo_e:
+      strategyName = "magic_modulo";
+      break;
+    case dv_reciprocalMultiply_e:
+      strategyName = "reciprocal_multiply";
+      break;
+    case dv_reciprocalRefine_e:
+      strategyName = "reciprocal_refine";
+      break;
+    default:
+      strategyName = "unknown";
+      break;
+  }
+  return strategyName;
+}
+
+/******************************************************************************
+* Modulo and magic numbers are integer only; multiplying by a reciprocal is
+* only a division for floating point.
+* @return  true when the strategy is measured for the type.
+*****************************************************************************/
+template<class classType>
+bool divisionStrategySupported(divisionStrategy_et strategy) {
+  bool isSupported;
+  switch (strategy) {
+    case dv_hardwareModulo_e:
+    case dv_hardwareDivMod_e:
+    case dv_constantModulo_e:
+    case dv_magicDivide_e:
+    case dv_magicModulo_e:
+      isSupported = std::is_integral<classType>::value;
+      break;
+    case dv_reciprocalMultiply_e:
+      isSupported = std::is_floating_point<classType>::value;
+      break;
+    case dv_count_e:
+      isSupported = false;
+      break;
+    default:
+      isSupported = true;
+      break;
+  }
+  return isSupported;
+}
+
+/******************************************************************************
+* Round-up magic number for unsigned division of width bit magnitudes
+* (Granlund and Montgomery): m = 2^width * (2^l - d) / d + 1, l = ceil(log2(d)).
+* Signed types divide magnitudes and restore the sign.
+* @return  magic number and shifts of the divisor.
+*****************************************************************************/
+template<class classType>
+divisionMagic_t divisionMagicCompute(classType divisor) {
+  typedef typename std::make_unsigned<classType>::type unsignedType;
+  constexpr unsigned width = sizeof(classType) * CHAR_BIT;
+  unsignedType magnitude = (unsignedType) divisor;
+  divisionMagic_t magic;
+  uint32_t logCeiling;
+
+  if constexpr (std::is_signed<classType>::value) {
+    magnitude = (divisor < 0) ? (unsignedType) (0 - (unsignedType) divisor) : (unsignedType) divisor;
+  }
+  logCeiling = (magnitude <= 1) ? 0 : (uint32_t) (64 - __builtin_clzll((uint64_t) magnitude - 1));
+  magic.multiplier = (uint64_t) (((((unsigned __int128) 1 << logCeiling) - magnitude) << width) / magnitude + 1);
+  magic.shiftFirst = (logCeiling > 0) ? 1 : 0;
+  magic.shiftSecond = (logCeiling > 0) ? (logCeiling - 1) : 0;
+  return magic;
+}
+
+/******************************************************************************
+* q = (t + ((n - t) >> shiftFirst)) >> shiftSecond with t = mulhi(m, n).
+* @return  truncated quotient.
+*****************************************************************************/
+template<class classType>
+inline classType divisionMagicQuotient(classType dividend, classType divisor, const divisionMagic_t &magic) {
+  typedef typename std::make_unsigned<classType>::type unsignedType;
+  constexpr unsigned width = sizeof(classType) * CHAR_BIT;
+  unsignedType magnitude = (unsignedType) dividend;
+  unsignedType high;
+  unsignedType quotient;
+
+  if constexpr (std::is_signed<classType>::value) {
+    magnitude = (dividend < 0) ? (unsignedType) (0 - (unsignedType) dividend) : (unsignedType) dividend;
+  }
+  if constexpr (64 == width) {
+    high = (unsignedType) (((unsigned __int128) magic.multiplier * magnitude) >> 64);
+  } else {
+    high = (unsignedType) ((magic.multiplier * (uint64_t) magnitude) >> width);
+  }
+  quotient = (unsignedType) ((high + (unsignedType) ((unsignedType) (magnitude - high) >> magic.shiftFirst)) >>
+                             magic.shiftSecond);
+  if constexpr (std::is_signed<classType>::value) {
+    return ((dividend < 0) != (divisor < 0)) ? (classType) (0 - quotient) : (classType) quotient;
+  } else {
+    (void) divisor;
+    return (classType) quotient;
+  }
+}
+
+/******************************************************************************
+* Integer types: quotient estimate from the precomputed double reciprocal of
+* the divisor magnitude, a second estimate from the remainder for 64 bit
+* types, then one remainder correction.
+* Floating point: bit pattern seed of 1 / d, Newton iterations
+* x = x * (2 - d * x) and one residual Newton step on n * x. The quotient may
+* differ from n / d in the last place, it is not correctly rounded.
+* @return  quotient.
+*****************************************************************************/
+template<class classType>
+inline classType divisionReciprocalRefine(classType dividend, classType divisor,
+                                          divisionReciprocal_t<classType> reciprocal) {
+  if constexpr (std::is_floating_point<classType>::value) {
+    classType estimate;
+    classType quotient;
+    (void) reciprocal;
+    if constexpr (sizeof(classType) == sizeof(uint32_t)) {
+      uint32_t bits;
+      memcpy(&bits, &divisor, sizeof(bits));
+      bits = 0x7EF311C3U - bits;
+      memcpy(&estimate, &bits, sizeof(bits));
+      for (size_t step = 0; step < 3; step++) {
+        estimate = estimate * ((classType) 2 - divisor * estimate);
+      }
+    } else {
+      uint64_t bits;
+      memcpy(&bits, &divisor, sizeof(bits));
+      bits = 0x7FDE623822FC16E6ULL - bits;
+      memcpy(&estimate, &bits, sizeof(bits));
+      for (size_t step = 0; step < 4; step++) {
+        estimate = estimate * ((classType) 2 - divisor * estimate);
+      }
+    }
+    quotient = dividend * estimate;
+    return quotient + estimate * (dividend - quotient * divisor);
+  } else {
+    typedef typename std::make_unsigned<classType>::type unsignedType;
+    typedef typename std::conditional<(sizeof(classType) == sizeof(uint64_t)), __int128, int64_t>::type wideType;
+    constexpr double quotientMax = 18446744073709549568.0; // Largest double below 2^64
+    unsignedType magnitude = (unsignedType) dividend;
+    unsignedType divisorMagnitude = (unsignedType) divisor;
+    unsignedType quotient;
+    wideType remainder;
+
+    if constexpr (std::is_signed<classType>::value) {
+      magnitude = (dividend < 0) ? (unsignedType) (0 - (unsignedType) dividend) : (unsignedType) dividend;
+      divisorMagnitude = (divisor < 0) ? (unsignedType) (0 - (unsignedType) divisor) : (unsignedType) divisor;
+    }
+    quotient = (unsignedType) std::min((double) magnitude * reciprocal, quotientMax);
+    if constexpr (sizeof(classType) == sizeof(uint64_t)) {
+      // The double product carries 53 bits, the remainder estimate recovers the rest.
+      remainder = (wideType) magnitude - (wideType) quotient * divisorMagnitude;
+      quotient += (unsignedType) (int64_t) ((double) remainder * reciprocal);
+    }
+    remainder = (wideType) magnitude - (wideType) quotient * divisorMagnitude;
+    if (remainder < 0) {
+      quotient--;
+    } else if (remainder >= (wideType) divisorMagnitude) {
+      quotient++;
+    }
+    if constexpr (std::is_signed<classType>::value) {
+      return ((dividend < 0) != (divisor < 0)) ? (classType) (0 - quotient) : (classType) quotient;
+    } else {
+      return (classType) quotient;
+    }
+  }
+}
+
+/******************************************************************************
+* One division by the strategy; unsupported strategies and dv_count_e return
+* the dividend.
+* @return  quotient, remainder or quotient ^ remainder.
+*****************************************************************************/
+template<size_t strategy, class classType, int64_t constantDivisor>
+inline classType divisionApply(classType dividend, classType divisor, const divisionMagic_t &magic,
+                               divisionReciprocal_t<classType> reciprocal) {
+  if constexpr (dv_hardwareDivide_e == strategy) {
+    return (classType) (dividend / divisor);
+  } else if constexpr (dv_typelessDivide_e == strategy) {
+    return typelessDivision<classType>(dividend, divisor);
+  } else if constexpr (dv_constantDivide_e == strategy) {
+    return (classType) (dividend / (classType) constantDivisor);
+  } else if constexpr (dv_reciprocalRefine_e == strategy) {
+    return divisionReciprocalRefine<classType>(dividend, divisor, reciprocal);
+  } else if constexpr (std::is_floating_point<classType>::value) {
+    if constexpr (dv_reciprocalMultiply_e == strategy) {
+      return dividend * reciprocal;
+    } else {
+      return dividend;
+    }
+  } else if constexpr (dv_hardwareModulo_e == strategy) {
+    return (classType) (dividend % divisor);
+  } else if constexpr (dv_hardwareDivMod_e == strategy) {
+    return (classType) ((dividend / divisor) ^ (dividend % divisor));
+  } else if constexpr (dv_constantModulo_e == strategy) {
+    return (classType) (dividend % (classType) constantDivisor);
+  } else if constexpr (dv_magicDivide_e == strategy) {
+    return divisionMagicQuotient<classType>(dividend, divisor, magic);
+  } else if constexpr (dv_magicModulo_e == strategy) {
+    typedef typename std::make_unsigned<classType>::type unsignedType;
+    classType quotient = divisionMagicQuotient<classType>(dividend, divisor, magic);
+    return (classType) ((unsignedType) dividend - (unsignedType) quotient * (unsignedType) divisor);
+  } else {
+    return dividend;
+  }
+}
+
+/******************************************************************************
+* Divisions over the operand arrays. For latency, each dividend also takes
+* the previous result through an and/add (integer) or multiply/add (floating
+* point) with a zero the compiler cannot see, which leaves the operands
+* unchanged; the chain overhead is measured with dv_count_e.
+* @return  time stamp counter cycles for the loop.
+*****************************************************************************/
+template<size_t strategy, class classType, int64_t constantDivisor, bool isLatency>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+uint64_t divisionLoop(const divisionOperands<classType> &operands, classType *out, size_t iterations) {
+  const classType *dividend = operands.dividend.data();
+  const classType *divisor = operands.divisor.data();
+  const divisionMagic_t *magic = operands.magic.data();
+  const divisionReciprocal_t<classType> *reciprocal = operands.reciprocal.data();
+  classType chainZero = 0;
+  classType previous = 0;
+  classType operand;
+  size_t index = 0;
+  uint64_t cycleStart;
+
+  __asm__ __volatile__("" : "+m"(chainZero));
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    operand = dividend[index];
+    if constexpr (isLatency && std::is_floating_point<classType>::value) {
+      operand = operand + previous * chainZero;
+    } else if constexpr (isLatency) {
+      operand = (classType) (operand + (previous & chainZero));
+    }
+    previous = divisionApply<strategy, classType, constantDivisor>(operand, divisor[index], magic[index],
+                                                                   reciprocal[index]);
+    out[index] = previous;
+    index = (index + 1) & (DIVISION_ARRAY_SIZE - 1);
+  }
+  return getCycleCount() - cycleStart;
+}
+
+/******************************************************************************
+* Throughput and latency of one strategy on the current operands.
+* @return  cycles and time of both loops.
+*****************************************************************************/
+template<size_t strategy, class classType, int64_t constantDivisor>
+divisionTiming_t divisionMeasure(const divisionOperands<classType> &operands, classType *out, size_t iterations) {
+  frequencySnapshot_t frequencyStart;
+  divisionTiming_t timing;
+  double timeStart;
+
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timing.latencyCycles = divisionLoop<strategy, classType, constantDivisor, true>(operands, out, iterations);
+  timeStart = getTime();
+  timing.throughputCycles = divisionLoop<strategy, classType, constantDivisor, false>(operands, out, iterations);
+  timing.throughputTime = getTime() - timeStart;
+  timing.frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  return timing;
+}
+
+/******************************************************************************
+* Compares the results left by the throughput loop with the C operators.
+* @return  number of results that differ.
+*****************************************************************************/
+template<size_t strategy, class classType, int64_t constantDivisor>
+size_t divisionMismatches(const divisionOperands<classType> &operands, const classType *out, size_t iterations) {
+  size_t mismatches = 0;
+  classType dividend;
+  classType divisor;
+  classType expected;
+
+  for (size_t index = 0; index < std::min(iterations, (size_t) DIVISION_ARRAY_SIZE); index++) {
+    dividend = operands.dividend[index];
+    divisor = (0 == constantDivisor) ? operands.divisor[index] : (classType) constantDivisor;
+    if constexpr (std::is_integral<classType>::value) {
+      if constexpr ((dv_hardwareModulo_e == strategy) || (dv_constantModulo_e == strategy) ||
+                    (dv_magicModulo_e == strategy)) {
+        expected = (classType) (dividend % divisor);
+      } else if constexpr (dv_hardwareDivMod_e == strategy) {
+        expected = (classType) ((dividend / divisor) ^ (dividend % divisor));
+      } else {
+        expected = (classType) (dividend / divisor);
+      }
+    } else {
+      expected = dividend / divisor;
+    }
+    if (expected != out[index]) {
+      mismatches++;
+    }
+  }
+  return mismatches;
+}
+
+/******************************************************************************
+* Runtime divisor strategies, indexed by divisionStrategy_et.
+* @return  None
+*****************************************************************************/
+template<class classType, size_t... strategy>
+void divisionMeasureTableFill(divisionMeasure_ft<classType> measureTable[dv_count_e],
+                              divisionMismatch_ft<classType> mismatchTable[dv_count_e],
+                              std::index_sequence<strategy...>) {
+  ((measureTable[strategy] = divisionMeasure<strategy, classType, 0>), ...);
+  ((mismatchTable[strategy] = divisionMismatches<strategy, classType, 0>), ...);
+  return;
+}
+
+/******************************************************************************
+* Random value whose bit length is uniform in [bitsLow, bitsHigh].
+* @return  value with the top bit of its length set.
+*****************************************************************************/
+uint64_t divisionRandomBits(size_t bitsLow, size_t bitsHigh) {
+  size_t bits = bitsLow + (size_t) (gauss_rand<double>(1) * (double) (bitsHigh - bitsLow + 1)) %
+                          (bitsHigh - bitsLow + 1);
+  uint64_t value = ((uint64_t) (gauss_rand<double>(1) * 4294967295.0) << 32) ^
+                   (uint64_t) (gauss_rand<double>(1) * 4294967295.0);
+
+  return (value & ((1ULL << (bits - 1)) - 1)) | (1ULL << (bits - 1));
+}
+
+/******************************************************************************
+* Fills dividends and divisors with magnitudes in the bit-length bins, random
+* signs for signed types, and precomputes magic numbers and reciprocals.
+* Floating point operands ignore the bins. Signed magnitudes stay below the
+* sign bit, so the minimum divided by -1 never occurs.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void divisionOperandsFill(divisionOperands<classType> &operands, size_t dividendBitsLow, size_t dividendBitsHigh,
+                          size_t divisorBitsLow, size_t divisorBitsHigh) {
+  classType dividend;
+  classType divisor;
+
+  operands.dividend.resize(DIVISION_ARRAY_SIZE);
+  operands.divisor.resize(DIVISION_ARRAY_SIZE);
+  operands.magic.resize(DIVISION_ARRAY_SIZE);
+  operands.reciprocal.resize(DIVISION_ARRAY_SIZE);
+  for (size_t index = 0; index < DIVISION_ARRAY_SIZE; index++) {
+    if constexpr (std::is_floating_point<classType>::value) {
+      dividend = (classType) ((gauss_rand<double>(1) - 0.5) * 2048.0);
+      divisor = (classType) ((gauss_rand<double>(1) + 0.5) * ((gauss_rand<double>(1) < 0.5) ? -16.0 : 16.0));
+      operands.magic[index] = {0, 0, 0};
+    } else {
+      dividend = (classType) divisionRandomBits(dividendBitsLow, dividendBitsHigh);
+      divisor = (classType) divisionRandomBits(divisorBitsLow, divisorBitsHigh);
+      if constexpr (std::is_signed<classType>::value) {
+        dividend = (gauss_rand<double>(1) < 0.5) ? (classType) -dividend : dividend;
+        divisor = (gauss_rand<double>(1) < 0.5) ? (classType) -divisor : divisor;
+      }
+      operands.magic[index] = divisionMagicCompute<classType>(divisor);
+    }
+    operands.dividend[index] = dividend;
+    operands.divisor[index] = divisor;
+    if constexpr (std::is_signed<classType>::value && std::is_integral<classType>::value) {
+      operands.reciprocal[index] = 1.0 / std::fabs((double) divisor);
+    } else {
+      operands.reciprocal[index] = (divisionReciprocal_t<classType>) 1 / (divisionReciprocal_t<classType>) divisor;
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Prints one row; latency has the chain overhead removed.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void divisionReport(FILE *fileContext, divisionStrategy_et strategy, const char *divisorText,
+                    const char *dividendBits, const char *divisorBits, size_t iterations,
+                    const divisionTiming_t &timing, const divisionTiming_t &chain, size_t mismatches) {
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  double latencyCycles = 0.0;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  if (timing.latencyCycles > chain.latencyCycles) {
+    latencyCycles = (double) (timing.latencyCycles - chain.latencyCycles) / (double) iterations;
+  }
+  resultPrintRow(fileContext, true, &timing.frequency, "%s, %s, %s, %s, %s, %zu, %f, %f, %f, %f, %zu",
+                 typeNameBuffer, divisionStrategyName(strategy), divisorText, dividendBits, divisorBits, iterations,
+                 (double) timing.throughputCycles / (double) iterations, latencyCycles,
+                 (timing.throughputTime * 1e9) / (double) iterations,
+                 (timing.throughputTime > 0.0) ? ((double) iterations / timing.throughputTime) : 0.0, mismatches);
+  return;
+}
+
+/******************************************************************************
+* Division and modulo by one compile-time divisor, skipped when the divisor
+* does not fit the type.
+* @return  None
+*****************************************************************************/
+template<class classType, int64_t constantDivisor>
+void divisionMeasureConstant(FILE *fileContext, const divisionOperands<classType> &operands, classType *out,
+                             size_t iterations, const divisionTiming_t &chain, const char *dividendBits) {
+  char divisorText[CHAR_BUFFER_SIZE];
+  char divisorBits[CHAR_BUFFER_SIZE];
+  divisionTiming_t timing;
+  size_t mismatches;
+
+  if constexpr ((double) constantDivisor <= (double) std::numeric_limits<classType>::max()) {
+    snprintf(divisorText, sizeof(divisorText), "%" PRId64, constantDivisor);
+    snprintf(divisorBits, sizeof(divisorBits), "%d", 64 - __builtin_clzll((uint64_t) constantDivisor));
+    timing = divisionMeasure<dv_constantDivide_e, classType, constantDivisor>(operands, out, iterations);
+    mismatches = divisionMismatches<dv_constantDivide_e, classType, constantDivisor>(operands, out, iterations);
+    divisionReport<classType>(fileContext, dv_constantDivide_e, divisorText, dividendBits, divisorBits, iterations,
+                              timing, chain, mismatches);
+    if (divisionStrategySupported<classType>(dv_constantModulo_e)) {
+      timing = divisionMeasure<dv_constantModulo_e, classType, constantDivisor>(operands, out, iterations);
+      mismatches = divisionMismatches<dv_constantModulo_e, classType, constantDivisor>(operands, out, iterations);
+      divisionReport<classType>(fileContext, dv_constantModulo_e, divisorText, dividendBits, divisorBits,
+                                iterations, timing, chain, mismatches);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Integer types sweep dividend and divisor bit-length bins (divisor bin not
+* above the dividend bin); floating point types use one operand set.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void divisionMeasureType(FILE *fileContext, size_t iterations) {
+  constexpr size_t magnitudeBits = sizeof(classType) * CHAR_BIT - (std::is_signed<classType>::value ? 1 : 0);
+  constexpr size_t binCount = std::is_integral<classType>::value ? DIVISION_BINS : 1;
+  divisionMeasure_ft<classType> measureTable[dv_count_e];
+  divisionMismatch_ft<classType> mismatchTable[dv_count_e];
+  size_t binHigh[DIVISION_BINS + 1];
+  divisionOperands<classType> operands;
+  std::vector<classType> out(DIVISION_ARRAY_SIZE);
+  char dividendBits[CHAR_BUFFER_SIZE];
+  char divisorBits[CHAR_BUFFER_SIZE];
+  divisionTiming_t chain;
+  divisionTiming_t timing;
+
+  divisionMeasureTableFill<classType>(measureTable, mismatchTable, std::make_index_sequence<dv_count_e>{});
+  binHigh[0] = 0;
+  for (size_t bin = 1; bin <= DIVISION_BINS; bin++) {
+    binHigh[bin] = (bin * magnitudeBits + DIVISION_BINS - 1) / DIVISION_BINS;
+  }
+
+  for (size_t dividendBin = 1; dividendBin <= binCount; dividendBin++) {
+    if (std::is_integral<classType>::value) {
+      snprintf(dividendBits, sizeof(dividendBits), "%zu-%zu", binHigh[dividendBin - 1] + 1, binHigh[dividendBin]);
+    } else {
+      dividendBits[0] = '\0';
+    }
+    for (size_t divisorBin = 1; divisorBin <= dividendBin; divisorBin++) {
+      if (std::is_integral<classType>::value) {
+        snprintf(divisorBits, sizeof(divisorBits), "%zu-%zu", binHigh[divisorBin - 1] + 1, binHigh[divisorBin]);
+      } else {
+        divisorBits[0] = '\0';
+      }
+      divisionOperandsFill<classType>(operands, binHigh[dividendBin - 1] + 1, binHigh[dividendBin],
+                                      binHigh[divisorBin - 1] + 1, binHigh[divisorBin]);
+      chain = divisionMeasure<dv_count_e, classType, 0>(operands, out.data(), iterations);
+      for (size_t strategy = 0; strategy < dv_count_e; strategy++) {
+        if ((dv_constantDivide_e == strategy) || (dv_constantModulo_e == strategy) ||
+            !divisionStrategySupported<classType>((divisionStrategy_et) strategy)) {
+          continue;
+        }
+        timing = measureTable[strategy](operands, out.data(), iterations);
+        divisionReport<classType>(fileContext, (divisionStrategy_et) strategy, "runtime", dividendBits, divisorBits,
+                                  iterations, timing, chain, mismatchTable[strategy](operands, out.data(), iterations));
+      }
+    }
+    // Compile-time divisors of increasing bit length against the same dividends.
+    divisionMeasureConstant<classType, 3>(fileContext, operands, out.data(), iterations, chain, dividendBits);
+    divisionMeasureConstant<classType, 10>(fileContext, operands, out.data(), iterations, chain, dividendBits);
+    divisionMeasureConstant<classType, 100>(fileContext, operands, out.data(), iterations, chain, dividendBits);
+    divisionMeasureConstant<classType, 10007>(fileContext, operands, out.data(), iterations, chain, dividendBits);
+    divisionMeasureConstant<classType, 1000003>(fileContext, operands, out.data(), iterations, chain, dividendBits);
+    divisionMeasureConstant<classType, 1000000007>(fileContext, operands, out.data(), iterations, chain,
+                                                   dividendBits);
+  }
+  return;
+}
+
+/******************************************************************************
+* Compares hardware divide and modulo, compile-time divisors, magic number
+* multiply-shift and reciprocal refinement, binned by operand bit length.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Division(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Type System, Strategy, Divisor, Dividend Bits, Divisor Bits, Operations, "
+                            "Cycles per Operation Throughput, Cycles per Operation Latency, "
+                            "Nanoseconds per Operation, Operations per Second, Mismatches";
+  size_t iterations = (options.iterations > 0) ? options.iterations : DIVISION_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Cycles are time stamp counter (nominal frequency) cycles. Bits are operand magnitude bit lengths.\n");
+  printf("Magic numbers and reciprocals are precomputed per divisor, their setup is not timed.\n");
+  fileContext = resultFileOpen("Division", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  divisionMeasureType<int8_t>(fileContext, iterations);
+  divisionMeasureType<uint8_t>(fileContext, iterations);
+  divisionMeasureType<int16_t>(fileContext, iterations);
+  divisionMeasureType<uint16_t>(fileContext, iterations);
+  divisionMeasureType<int32_t>(fileContext, iterations);
+  divisionMeasureType<uint32_t>(fileContext, iterations);
+  divisionMeasureType<int64_t>(fileContext, iterations);
+  divisionMeasureType<uint64_t>(fileContext, iterations);
+  divisionMeasureType<float>(fileContext, iterations);
+  divisionMeasureType<double>(fileContext, iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKDIVISION_HPP_
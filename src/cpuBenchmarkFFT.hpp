@@ -0,0 +1,441 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the roofline family for working sets.
+
+#ifndef _CPUBENCHMARKFFT_HPP_
+#define _CPUBENCHMARKFFT_HPP_
+
+#include <complex>
+
+#define FFT_FLOPS_PER_MEASUREMENT (1ULL << 30) // Passes are repeated up to this many nominal operations
+#define FFT_SIZE_MIN 64 // Smallest transform, also used when a level is smaller
+#define FFT_BATCH_BYTES_MAX (2ULL << 30) // Thread counts whose batch exceeds this are skipped
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum fftAlgorithm_e {
+  fa_radix2_e = 0, // Iterative Cooley-Tukey, bit reversed copy then in place butterflies, powers of two only
+  fa_mixedRadix_e = 1, // Recursive decimation in time over factors 4, 2, 3, 5 and any remaining primes
+  fa_count_e = 2
+} fftAlgorithm_et;
+
+typedef enum fftSize_e {
+  fz_powerOfTwo_e = 0, // Largest power of two in the working set
+  fz_composite_e = 1, // Largest 15 * 2^k in the working set, mixed radix only
+  fz_count_e = 2
+} fftSize_et;
+
+template<class classType>
+struct fftPlan {
+  size_t length; // Transform length
+  size_t radixMax; // Largest factor, size of the butterfly scratch
+  std::vector<size_t> factors; // Pairs of radix and remaining length, outermost first
+  std::vector<std::complex<classType>> twiddles; // exp(-2 pi i k / length)
+};
+
+// Thread arguments are written by the owning thread, so they are padded.
+typedef struct alignas(CACHE_LINE_SIZE) fftThread {
+  fftAlgorithm_et algorithm; // Transform under test
+  const void *plan; // Shared read only fftPlan of the element type
+  size_t passes; // Transforms per thread
+  pthread_barrier_t *startBarrier; // Releases all threads at once
+  double timeStart; // Right after the start barrier
+  double timeStop; // After the last pass
+  double roundTripError; // Max |x - ifft(fft(x))| / max |x| of the thread's data
+  bool isValid; // Buffers were allocated
+} fftThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *fftAlgorithmName(fftAlgorithm_et algorithm);
+
+template<class classType>
+void fftPlanCreate(fftPlan<classType> &plan, size_t length);
+
+template<class classType>
+void fftRadix2(const fftPlan<classType> &plan, const std::complex<classType> *in, std::complex<classType> *out);
+
+template<class classType>
+void fftMixedRadixWork(const fftPlan<classType> &plan, std::complex<classType> *out, const std::complex<classType> *in,
+                       size_t inStride, const size_t *factors, std::complex<classType> *scratch);
+
+template<class classType>
+void fftTransform(fftAlgorithm_et algorithm, const fftPlan<classType> &plan, const std::complex<classType> *in,
+                  std::complex<classType> *out, std::complex<classType> *scratch);
+
+template<class classType>
+void *fft_Pthread(void *inArgs);
+
+template<class classType>
+void fftMeasureType(FILE *fileContext, size_t threadMax, size_t passesOption);
+
+int testharness_FFT(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the algorithm.
+*****************************************************************************/
+const char *fftAlgorithmName(fftAlgorithm_et algorithm) {
+  const char *algorithmName;
+  switch (algorithm) {
+    case fa_radix2_e:
+      algorithmName = "radix2";
+      break;
+    case fa_mixedRadix_e:
+      algorithmName = "mixed_radix";
+      break;
+    default:
+      algorithmName = "unknown";
+      break;
+  }
+  return algorithmName;
+}
+
+/******************************************************************************
+* Factors the length and fills the twiddles in long double.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void fftPlanCreate(fftPlan<classType> &plan, size_t length) {
+  const long double twoPi = 2.0L * acosl(-1.0L);
+  size_t remaining = length;
+  size_t radix = 4;
+
+  plan.length = length;
+  plan.radixMax = 1;
+  plan.factors.clear();
+  while (remaining > 1) {
+    while (0 != (remaining % radix)) {
+      switch (radix) {
+        case 4:
+          radix = 2;
+          break;
+        case 2:
+          radix = 3;
+          break;
+        default:
+          radix += 2;
+          break;
+      }
+      if ((radix * radix) > remaining) {
+        radix = remaining;
+      }
+    }
+    remaining /= radix;
+    plan.factors.push_back(radix);
+    plan.factors.push_back(remaining);
+    plan.radixMax = std::max(plan.radixMax, radix);
+  }
+  plan.twiddles.resize(length);
+  for (size_t index = 0; index < length; index++) {
+    plan.twiddles[index] = std::complex<classType>((classType) cosl(-twoPi * (long double) index / (long double) length),
+                                                   (classType) sinl(-twoPi * (long double) index / (long double) length));
+  }
+  return;
+}
+
+/******************************************************************************
+* Radix-2 transform of a power of two length.
+* @return  None
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+void fftRadix2(const fftPlan<classType> &plan, const std::complex<classType> *in, std::complex<classType> *out) {
+  const size_t length = plan.length;
+  const std::complex<classType> *twiddles = plan.twiddles.data();
+  std::complex<classType> even, odd;
+  size_t reversed = 0, bit, twiddleStep, half;
+
+  for (size_t index = 0; index < length; index++) {
+    out[reversed] = in[index];
+    // Increment the bit reversed counter from the top bit down.
+    for (bit = length >> 1; (0 != bit) && (0 != (reversed & bit)); bit >>= 1) {
+      reversed ^= bit;
+    }
+    reversed |= bit;
+  }
+  for (size_t span = 2; span <= length; span <<= 1) {
+    half = span >> 1;
+    twiddleStep = length / span;
+    for (size_t block = 0; block < length; block += span) {
+      for (size_t index = 0; index < half; index++) {
+        even = out[block + index];
+        odd = out[block + index + half] * twiddles[index * twiddleStep];
+        out[block + index] = even + odd;
+        out[block + index + half] = even - odd;
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* One level of the mixed radix recursion: the radix sub-transforms of length
+* remaining are computed from every radix-th input, then combined with a
+* generic radix point butterfly.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void fftMixedRadixWork(const fftPlan<classType> &plan, std::complex<classType> *out, const std::complex<classType> *in,
+                       size_t inStride, const size_t *factors, std::complex<classType> *scratch) {
+  const size_t radix = factors[0];
+  const size_t remaining = factors[1];
+  const size_t twiddleStride = inStride;
+  const std::complex<classType> *twiddles = plan.twiddles.data();
+  size_t outIndex, twiddleIndex;
+
+  if (1 == remaining) {
+    for (size_t index = 0; index < radix; index++) {
+      out[index] = in[index * inStride];
+    }
+  } else {
+    for (size_t index = 0; index < radix; index++) {
+      fftMixedRadixWork<classType>(plan, out + index * remaining, in + index * inStride, inStride * radix,
+                                   factors + 2, scratch);
+    }
+  }
+  for (size_t offset = 0; offset < remaining; offset++) {
+    for (size_t index = 0; index < radix; index++) {
+      scratch[index] = out[offset + index * remaining];
+    }
+    for (size_t index = 0; index < radix; index++) {
+      outIndex = offset + index * remaining;
+      twiddleIndex = 0;
+      out[outIndex] = scratch[0];
+      for (size_t term = 1; term < radix; term++) {
+        twiddleIndex += twiddleStride * outIndex;
+        if (twiddleIndex >= plan.length) {
+          twiddleIndex -= plan.length;
+        }
+        out[outIndex] += scratch[term] * twiddles[twiddleIndex];
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Forward transform of in to out; scratch holds plan.radixMax elements.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void fftTransform(fftAlgorithm_et algorithm, const fftPlan<classType> &plan, const std::complex<classType> *in,
+                  std::complex<classType> *out, std::complex<classType> *scratch) {
+  if (fa_radix2_e == algorithm) {
+    fftRadix2<classType>(plan, in, out);
+  } else {
+    fftMixedRadixWork<classType>(plan, out, in, 1, plan.factors.data(), scratch);
+  }
+  return;
+}
+
+/******************************************************************************
+* Transforms the thread's own buffers, so the batch scales with the team.
+* The round trip uses ifft(x) = conj(fft(conj(x))) / length.
+* @return  the thread arguments.
+*****************************************************************************/
+template<class classType>
+void *fft_Pthread(void *inArgs) {
+  fftThread_t *threadInfo = (fftThread_t *) inArgs;
+  const fftPlan<classType> &plan = *(const fftPlan<classType> *) threadInfo->plan;
+  const size_t length = plan.length;
+  std::complex<classType> *in, *out;
+  std::vector<std::complex<classType>> scratch(plan.radixMax);
+  double difference = 0.0, magnitude = 0.0;
+  uint64_t randomState = (uint64_t) (uintptr_t) inArgs | 1;
+
+  in = (std::complex<classType> *) aligned_alloc(CACHE_LINE_SIZE, length * sizeof(std::complex<classType>));
+  out = (std::complex<classType> *) aligned_alloc(CACHE_LINE_SIZE, length * sizeof(std::complex<classType>));
+  threadInfo->isValid = (NULL != in) && (NULL != out);
+  if (threadInfo->isValid) {
+    // gauss_rand is not thread safe, each thread draws from its own xorshift in [-0.5, 0.5).
+    for (size_t index = 0; index < length; index++) {
+      randomState ^= randomState << 13;
+      randomState ^= randomState >> 7;
+      randomState ^= randomState << 17;
+      in[index] = std::complex<classType>((classType) ((double) (randomState >> 40) / (double) (1ULL << 24) - 0.5),
+                                          (classType) ((double) (randomState & 0xFFFFFF) / (double) (1ULL << 24) - 0.5));
+      out[index] = 0;
+    }
+  }
+  pthread_barrier_wait(threadInfo->startBarrier);
+  if (threadInfo->isValid) {
+    threadInfo->timeStart = getTime();
+    for (size_t pass = 0; pass < threadInfo->passes; pass++) {
+      fftTransform<classType>(threadInfo->algorithm, plan, in, out, scratch.data());
+    }
+    threadInfo->timeStop = getTime();
+
+    for (size_t index = 0; index < length; index++) {
+      out[index] = std::conj(out[index]);
+    }
+    // The input is kept for the comparison, the inverse lands in the scratch buffer of the round trip.
+    std::vector<std::complex<classType>> inverse(length);
+    fftTransform<classType>(threadInfo->algorithm, plan, out, inverse.data(), scratch.data());
+    for (size_t index = 0; index < length; index++) {
+      difference = std::max(difference,
+                            (double) std::abs(std::conj(inverse[index]) / (classType) length - in[index]));
+      magnitude = std::max(magnitude, (double) std::abs(in[index]));
+    }
+    threadInfo->roundTripError = (magnitude > 0.0) ? (difference / magnitude) : difference;
+  }
+  free(in);
+  free(out);
+  return inArgs;
+}
+
+/******************************************************************************
+* Both algorithms on every working set level and thread count, powers of two
+* for both and 15 * 2^k lengths for the mixed radix transform.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void fftMeasureType(FILE *fileContext, size_t threadMax, size_t passesOption) {
+  size_t workingSetLevel[rl_count_e];
+  size_t length, lengthLimit, passes, lengthLast[fz_count_e] = {0, 0};
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  char factorsBuffer[CHAR_BUFFER_SIZE];
+  char radix2Buffer[CHAR_BUFFER_SIZE];
+  fftPlan<classType> plan;
+  double operations, timeStart, timeStop, timeDelta, roundTripError;
+  pthread_barrier_t startBarrier;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  bool isValid;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  rooflineWorkingSetSelect(workingSetLevel);
+  for (size_t level = 0; level < rl_count_e; level++) {
+    if (0 == workingSetLevel[level]) {
+      continue;
+    }
+    // Input and output buffers of the transform.
+    lengthLimit = std::max((size_t) FFT_SIZE_MIN, workingSetLevel[level] / (2 * sizeof(std::complex<classType>)));
+    for (size_t sizeKind = 0; sizeKind < fz_count_e; sizeKind++) {
+      length = (fz_composite_e == sizeKind) ? 15 : 1;
+      while ((2 * length) <= lengthLimit) {
+        length *= 2;
+      }
+      if ((length == lengthLast[sizeKind]) || (length < FFT_SIZE_MIN)) {
+        continue;
+      }
+      lengthLast[sizeKind] = length;
+      fftPlanCreate<classType>(plan, length);
+      factorsBuffer[0] = '\0';
+      for (size_t factor = 0; factor < plan.factors.size(); factor += 2) {
+        snprintf(factorsBuffer + strlen(factorsBuffer), CHAR_BUFFER_SIZE - strlen(factorsBuffer), "%s%zu",
+                 (0 == factor) ? "" : "x", plan.factors[factor]);
+      }
+      snprintf(radix2Buffer, CHAR_BUFFER_SIZE, "2^%d", (int) std::log2((double) length));
+      operations = 5.0 * (double) length * std::log2((double) length);
+      passes = (passesOption > 0) ? passesOption
+                                  : std::max((size_t) 1, (size_t) (FFT_FLOPS_PER_MEASUREMENT / operations));
+
+      for (size_t threadCount = 1; threadCount <= threadMax;) {
+        if ((threadCount * 2 * length * sizeof(std::complex<classType>)) > FFT_BATCH_BYTES_MAX) {
+          printf("Skipping %zu threads of length %zu, the batch exceeds %llu bytes.\n", threadCount, length,
+                 (unsigned long long) FFT_BATCH_BYTES_MAX);
+          break;
+        }
+        for (size_t algorithm = 0; algorithm < fa_count_e; algorithm++) {
+          if ((fa_radix2_e == algorithm) && (fz_composite_e == sizeKind)) {
+            continue;
+          }
+          std::vector<fftThread_t> threadInfo(threadCount);
+          std::vector<void *> threadArgs(threadCount);
+          pthread_barrier_init(&startBarrier, NULL, threadCount);
+          for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+            threadInfo[threadIndex].algorithm = (fftAlgorithm_et) algorithm;
+            threadInfo[threadIndex].plan = &plan;
+            threadInfo[threadIndex].passes = passes;
+            threadInfo[threadIndex].startBarrier = &startBarrier;
+            threadInfo[threadIndex].timeStart = 0.0;
+            threadInfo[threadIndex].timeStop = 0.0;
+            threadInfo[threadIndex].roundTripError = 0.0;
+            threadInfo[threadIndex].isValid = false;
+            threadArgs[threadIndex] = &threadInfo[threadIndex];
+          }
+          frequencyStart = frequencyMonitorRead(harnessMonitor);
+          isValid = threadTeamRun(fft_Pthread<classType>, threadArgs, true);
+          frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+          pthread_barrier_destroy(&startBarrier);
+          // The team time runs from the first thread leaving the barrier to the last thread finishing.
+          timeStart = threadInfo[0].timeStart;
+          timeStop = 0.0;
+          roundTripError = 0.0;
+          for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+            isValid = isValid && threadInfo[threadIndex].isValid;
+            timeStart = std::min(timeStart, threadInfo[threadIndex].timeStart);
+            timeStop = std::max(timeStop, threadInfo[threadIndex].timeStop);
+            roundTripError = std::max(roundTripError, threadInfo[threadIndex].roundTripError);
+          }
+          timeDelta = timeStop - timeStart;
+          if (!isValid) {
+            fprintf(stderr, "Error on line %d : %s.\n", __LINE__, strerror(errno));
+            continue;
+          }
+          resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %s, %zu, %s, %zu, %zu, %f, %f, %f, %e",
+                         fftAlgorithmName((fftAlgorithm_et) algorithm), typeNameBuffer, length,
+                         (fa_radix2_e == algorithm) ? radix2Buffer : factorsBuffer,
+                         2 * length * sizeof(std::complex<classType>), rooflineLevelName((rooflineLevel_et) level),
+                         threadCount, passes, timeDelta,
+                         (timeDelta > 0.0) ? ((timeDelta * 1e9) / (double) passes) : 0.0,
+                         (timeDelta > 0.0) ? ((operations * (double) passes * (double) threadCount) / timeDelta / 1e9)
+                                           : 0.0,
+                         roundTripError);
+        }
+        if ((threadCount < threadMax) && ((2 * threadCount) > threadMax)) {
+          threadCount = threadMax;
+        } else {
+          threadCount *= 2;
+        }
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures radix-2 and mixed radix complex transforms with working sets from
+* L1 to DRAM, single threaded and as a batch of one transform per thread.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_FFT(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Algorithm, Type System, Length, Factors, Working Set Bytes per Thread, Memory Level, "
+                            "Threads, Passes, Time for Operations, Nanoseconds per Transform, GFLOP per Second, "
+                            "Round Trip Relative Error";
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("GFLOP per second counts the nominal 5 N log2(N) operations of every transform of the batch.\n");
+  fileContext = resultFileOpen("FFT", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  fftMeasureType<float>(fileContext, threadMax, options.iterations);
+  fftMeasureType<double>(fileContext, threadMax, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKFFT_HPP_
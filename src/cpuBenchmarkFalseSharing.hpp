@@ -0,0 +1,221 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKFALSESHARING_HPP_
+#define _CPUBENCHMARKFALSESHARING_HPP_
+
+#define FALSE_SHARING_ITERATIONS_DEFAULT (1 << 26)
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum falseSharingLayout_e {
+  fsl_packed_e = 0, // Counters back to back, several threads share one cache line
+  fsl_padded_e = 1, // One counter per cache line
+  fsl_threadLocal_e = 2, // Counter on the thread stack, published once at the end
+  fsl_count_e = 3
+} falseSharingLayout_et;
+
+typedef struct falseSharingPacked {
+  volatile uint64_t counter;
+} falseSharingPacked_t;
+
+typedef struct alignas(CACHE_LINE_SIZE) falseSharingPadded {
+  volatile uint64_t counter;
+} falseSharingPadded_t;
+
+// Thread arguments are written by the owning thread, so they are padded as well.
+typedef struct alignas(CACHE_LINE_SIZE) falseSharingThread {
+  falseSharingLayout_et layout; // Counter layout under test
+  size_t threadIndex; // Index into the counter arrays
+  size_t iterations; // Counter updates per thread
+  falseSharingPacked_t *packedCounters; // Shared packed counters
+  falseSharingPadded_t *paddedCounters; // Shared padded counters
+  uint64_t *threadLocalResults; // Published thread local counts
+  pthread_barrier_t *startBarrier; // Releases all threads at once
+  double timeDelta; // Time for the update loop
+} falseSharingThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *falseSharingLayoutName(falseSharingLayout_et layout);
+
+void *falseSharing_Pthread(void *inArgs);
+
+double falseSharingMeasure(falseSharingLayout_et layout, size_t threadCount, size_t iterations);
+
+int testharness_FalseSharing(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the counter layout.
+*****************************************************************************/
+const char *falseSharingLayoutName(falseSharingLayout_et layout) {
+  const char *layoutName;
+  switch (layout) {
+    case fsl_packed_e:
+      layoutName = "packed";
+      break;
+    case fsl_padded_e:
+      layoutName = "padded";
+      break;
+    case fsl_threadLocal_e:
+      layoutName = "thread_local";
+      break;
+    default:
+      layoutName = "unknown";
+      break;
+  }
+  return layoutName;
+}
+
+/******************************************************************************
+* Increments the counter owned by this thread in the selected layout.
+* @return  the thread arguments.
+*****************************************************************************/
+void *falseSharing_Pthread(void *inArgs) {
+  falseSharingThread_t *threadInfo = (falseSharingThread_t *) inArgs;
+  volatile uint64_t localCounter = 0;
+  size_t iterations = threadInfo->iterations;
+  size_t threadIndex = threadInfo->threadIndex;
+  double timeStart, timeStop;
+
+  pthread_barrier_wait(threadInfo->startBarrier);
+  timeStart = getTime();
+  switch (threadInfo->layout) {
+    case fsl_packed_e:
+      for (size_t index = 0; index < iterations; index++) {
+        threadInfo->packedCounters[threadIndex].counter++;
+      }
+      break;
+    case fsl_padded_e:
+      for (size_t index = 0; index < iterations; index++) {
+        threadInfo->paddedCounters[threadIndex].counter++;
+      }
+      break;
+    case fsl_threadLocal_e:
+      for (size_t index = 0; index < iterations; index++) {
+        localCounter++;
+      }
+      threadInfo->threadLocalResults[threadIndex] = localCounter;
+      break;
+    default:
+      asserterrorthread(threadIndex);
+      break;
+  }
+  timeStop = getTime();
+  threadInfo->timeDelta = timeStop - timeStart;
+  return inArgs;
+}
+
+/******************************************************************************
+* Runs one layout with the given thread count.
+* @return  wall time of the slowest thread, negative on failure.
+*****************************************************************************/
+double falseSharingMeasure(falseSharingLayout_et layout, size_t threadCount, size_t iterations) {
+  std::vector<falseSharingPacked_t> packedCounters(threadCount);
+  std::vector<falseSharingPadded_t> paddedCounters(threadCount);
+  std::vector<uint64_t> threadLocalResults(threadCount, 0);
+  std::vector<falseSharingThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  pthread_barrier_t startBarrier;
+  double timeDelta = 0.0;
+  bool isValid;
+
+  pthread_barrier_init(&startBarrier, NULL, threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    packedCounters[threadIndex].counter = 0;
+    paddedCounters[threadIndex].counter = 0;
+    threadInfo[threadIndex].layout = layout;
+    threadInfo[threadIndex].threadIndex = threadIndex;
+    threadInfo[threadIndex].iterations = iterations;
+    threadInfo[threadIndex].packedCounters = packedCounters.data();
+    threadInfo[threadIndex].paddedCounters = paddedCounters.data();
+    threadInfo[threadIndex].threadLocalResults = threadLocalResults.data();
+    threadInfo[threadIndex].startBarrier = &startBarrier;
+    threadInfo[threadIndex].timeDelta = 0.0;
+    threadArgs[threadIndex] = &threadInfo[threadIndex];
+  }
+  isValid = threadTeamRun(falseSharing_Pthread, threadArgs, true);
+  pthread_barrier_destroy(&startBarrier);
+
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    timeDelta = std::max(timeDelta, threadInfo[threadIndex].timeDelta);
+  }
+  return isValid ? timeDelta : -1.0;
+}
+
+/******************************************************************************
+* Measures per-thread counter updates in packed, padded and thread local
+* layouts for thread counts doubling up to the selected thread count.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_FalseSharing(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Layout, Threads, Updates per Thread, Time for Operations, "
+                            "Nanoseconds per Update, Updates per Second, Slowdown vs Thread Local";
+  size_t iterations = (options.iterations > 0) ? options.iterations : FALSE_SHARING_ITERATIONS_DEFAULT;
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency[fsl_count_e];
+  double timeDelta[fsl_count_e];
+  double updatesTotal;
+  bool isValid = true;
+  FILE *fileContext;
+
+  printf("Cache line size used for padding is %zu bytes, sizeof(threadContextMeta_t) is %zu.\n",
+         (size_t) CACHE_LINE_SIZE, sizeof(threadContextMeta_t));
+  fileContext = resultFileOpen("FalseSharing", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  // Warm up thread creation and frequency before the first measured row.
+  falseSharingMeasure(fsl_threadLocal_e, 1, iterations);
+
+  for (size_t threadCount = 1; threadCount <= threadMax;) {
+    for (size_t layout = 0; layout < fsl_count_e; layout++) {
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timeDelta[layout] = falseSharingMeasure((falseSharingLayout_et) layout, threadCount, iterations);
+      frequency[layout] = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      isValid = isValid && (timeDelta[layout] >= 0.0);
+    }
+    for (size_t layout = 0; layout < fsl_count_e; layout++) {
+      updatesTotal = (double) iterations * (double) threadCount;
+      resultPrintRow(fileContext, true, &frequency[layout], "%s, %zu, %zu, %f, %f, %f, %f",
+                     falseSharingLayoutName((falseSharingLayout_et) layout), threadCount, iterations,
+                     timeDelta[layout],
+                     (timeDelta[layout] * 1e9) / (double) iterations,
+                     (timeDelta[layout] > 0.0) ? (updatesTotal / timeDelta[layout]) : 0.0,
+                     (timeDelta[fsl_threadLocal_e] > 0.0) ? (timeDelta[layout] / timeDelta[fsl_threadLocal_e]) : 0.0);
+    }
+    // Double the thread count, always finishing on the selected maximum.
+    if (threadCount == threadMax) {
+      break;
+    }
+    threadCount = std::min(threadCount * 2, threadMax);
+  }
+
+  resultFileClose(fileContext, fileNameAbsolute);
+  return isValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // _CPUBENCHMARKFALSESHARING_HPP_
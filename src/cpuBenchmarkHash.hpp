@@ -0,0 +1,362 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the sort family for keys.
+
+#ifndef _CPUBENCHMARKHASH_HPP_
+#define _CPUBENCHMARKHASH_HPP_
+
+#include <unordered_map>
+
+#define HASH_ELEMENTS_MIN (1 << 10) // Default sweep of inserted keys, grows by HASH_ELEMENTS_STEP ...
+#define HASH_ELEMENTS_MAX (1 << 22) // ... up to this many, -n selects a single count
+#define HASH_ELEMENTS_STEP 4
+#define HASH_QUERIES (1 << 20) // Lookups per measurement, half are inserted keys
+#define HASH_CHAIN_END UINT32_MAX // Empty bucket and end of a chain
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum hashAlgorithm_e {
+  ha_openAddressing_e = 0, // Linear probing, load factor at most 0.5
+  ha_chaining_e = 1, // Bucket heads into a node pool, load factor at most 1
+  ha_stdUnordered_e = 2, // std::unordered_map, node based chaining
+  ha_count_e = 3
+} hashAlgorithm_et;
+
+template<class classType>
+struct hashOpen {
+  size_t mask; // Slots minus one, slots are a power of two
+  std::vector<classType> keys;
+  std::vector<uint32_t> values;
+  std::vector<uint8_t> occupied; // Any key value is legal, so occupancy is kept apart
+};
+
+template<class classType>
+struct hashChain {
+  size_t mask; // Buckets minus one, buckets are a power of two
+  std::vector<uint32_t> heads; // First node of every bucket
+  std::vector<classType> keys; // Node pool
+  std::vector<uint32_t> values;
+  std::vector<uint32_t> next;
+};
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *hashAlgorithmName(hashAlgorithm_et algorithm);
+
+template<class classType>
+uint64_t hashKey(classType key);
+
+template<class classType>
+void hashOpenInsert(hashOpen<classType> &table, classType key, uint32_t value);
+
+template<class classType>
+bool hashOpenFind(const hashOpen<classType> &table, classType key, uint32_t &value);
+
+template<class classType>
+void hashChainInsert(hashChain<classType> &table, classType key, uint32_t value);
+
+template<class classType>
+bool hashChainFind(const hashChain<classType> &table, classType key, uint32_t &value);
+
+template<class classType>
+void hashMeasureType(FILE *fileContext, size_t elementsOption);
+
+int testharness_Hash(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the table.
+*****************************************************************************/
+const char *hashAlgorithmName(hashAlgorithm_et algorithm) {
+  const char *algorithmName;
+  switch (algorithm) {
+    case ha_openAddressing_e:
+      algorithmName = "open_addressing";
+      break;
+    case ha_chaining_e:
+      algorithmName = "chaining";
+      break;
+    case ha_stdUnordered_e:
+      algorithmName = "std_unordered_map";
+      break;
+    default:
+      algorithmName = "unknown";
+      break;
+  }
+  return algorithmName;
+}
+
+/******************************************************************************
+* MurmurHash3 64 bit finalizer over the key bits, keys wider than 64 bits are
+* folded with exclusive or first.
+* @return  mixed hash of the key.
+*****************************************************************************/
+template<class classType>
+uint64_t hashKey(classType key) {
+  uint64_t bits = 0, word;
+
+  for (size_t offset = 0; offset < sizeof(key); offset += sizeof(word)) {
+    word = 0;
+    memcpy(&word, (const uint8_t *) &key + offset, std::min(sizeof(word), sizeof(key) - offset));
+    bits ^= word;
+  }
+  bits ^= bits >> 33;
+  bits *= 0xFF51AFD7ED558CCDULL;
+  bits ^= bits >> 33;
+  bits *= 0xC4CEB9FE1A85EC53ULL;
+  bits ^= bits >> 33;
+  return bits;
+}
+
+/******************************************************************************
+* Inserts or overwrites the key.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void hashOpenInsert(hashOpen<classType> &table, classType key, uint32_t value) {
+  size_t slot = hashKey<classType>(key) & table.mask;
+
+  while ((0 != table.occupied[slot]) && (table.keys[slot] != key)) {
+    slot = (slot + 1) & table.mask;
+  }
+  table.occupied[slot] = 1;
+  table.keys[slot] = key;
+  table.values[slot] = value;
+  return;
+}
+
+/******************************************************************************
+*
+* @return  true when the key is found, its value is returned by reference.
+*****************************************************************************/
+template<class classType>
+bool hashOpenFind(const hashOpen<classType> &table, classType key, uint32_t &value) {
+  size_t slot = hashKey<classType>(key) & table.mask;
+
+  while (0 != table.occupied[slot]) {
+    if (table.keys[slot] == key) {
+      value = table.values[slot];
+      return true;
+    }
+    slot = (slot + 1) & table.mask;
+  }
+  return false;
+}
+
+/******************************************************************************
+* Inserts or overwrites the key, new keys go to the head of the chain.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void hashChainInsert(hashChain<classType> &table, classType key, uint32_t value) {
+  size_t bucket = hashKey<classType>(key) & table.mask;
+
+  for (uint32_t node = table.heads[bucket]; HASH_CHAIN_END != node; node = table.next[node]) {
+    if (table.keys[node] == key) {
+      table.values[node] = value;
+      return;
+    }
+  }
+  table.keys.push_back(key);
+  table.values.push_back(value);
+  table.next.push_back(table.heads[bucket]);
+  table.heads[bucket] = (uint32_t) (table.keys.size() - 1);
+  return;
+}
+
+/******************************************************************************
+*
+* @return  true when the key is found, its value is returned by reference.
+*****************************************************************************/
+template<class classType>
+bool hashChainFind(const hashChain<classType> &table, classType key, uint32_t &value) {
+  size_t bucket = hashKey<classType>(key) & table.mask;
+
+  for (uint32_t node = table.heads[bucket]; HASH_CHAIN_END != node; node = table.next[node]) {
+    if (table.keys[node] == key) {
+      value = table.values[node];
+      return true;
+    }
+  }
+  return false;
+}
+
+/******************************************************************************
+* Inserts the keys into an empty table, then looks up the queries, for every
+* table of one type over the key counts. Table memory is reserved before the
+* inserts are timed.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void hashMeasureType(FILE *fileContext, size_t elementsOption) {
+  size_t elementsFirst = (elementsOption > 0) ? elementsOption : HASH_ELEMENTS_MIN;
+  size_t elementsLast = (elementsOption > 0) ? elementsOption : HASH_ELEMENTS_MAX;
+  std::vector<classType> keys, queries(HASH_QUERIES);
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  hashOpen<classType> openTable;
+  hashChain<classType> chainTable;
+  std::unordered_map<classType, uint32_t> stdTable;
+  size_t slots, hits, hitsReference = 0, tableBytes;
+  uint64_t valueSum, valueSumReference = 0;
+  uint32_t value;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double timeStart, insertTime, lookupTime;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  for (size_t elements = elementsFirst; elements <= elementsLast; elements *= HASH_ELEMENTS_STEP) {
+    keys.resize(elements);
+    sortKeyFill<classType>(keys);
+    sortKeyFill<classType>(queries);
+    for (size_t query = 0; query < HASH_QUERIES; query += 2) {
+      queries[query] = keys[(size_t) (gauss_rand<double>(1) * (double) (elements - 1))];
+    }
+    slots = 1;
+    while (slots < elements) {
+      slots *= 2;
+    }
+    for (size_t algorithm = 0; algorithm < ha_count_e; algorithm++) {
+      hits = 0;
+      valueSum = 0;
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      switch (algorithm) {
+        case ha_chaining_e:
+          chainTable.mask = slots - 1;
+          chainTable.heads.assign(slots, HASH_CHAIN_END);
+          chainTable.keys.clear();
+          chainTable.values.clear();
+          chainTable.next.clear();
+          chainTable.keys.reserve(elements);
+          chainTable.values.reserve(elements);
+          chainTable.next.reserve(elements);
+          timeStart = getTime();
+          for (size_t index = 0; index < elements; index++) {
+            hashChainInsert<classType>(chainTable, keys[index], (uint32_t) index);
+          }
+          insertTime = getTime() - timeStart;
+          timeStart = getTime();
+          for (size_t query = 0; query < HASH_QUERIES; query++) {
+            if (hashChainFind<classType>(chainTable, queries[query], value)) {
+              hits++;
+              valueSum += value;
+            }
+          }
+          lookupTime = getTime() - timeStart;
+          tableBytes = slots * sizeof(uint32_t) + chainTable.keys.size() * (sizeof(classType) + 2 * sizeof(uint32_t));
+          break;
+        case ha_stdUnordered_e:
+          stdTable.clear();
+          stdTable.reserve(elements);
+          timeStart = getTime();
+          for (size_t index = 0; index < elements; index++) {
+            stdTable[keys[index]] = (uint32_t) index;
+          }
+          insertTime = getTime() - timeStart;
+          timeStart = getTime();
+          for (size_t query = 0; query < HASH_QUERIES; query++) {
+            auto found = stdTable.find(queries[query]);
+            if (stdTable.end() != found) {
+              hits++;
+              valueSum += found->second;
+            }
+          }
+          lookupTime = getTime() - timeStart;
+          // Bucket array plus one node of key, value and next pointer per entry, allocator overhead excluded.
+          tableBytes = stdTable.bucket_count() * sizeof(void *) +
+                       stdTable.size() * (sizeof(void *) + sizeof(std::pair<classType, uint32_t>));
+          break;
+        case ha_openAddressing_e:
+        default:
+          openTable.mask = 2 * slots - 1;
+          openTable.keys.assign(2 * slots, (classType) 0);
+          openTable.values.assign(2 * slots, 0);
+          openTable.occupied.assign(2 * slots, 0);
+          timeStart = getTime();
+          for (size_t index = 0; index < elements; index++) {
+            hashOpenInsert<classType>(openTable, keys[index], (uint32_t) index);
+          }
+          insertTime = getTime() - timeStart;
+          timeStart = getTime();
+          for (size_t query = 0; query < HASH_QUERIES; query++) {
+            if (hashOpenFind<classType>(openTable, queries[query], value)) {
+              hits++;
+              valueSum += value;
+            }
+          }
+          lookupTime = getTime() - timeStart;
+          tableBytes = 2 * slots * (sizeof(classType) + sizeof(uint32_t) + sizeof(uint8_t));
+          break;
+      }
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      if (ha_openAddressing_e == algorithm) {
+        hitsReference = hits;
+        valueSumReference = valueSum;
+      }
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %d, %f, %f, %f, %f, %zu, %lu, %d",
+                     hashAlgorithmName((hashAlgorithm_et) algorithm), typeNameBuffer, elements, tableBytes,
+                     HASH_QUERIES, (insertTime * 1e9) / (double) elements,
+                     (insertTime > 0.0) ? ((double) elements / insertTime / 1e6) : 0.0,
+                     (lookupTime * 1e9) / (double) HASH_QUERIES,
+                     (lookupTime > 0.0) ? ((double) HASH_QUERIES / lookupTime / 1e6) : 0.0, hits, valueSum,
+                     ((hits == hitsReference) && (valueSum == valueSumReference)) ? 1 : 0);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Inserts random keys of every integer width and both floating types into
+* open addressing, chaining and std::unordered_map tables and looks up keys
+* of which half are present.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Hash(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Algorithm, Type System, Keys Inserted, Table Bytes, Queries, Nanoseconds per Insert, "
+                            "Million Inserts per Second, Nanoseconds per Lookup, Million Lookups per Second, Hits, "
+                            "Value Sum, Matches Open Addressing";
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Narrow key types repeat keys, their inserts mostly overwrite.\n");
+  fileContext = resultFileOpen("Hash", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  hashMeasureType<int8_t>(fileContext, options.iterations);
+  hashMeasureType<uint8_t>(fileContext, options.iterations);
+  hashMeasureType<int16_t>(fileContext, options.iterations);
+  hashMeasureType<uint16_t>(fileContext, options.iterations);
+  hashMeasureType<int32_t>(fileContext, options.iterations);
+  hashMeasureType<uint32_t>(fileContext, options.iterations);
+  hashMeasureType<int64_t>(fileContext, options.iterations);
+  hashMeasureType<uint64_t>(fileContext, options.iterations);
+#if TYPELESS_INT128_ENABLE
+  hashMeasureType<typelessInt128_t>(fileContext, options.iterations);
+  hashMeasureType<typelessUInt128_t>(fileContext, options.iterations);
+#endif // TYPELESS_INT128_ENABLE
+  hashMeasureType<float>(fileContext, options.iterations);
+  hashMeasureType<double>(fileContext, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKHASH_HPP_
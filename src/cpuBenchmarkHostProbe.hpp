@@ -0,0 +1,456 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, fileCreate writes the metadata block.
+
+#ifndef _CPUBENCHMARKHOSTPROBE_HPP_
+#define _CPUBENCHMARKHOSTPROBE_HPP_
+
+#include <ctime>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <sys/utsname.h>
+#endif // defined(__linux__)
+
+#if defined(__x86_64__) | defined(__i386__)
+#include <cpuid.h>
+#endif // defined(__x86_64__) | defined(__i386__)
+
+#ifndef BUILD_FLAGS
+#define BUILD_FLAGS "unknown" // Compile flags, passed by the Makefile
+#endif // BUILD_FLAGS
+
+#ifndef GIT_REVISION
+#define GIT_REVISION "unknown" // Source revision, passed by the Makefile
+#endif // GIT_REVISION
+
+#define HOST_FIELD_SIZE 256 // Longest kept value of a probed field
+#define HOST_VULNERABILITIES_MAX 48 // Entries of /sys/devices/system/cpu/vulnerabilities kept
+#define HOST_METADATA_PREFIX "# " // Starts every metadata line, readers of result files skip these lines
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef struct hostVulnerability {
+  char name[HOST_FIELD_SIZE / 4]; // File name, such as spectre_v2
+  char state[HOST_FIELD_SIZE]; // Kernel mitigation state
+} hostVulnerability_t;
+
+// Everything that makes numbers of two hosts comparable or not, probed once per run.
+typedef struct hostProbe {
+  bool isProbed;
+  uint64_t fingerprint; // Hash of the hardware identity fields, see hostProbeFingerprint
+  char vendor[HOST_FIELD_SIZE / 4]; // cpuid vendor or cpuinfo vendor_id
+  char brand[HOST_FIELD_SIZE / 2]; // cpuid brand string or cpuinfo model name
+  uint32_t family; // cpuid display family
+  uint32_t model; // cpuid display model
+  uint32_t stepping;
+  char microcode[HOST_FIELD_SIZE / 4];
+  double cpuMegahertz; // cpu MHz of /proc/cpuinfo when probed
+  char isaRuntime[HOST_FIELD_SIZE]; // Extensions the processor reports, the families dispatch on these
+  char isaCompiled[HOST_FIELD_SIZE]; // Extensions the binary was compiled for
+  size_t cacheBytes[3]; // Level 1 data, level 2 and level 3
+  uint32_t onlineCores;
+  char smtControl[HOST_FIELD_SIZE / 4]; // on, off, forceoff, notsupported
+  char smtActive[HOST_FIELD_SIZE / 4];
+  char scalingDriver[HOST_FIELD_SIZE / 4];
+  char governor[HOST_FIELD_SIZE / 4];
+  char turbo[HOST_FIELD_SIZE / 4]; // enabled, disabled or unknown
+  char kernel[HOST_FIELD_SIZE];
+  char hostName[HOST_FIELD_SIZE / 2];
+  size_t vulnerabilityCount;
+  hostVulnerability_t vulnerabilities[HOST_VULNERABILITIES_MAX]; // Sorted by name
+} hostProbe_t;
+
+// Probed by main before any family runs, getCPUFrequency and fileCreate read it.
+hostProbe_t harnessHost = {};
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+bool hostProbeReadLine(const char *fileName, char *value, size_t valueSize);
+
+bool hostProbeCpuInfoField(const char *key, char *value, size_t valueSize);
+
+void hostProbeAppend(char *list, size_t listSize, const char *name);
+
+int hostProbeVulnerabilityCompare(const void *left, const void *right);
+
+uint64_t hostProbeFingerprint(const hostProbe_t &host);
+
+void hostProbeRun(hostProbe_t &host);
+
+void hostProbeWriteMetadata(FILE *fileContext);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+* Reads the first line of a small text file such as a sysfs attribute.
+* @return  true when a line was read, value holds it without the newline.
+*****************************************************************************/
+bool hostProbeReadLine(const char *fileName, char *value, size_t valueSize) {
+  bool isRead = false;
+  FILE *fileContext;
+
+  value[0] = '\0';
+  fileContext = fopen(fileName, "r");
+  if (NULL != fileContext) {
+    isRead = (NULL != fgets(value, (int) valueSize, fileContext));
+    fclose(fileContext);
+  }
+  value[strcspn(value, "\n")] = '\0';
+  return isRead;
+}
+
+/* Processor Specific Model Notes:
+ $ lscpu | grep MHz
+ CPU MHz:                         3200.011
+ CPU max MHz:                     3500.0000
+ CPU min MHz:                     1200.0000
+
+ $ cat /proc/cpuinfo
+ processor	: 0
+ vendor_id	: GenuineIntel
+ cpu family	: 6
+ model		: 79
+ model name	: Intel(R) Xeon(R) CPU E5-2687W v4 @ 3.00GHz
+ stepping	: 1
+ microcode	: 0xb00003e
+ cpu MHz		: 3200.015
+ cache size	: 30720 KB
+ physical id	: 0
+ siblings	: 12
+ core id		: 0
+ cpu cores	: 12
+ apicid		: 0
+ initial apicid	: 0
+ fpu		: yes
+ fpu_exception	: yes
+ cpuid level	: 20
+ wp		: yes
+ flags		: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush dts acpi mmx fxsr sse sse2 ss ht tm pbe syscall nx pdpe1gb rdtscp lm constant_tsc arch_perfmon pebs bts rep_good nopl xtopology nonstop_tsc cpuid aperfmperf pni pclmulqdq dtes64 monitor ds_cpl vmx smx est tm2 ssse3 sdbg fma cx16 xtpr pdcm pcid dca sse4_1 sse4_2 x2apic movbe popcnt tsc_deadline_timer aes xsave avx f16c rdrand lahf_lm abm 3dnowprefetch cpuid_fault epb cat_l3 cdp_l3 invpcid_single pti intel_ppin ssbd ibrs ibpb stibp tpr_shadow vnmi flexpriority ept vpid ept_ad fsgsbase tsc_adjust bmi1 hle avx2 smep bmi2 erms invpcid rtm cqm rdt_a rdseed adx smap intel_pt xsaveopt cqm_llc cqm_occup_llc cqm_mbm_total cqm_mbm_local dtherm ida arat pln pts md_clear flush_l1d
+ bugs		: cpu_meltdown spectre_v1 spectre_v2 spec_store_bypass l1tf mds swapgs taa itlb_multihit
+ bogomips	: 6000.02
+ clflush size	: 64
+ cache_alignment	: 64
+ address sizes	: 46 bits physical, 48 bits virtual
+ power management:
+*/
+/******************************************************************************
+* Finds the first "key : value" line of /proc/cpuinfo whose key matches
+* exactly, so "model" does not match "model name".
+* @return  true when the key was found, value holds the text after the colon.
+*****************************************************************************/
+bool hostProbeCpuInfoField(const char *key, char *value, size_t valueSize) {
+  char lineBuffer[CHAR_BUFFER_SIZE * 4]; // The flags line is long, only its start is kept
+  size_t keyLength = strlen(key), fieldLength;
+  bool isFound = false;
+  char *colon;
+  FILE *cpuInfoFile;
+
+  value[0] = '\0';
+  cpuInfoFile = fopen("/proc/cpuinfo", "r");
+  if (NULL == cpuInfoFile) {
+    return false;
+  }
+  while (!isFound && (NULL != fgets(lineBuffer, sizeof(lineBuffer), cpuInfoFile))) {
+    colon = strchr(lineBuffer, ':');
+    if ((NULL == colon) || (0 != strncmp(lineBuffer, key, keyLength))) {
+      continue;
+    }
+    fieldLength = keyLength;
+    while ((lineBuffer + fieldLength < colon) && isspace((unsigned char) lineBuffer[fieldLength])) {
+      fieldLength++;
+    }
+    if (lineBuffer + fieldLength == colon) {
+      colon++;
+      while (isspace((unsigned char) *colon) && ('\n' != *colon)) {
+        colon++;
+      }
+      snprintf(value, valueSize, "%s", colon);
+      value[strcspn(value, "\n")] = '\0';
+      isFound = true;
+    }
+  }
+  fclose(cpuInfoFile);
+  return isFound;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+void hostProbeAppend(char *list, size_t listSize, const char *name) {
+  size_t length = strlen(list);
+
+  if (length < listSize) {
+    snprintf(list + length, listSize - length, "%s%s", (0 == length) ? "" : " ", name);
+  }
+  return;
+}
+
+/******************************************************************************
+*
+* @return  strcmp order of the vulnerability names.
+*****************************************************************************/
+int hostProbeVulnerabilityCompare(const void *left, const void *right) {
+  return strcmp(((const hostVulnerability_t *) left)->name, ((const hostVulnerability_t *) right)->name);
+}
+
+/******************************************************************************
+* FNV-1a over the hardware identity: processor, core count, caches and SMT.
+* Kernel, microcode, governor, turbo and build are left out so a run before
+* and after changing one of them still pairs up when compared; they are
+* written to the metadata block instead.
+* @return  the host fingerprint.
+*****************************************************************************/
+uint64_t hostProbeFingerprint(const hostProbe_t &host) {
+  char identity[CHAR_BUFFER_SIZE];
+  uint64_t hash = 14695981039346656037ULL;
+
+  snprintf(identity, sizeof(identity), "%s|%s|%u|%u|%u|%u|%zu|%zu|%zu|%s", host.vendor, host.brand, host.family,
+           host.model, host.stepping, host.onlineCores, host.cacheBytes[0], host.cacheBytes[1], host.cacheBytes[2],
+           host.smtActive);
+  for (size_t index = 0; '\0' != identity[index]; index++) {
+    hash ^= (uint8_t) identity[index];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/******************************************************************************
+* Probes the host once, later calls return at once.
+* @return  None
+*****************************************************************************/
+void hostProbeRun(hostProbe_t &host) {
+  char fieldBuffer[HOST_FIELD_SIZE];
+
+  if (host.isProbed) {
+    return;
+  }
+  memset(&host, 0, sizeof(host));
+  host.isProbed = true;
+#if defined(__x86_64__) | defined(__i386__)
+  uint32_t eax, ebx, ecx, edx;
+  uint32_t brandWords[12];
+
+  if (__get_cpuid(0, &eax, &ebx, &ecx, &edx)) {
+    memcpy(host.vendor + 0, &ebx, sizeof(ebx));
+    memcpy(host.vendor + 4, &edx, sizeof(edx));
+    memcpy(host.vendor + 8, &ecx, sizeof(ecx));
+    host.vendor[12] = '\0';
+  }
+  if (__get_cpuid(1, &eax, &ebx, &ecx, &edx)) {
+    host.stepping = eax & 0xF;
+    host.model = (eax >> 4) & 0xF;
+    host.family = (eax >> 8) & 0xF;
+    if ((6 == host.family) || (15 == host.family)) {
+      host.model += ((eax >> 16) & 0xF) << 4;
+    }
+    if (15 == host.family) {
+      host.family += (eax >> 20) & 0xFF;
+    }
+  }
+  if (__get_cpuid(0x80000000, &eax, &ebx, &ecx, &edx) && (eax >= 0x80000004)) {
+    for (uint32_t leaf = 0; leaf < 3; leaf++) {
+      __get_cpuid(0x80000002 + leaf, &brandWords[4 * leaf + 0], &brandWords[4 * leaf + 1], &brandWords[4 * leaf + 2],
+                  &brandWords[4 * leaf + 3]);
+    }
+    memcpy(host.brand, brandWords, sizeof(brandWords));
+    host.brand[sizeof(brandWords)] = '\0';
+    // Some processors right align the brand string.
+    memmove(host.brand, host.brand + strspn(host.brand, " "), strlen(host.brand + strspn(host.brand, " ")) + 1);
+  }
+
+  __builtin_cpu_init();
+#define HOST_RUNTIME_FEATURE(name) \
+  if (__builtin_cpu_supports(name)) { \
+    hostProbeAppend(host.isaRuntime, sizeof(host.isaRuntime), name); \
+  }
+  HOST_RUNTIME_FEATURE("sse2")
+  HOST_RUNTIME_FEATURE("sse3")
+  HOST_RUNTIME_FEATURE("ssse3")
+  HOST_RUNTIME_FEATURE("sse4.1")
+  HOST_RUNTIME_FEATURE("sse4.2")
+  HOST_RUNTIME_FEATURE("popcnt")
+  HOST_RUNTIME_FEATURE("pclmul")
+  HOST_RUNTIME_FEATURE("aes")
+  HOST_RUNTIME_FEATURE("avx")
+  HOST_RUNTIME_FEATURE("avx2")
+  HOST_RUNTIME_FEATURE("fma")
+  HOST_RUNTIME_FEATURE("f16c")
+  HOST_RUNTIME_FEATURE("lzcnt")
+  HOST_RUNTIME_FEATURE("bmi")
+  HOST_RUNTIME_FEATURE("bmi2")
+  HOST_RUNTIME_FEATURE("avx512f")
+  HOST_RUNTIME_FEATURE("avx512dq")
+  HOST_RUNTIME_FEATURE("avx512bw")
+  HOST_RUNTIME_FEATURE("avx512vl")
+  HOST_RUNTIME_FEATURE("avx512vnni")
+  HOST_RUNTIME_FEATURE("avx512bf16")
+  HOST_RUNTIME_FEATURE("avx512fp16")
+  HOST_RUNTIME_FEATURE("vpclmulqdq")
+  HOST_RUNTIME_FEATURE("gfni")
+  HOST_RUNTIME_FEATURE("sha")
+#undef HOST_RUNTIME_FEATURE
+#endif // defined(__x86_64__) | defined(__i386__)
+  // Other architectures, and hosts where cpuid is hidden, name the processor through cpuinfo.
+  if (('\0' == host.vendor[0]) && !hostProbeCpuInfoField("vendor_id", host.vendor, sizeof(host.vendor))) {
+    hostProbeCpuInfoField("CPU implementer", host.vendor, sizeof(host.vendor));
+  }
+  if ('\0' == host.brand[0]) {
+    hostProbeCpuInfoField("model name", host.brand, sizeof(host.brand));
+  }
+  if (('\0' == host.isaRuntime[0]) && !hostProbeCpuInfoField("flags", host.isaRuntime, sizeof(host.isaRuntime))) {
+    hostProbeCpuInfoField("Features", host.isaRuntime, sizeof(host.isaRuntime));
+  }
+  if (!hostProbeCpuInfoField("microcode", host.microcode, sizeof(host.microcode))) {
+    hostProbeReadLine("/sys/devices/system/cpu/cpu0/microcode/version", host.microcode, sizeof(host.microcode));
+  }
+  if (hostProbeCpuInfoField("cpu MHz", fieldBuffer, sizeof(fieldBuffer))) {
+    host.cpuMegahertz = strtod(fieldBuffer, NULL);
+  }
+
+#define HOST_COMPILED_FEATURE(name) hostProbeAppend(host.isaCompiled, sizeof(host.isaCompiled), name);
+#if defined(__SSE4_2__)
+  HOST_COMPILED_FEATURE("sse4.2")
+#endif // defined(__SSE4_2__)
+#if defined(__AVX__)
+  HOST_COMPILED_FEATURE("avx")
+#endif // defined(__AVX__)
+#if defined(__AVX2__)
+  HOST_COMPILED_FEATURE("avx2")
+#endif // defined(__AVX2__)
+#if defined(__FMA__)
+  HOST_COMPILED_FEATURE("fma")
+#endif // defined(__FMA__)
+#if defined(__BMI2__)
+  HOST_COMPILED_FEATURE("bmi2")
+#endif // defined(__BMI2__)
+#if defined(__AVX512F__)
+  HOST_COMPILED_FEATURE("avx512f")
+#endif // defined(__AVX512F__)
+#if defined(__ARM_NEON)
+  HOST_COMPILED_FEATURE("neon")
+#endif // defined(__ARM_NEON)
+#if defined(__ARM_FEATURE_SVE)
+  HOST_COMPILED_FEATURE("sve")
+#endif // defined(__ARM_FEATURE_SVE)
+#undef HOST_COMPILED_FEATURE
+  if ('\0' == host.isaCompiled[0]) {
+    snprintf(host.isaCompiled, sizeof(host.isaCompiled), "baseline");
+  }
+
+  for (size_t level = 1; level <= 3; level++) {
+    host.cacheBytes[level - 1] = getCacheSize(level);
+  }
+  host.onlineCores = getNumCores();
+  hostProbeReadLine("/sys/devices/system/cpu/smt/control", host.smtControl, sizeof(host.smtControl));
+  hostProbeReadLine("/sys/devices/system/cpu/smt/active", host.smtActive, sizeof(host.smtActive));
+  hostProbeReadLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_driver", host.scalingDriver,
+                    sizeof(host.scalingDriver));
+  hostProbeReadLine("/sys/devices/system/cpu/cpu0/cpufreq/scaling_governor", host.governor, sizeof(host.governor));
+  // intel_pstate reports the inverse, acpi-cpufreq and amd-pstate report boost.
+  if (hostProbeReadLine("/sys/devices/system/cpu/intel_pstate/no_turbo", fieldBuffer, sizeof(fieldBuffer))) {
+    snprintf(host.turbo, sizeof(host.turbo), "%s", ('0' == fieldBuffer[0]) ? "enabled" : "disabled");
+  } else if (hostProbeReadLine("/sys/devices/system/cpu/cpufreq/boost", fieldBuffer, sizeof(fieldBuffer))) {
+    snprintf(host.turbo, sizeof(host.turbo), "%s", ('1' == fieldBuffer[0]) ? "enabled" : "disabled");
+  } else {
+    snprintf(host.turbo, sizeof(host.turbo), "unknown");
+  }
+
+#if defined(__linux__)
+  const char vulnerabilityDirectory[] = "/sys/devices/system/cpu/vulnerabilities";
+  char fileName[CHAR_BUFFER_SIZE];
+  struct utsname kernelName;
+  struct dirent *entry;
+  DIR *directory;
+
+  if (0 == uname(&kernelName)) {
+    snprintf(host.kernel, sizeof(host.kernel), "%.48s %.64s %.96s %.32s", kernelName.sysname, kernelName.release,
+             kernelName.version, kernelName.machine);
+    snprintf(host.hostName, sizeof(host.hostName), "%s", kernelName.nodename);
+  }
+  directory = opendir(vulnerabilityDirectory);
+  if (NULL != directory) {
+    while ((host.vulnerabilityCount < HOST_VULNERABILITIES_MAX) && (NULL != (entry = readdir(directory)))) {
+      if ('.' == entry->d_name[0]) {
+        continue;
+      }
+      hostVulnerability_t &vulnerability = host.vulnerabilities[host.vulnerabilityCount];
+      snprintf(vulnerability.name, sizeof(vulnerability.name), "%.*s", (int) sizeof(vulnerability.name) - 1,
+               entry->d_name);
+      snprintf(fileName, sizeof(fileName), "%s/%s", vulnerabilityDirectory, vulnerability.name);
+      if (hostProbeReadLine(fileName, vulnerability.state, sizeof(vulnerability.state))) {
+        host.vulnerabilityCount++;
+      }
+    }
+    closedir(directory);
+    qsort(host.vulnerabilities, host.vulnerabilityCount, sizeof(hostVulnerability_t), hostProbeVulnerabilityCompare);
+  }
+#endif // defined(__linux__)
+  host.fingerprint = hostProbeFingerprint(host);
+  return;
+}
+
+/******************************************************************************
+* Writes the host as "# key: value" lines ahead of the column header of a
+* result file. Empty values were not available on this host.
+* @return  None
+*****************************************************************************/
+void hostProbeWriteMetadata(FILE *fileContext) {
+  const hostProbe_t &host = harnessHost;
+  char timeBuffer[HOST_FIELD_SIZE / 4];
+  time_t timeNow = time(NULL);
+  struct tm timeUtc;
+
+  hostProbeRun(harnessHost);
+  timeBuffer[0] = '\0';
+  if (NULL != gmtime_r(&timeNow, &timeUtc)) {
+    strftime(timeBuffer, sizeof(timeBuffer), "%Y-%m-%dT%H:%M:%SZ", &timeUtc);
+  }
+  fprintf(fileContext, "%sfingerprint: 0x%016" PRIx64 "\n", HOST_METADATA_PREFIX, host.fingerprint);
+  fprintf(fileContext, "%screated: %s\n", HOST_METADATA_PREFIX, timeBuffer);
+  fprintf(fileContext, "%sgit_revision: %s\n", HOST_METADATA_PREFIX, GIT_REVISION);
+  fprintf(fileContext, "%shost_name: %s\n", HOST_METADATA_PREFIX, host.hostName);
+  fprintf(fileContext, "%scpu_vendor: %s\n", HOST_METADATA_PREFIX, host.vendor);
+  fprintf(fileContext, "%scpu_brand: %s\n", HOST_METADATA_PREFIX, host.brand);
+  fprintf(fileContext, "%scpu_family_model_stepping: %u, %u, %u\n", HOST_METADATA_PREFIX, host.family, host.model,
+          host.stepping);
+  fprintf(fileContext, "%smicrocode: %s\n", HOST_METADATA_PREFIX, host.microcode);
+  fprintf(fileContext, "%scpu_mhz: %.3f\n", HOST_METADATA_PREFIX, host.cpuMegahertz);
+  fprintf(fileContext, "%sisa_runtime: %s\n", HOST_METADATA_PREFIX, host.isaRuntime);
+  fprintf(fileContext, "%sisa_compiled: %s\n", HOST_METADATA_PREFIX, host.isaCompiled);
+  fprintf(fileContext, "%scache_bytes_l1d_l2_l3: %zu, %zu, %zu\n", HOST_METADATA_PREFIX, host.cacheBytes[0],
+          host.cacheBytes[1], host.cacheBytes[2]);
+  fprintf(fileContext, "%sonline_cores: %u\n", HOST_METADATA_PREFIX, host.onlineCores);
+  fprintf(fileContext, "%ssmt_control_active: %s, %s\n", HOST_METADATA_PREFIX, host.smtControl, host.smtActive);
+  fprintf(fileContext, "%sscaling_driver_governor: %s, %s\n", HOST_METADATA_PREFIX, host.scalingDriver,
+          host.governor);
+  fprintf(fileContext, "%sturbo: %s\n", HOST_METADATA_PREFIX, host.turbo);
+  fprintf(fileContext, "%skernel: %s\n", HOST_METADATA_PREFIX, host.kernel);
+  fprintf(fileContext, "%scompiler: %s\n", HOST_METADATA_PREFIX, __VERSION__);
+  fprintf(fileContext, "%sbuild_flags: %s\n", HOST_METADATA_PREFIX, BUILD_FLAGS);
+  for (size_t index = 0; index < host.vulnerabilityCount; index++) {
+    fprintf(fileContext, "%svulnerability_%s: %s\n", HOST_METADATA_PREFIX, host.vulnerabilities[index].name,
+            host.vulnerabilities[index].state);
+  }
+  return;
+}
+
+#endif // _CPUBENCHMARKHOSTPROBE_HPP_
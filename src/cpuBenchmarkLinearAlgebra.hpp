@@ -0,0 +1,561 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the roofline family for peaks and levels.
+
+#ifndef _CPUBENCHMARKLINEARALGEBRA_HPP_
+#define _CPUBENCHMARKLINEARALGEBRA_HPP_
+
+#define LINEARALGEBRA_FLOPS_PER_MEASUREMENT (1ULL << 31) // Passes are repeated up to this many operations
+#define LINEARALGEBRA_ORDER_STEP 32 // Orders are multiples of the widest vector micro-tile
+#define LINEARALGEBRA_GEMM_ORDER_MAX 1024 // Naive GEMM beyond this takes minutes per row
+#define LINEARALGEBRA_BLOCK 64 // Cache block edge of the blocked GEMM
+#define LINEARALGEBRA_DEPTH_BLOCK 256 // Inner dimension block of the tiled GEMM, keeps a B panel in L2
+#define LINEARALGEBRA_GEMV_BLOCK 1024 // Columns of x kept in L1 by the blocked GEMV
+#define LINEARALGEBRA_TILE_ROWS 4 // Rows of the register tile, thread row ranges are multiples of it
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum linearAlgebraKernel_e {
+  la_gemv_e = 0, // y = A x
+  la_gemm_e = 1, // C = A B
+  la_count_e = 2
+} linearAlgebraKernel_et;
+
+typedef enum linearAlgebraVariant_e {
+  lv_naive_e = 0, // Textbook loops, scalar
+  lv_blocked_e = 1, // Cache blocked loops, scalar
+  lv_registerTiled_e = 2, // Cache blocked with a 4x4 (GEMM) or 4 row (GEMV) register tile, scalar
+  lv_vectorized_e = 3, // Register tile on GCC vector extensions of ROOFLINE_VECTOR_BYTES
+  lv_count_e = 4
+} linearAlgebraVariant_et;
+
+// Thread arguments are written by the owning thread, so they are padded.
+typedef struct alignas(CACHE_LINE_SIZE) linearAlgebraThread {
+  linearAlgebraKernel_et kernel; // GEMV or GEMM
+  linearAlgebraVariant_et variant; // Loop structure under test
+  size_t order; // Matrices are order x order, row major
+  size_t rowStart; // First row of the output owned by the thread
+  size_t rowEnd; // One past the last owned row
+  size_t passes; // Repetitions of the kernel
+  const void *a; // Matrix A
+  const void *b; // Matrix B for GEMM, vector x for GEMV
+  void *c; // Matrix C for GEMM, vector y for GEMV
+  pthread_barrier_t *startBarrier; // Releases all threads at once
+  double timeStart; // Right after the start barrier
+  double timeStop; // After the last pass
+} linearAlgebraThread_t;
+
+template<class classType>
+struct linearAlgebraVector {
+  // Element aligned, rows of small orders are not vector aligned.
+  typedef classType type __attribute__((vector_size(ROOFLINE_VECTOR_BYTES), aligned(sizeof(classType))));
+};
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *linearAlgebraKernelName(linearAlgebraKernel_et kernel);
+
+const char *linearAlgebraVariantName(linearAlgebraVariant_et variant);
+
+rooflineLevel_et linearAlgebraLevel(size_t workingSet);
+
+template<class classType>
+void linearAlgebraGemv(linearAlgebraVariant_et variant, const classType *a, const classType *x, classType *y,
+                       size_t order, size_t rowStart, size_t rowEnd);
+
+template<class classType>
+void linearAlgebraGemm(linearAlgebraVariant_et variant, const classType *a, const classType *b, classType *c,
+                       size_t order, size_t rowStart, size_t rowEnd);
+
+template<class classType>
+void *linearAlgebra_Pthread(void *inArgs);
+
+template<class classType>
+double linearAlgebraMeasure(linearAlgebraKernel_et kernel, linearAlgebraVariant_et variant, const classType *a,
+                            const classType *b, classType *c, size_t order, size_t threadCount, size_t passes);
+
+template<class classType>
+void linearAlgebraMeasureType(FILE *fileContext, size_t threadMax, size_t passesOption);
+
+int testharness_LinearAlgebra(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the kernel.
+*****************************************************************************/
+const char *linearAlgebraKernelName(linearAlgebraKernel_et kernel) {
+  const char *kernelName;
+  switch (kernel) {
+    case la_gemv_e:
+      kernelName = "gemv";
+      break;
+    case la_gemm_e:
+      kernelName = "gemm";
+      break;
+    default:
+      kernelName = "unknown";
+      break;
+  }
+  return kernelName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the loop variant.
+*****************************************************************************/
+const char *linearAlgebraVariantName(linearAlgebraVariant_et variant) {
+  const char *variantName;
+  switch (variant) {
+    case lv_naive_e:
+      variantName = "naive";
+      break;
+    case lv_blocked_e:
+      variantName = "blocked";
+      break;
+    case lv_registerTiled_e:
+      variantName = "register_tiled";
+      break;
+    case lv_vectorized_e:
+      variantName = "vectorized";
+      break;
+    default:
+      variantName = "unknown";
+      break;
+  }
+  return variantName;
+}
+
+/******************************************************************************
+*
+* @return  smallest memory level that holds the working set.
+*****************************************************************************/
+rooflineLevel_et linearAlgebraLevel(size_t workingSet) {
+  size_t cacheSize[rl_dram_e] = {getCacheSize(1), getCacheSize(2), getCacheSize(3)};
+
+  for (size_t level = 0; level < rl_dram_e; level++) {
+    if (workingSet <= cacheSize[level]) {
+      return (rooflineLevel_et) level;
+    }
+  }
+  return rl_dram_e;
+}
+
+/******************************************************************************
+* Rows [rowStart, rowEnd) of y = A x. Scalar variants keep the compiler from
+* vectorizing so each variant measures its own loop structure.
+* @return  None
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+void linearAlgebraGemv(linearAlgebraVariant_et variant, const classType *a, const classType *x, classType *y,
+                       size_t order, size_t rowStart, size_t rowEnd) {
+  typedef typename linearAlgebraVector<classType>::type vector_t;
+  const size_t lanes = ROOFLINE_VECTOR_BYTES / sizeof(classType);
+  classType sum0, sum1, sum2, sum3;
+  vector_t vectorSum0, vectorSum1, vectorSum2, vectorSum3, xVector;
+  const classType *row;
+  size_t columnEnd;
+
+  switch (variant) {
+    case lv_blocked_e:
+      for (size_t row = rowStart; row < rowEnd; row++) {
+        y[row] = 0;
+      }
+      for (size_t columnBlock = 0; columnBlock < order; columnBlock += LINEARALGEBRA_GEMV_BLOCK) {
+        columnEnd = std::min(order, columnBlock + LINEARALGEBRA_GEMV_BLOCK);
+        for (size_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex++) {
+          row = a + rowIndex * order;
+          sum0 = y[rowIndex];
+          for (size_t column = columnBlock; column < columnEnd; column++) {
+            sum0 += row[column] * x[column];
+          }
+          y[rowIndex] = sum0;
+        }
+      }
+      break;
+    case lv_registerTiled_e:
+      // Four rows share each load of x.
+      for (size_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex += LINEARALGEBRA_TILE_ROWS) {
+        row = a + rowIndex * order;
+        sum0 = sum1 = sum2 = sum3 = 0;
+        for (size_t column = 0; column < order; column++) {
+          sum0 += row[column] * x[column];
+          sum1 += row[order + column] * x[column];
+          sum2 += row[2 * order + column] * x[column];
+          sum3 += row[3 * order + column] * x[column];
+        }
+        y[rowIndex] = sum0;
+        y[rowIndex + 1] = sum1;
+        y[rowIndex + 2] = sum2;
+        y[rowIndex + 3] = sum3;
+      }
+      break;
+    case lv_vectorized_e:
+      for (size_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex += LINEARALGEBRA_TILE_ROWS) {
+        row = a + rowIndex * order;
+        vectorSum0 = vectorSum1 = vectorSum2 = vectorSum3 = (vector_t) {};
+        for (size_t column = 0; column < order; column += lanes) {
+          xVector = *(const vector_t *) (x + column);
+          vectorSum0 += *(const vector_t *) (row + column) * xVector;
+          vectorSum1 += *(const vector_t *) (row + order + column) * xVector;
+          vectorSum2 += *(const vector_t *) (row + 2 * order + column) * xVector;
+          vectorSum3 += *(const vector_t *) (row + 3 * order + column) * xVector;
+        }
+        sum0 = sum1 = sum2 = sum3 = 0;
+        for (size_t lane = 0; lane < lanes; lane++) {
+          sum0 += vectorSum0[lane];
+          sum1 += vectorSum1[lane];
+          sum2 += vectorSum2[lane];
+          sum3 += vectorSum3[lane];
+        }
+        y[rowIndex] = sum0;
+        y[rowIndex + 1] = sum1;
+        y[rowIndex + 2] = sum2;
+        y[rowIndex + 3] = sum3;
+      }
+      break;
+    case lv_naive_e:
+    default:
+      for (size_t rowIndex = rowStart; rowIndex < rowEnd; rowIndex++) {
+        row = a + rowIndex * order;
+        sum0 = 0;
+        for (size_t column = 0; column < order; column++) {
+          sum0 += row[column] * x[column];
+        }
+        y[rowIndex] = sum0;
+      }
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* Rows [rowStart, rowEnd) of C = A B.
+* @return  None
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+void linearAlgebraGemm(linearAlgebraVariant_et variant, const classType *a, const classType *b, classType *c,
+                       size_t order, size_t rowStart, size_t rowEnd) {
+  typedef typename linearAlgebraVector<classType>::type vector_t;
+  const size_t lanes = ROOFLINE_VECTOR_BYTES / sizeof(classType);
+  classType tile[LINEARALGEBRA_TILE_ROWS][LINEARALGEBRA_TILE_ROWS];
+  vector_t vectorTile[LINEARALGEBRA_TILE_ROWS][2], bVector0, bVector1;
+  classType sum, aValue;
+  size_t rowBlockEnd, depthEnd, columnBlockEnd;
+
+  if (lv_naive_e != variant) {
+    for (size_t index = rowStart * order; index < rowEnd * order; index++) {
+      c[index] = 0;
+    }
+  }
+  switch (variant) {
+    case lv_blocked_e:
+      for (size_t rowBlock = rowStart; rowBlock < rowEnd; rowBlock += LINEARALGEBRA_BLOCK) {
+        rowBlockEnd = std::min(rowEnd, rowBlock + LINEARALGEBRA_BLOCK);
+        for (size_t depthBlock = 0; depthBlock < order; depthBlock += LINEARALGEBRA_BLOCK) {
+          depthEnd = std::min(order, depthBlock + LINEARALGEBRA_BLOCK);
+          for (size_t columnBlock = 0; columnBlock < order; columnBlock += LINEARALGEBRA_BLOCK) {
+            columnBlockEnd = std::min(order, columnBlock + LINEARALGEBRA_BLOCK);
+            for (size_t row = rowBlock; row < rowBlockEnd; row++) {
+              for (size_t depth = depthBlock; depth < depthEnd; depth++) {
+                aValue = a[row * order + depth];
+                for (size_t column = columnBlock; column < columnBlockEnd; column++) {
+                  c[row * order + column] += aValue * b[depth * order + column];
+                }
+              }
+            }
+          }
+        }
+      }
+      break;
+    case lv_registerTiled_e:
+      for (size_t depthBlock = 0; depthBlock < order; depthBlock += LINEARALGEBRA_DEPTH_BLOCK) {
+        depthEnd = std::min(order, depthBlock + LINEARALGEBRA_DEPTH_BLOCK);
+        for (size_t row = rowStart; row < rowEnd; row += LINEARALGEBRA_TILE_ROWS) {
+          for (size_t column = 0; column < order; column += LINEARALGEBRA_TILE_ROWS) {
+            for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+              for (size_t tileColumn = 0; tileColumn < LINEARALGEBRA_TILE_ROWS; tileColumn++) {
+                tile[tileRow][tileColumn] = c[(row + tileRow) * order + column + tileColumn];
+              }
+            }
+            for (size_t depth = depthBlock; depth < depthEnd; depth++) {
+#pragma GCC unroll 4
+              for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+                aValue = a[(row + tileRow) * order + depth];
+#pragma GCC unroll 4
+                for (size_t tileColumn = 0; tileColumn < LINEARALGEBRA_TILE_ROWS; tileColumn++) {
+                  tile[tileRow][tileColumn] += aValue * b[depth * order + column + tileColumn];
+                }
+              }
+            }
+            for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+              for (size_t tileColumn = 0; tileColumn < LINEARALGEBRA_TILE_ROWS; tileColumn++) {
+                c[(row + tileRow) * order + column + tileColumn] = tile[tileRow][tileColumn];
+              }
+            }
+          }
+        }
+      }
+      break;
+    case lv_vectorized_e:
+      // Four rows by two vectors of C stay in registers across a depth block.
+      for (size_t depthBlock = 0; depthBlock < order; depthBlock += LINEARALGEBRA_DEPTH_BLOCK) {
+        depthEnd = std::min(order, depthBlock + LINEARALGEBRA_DEPTH_BLOCK);
+        for (size_t row = rowStart; row < rowEnd; row += LINEARALGEBRA_TILE_ROWS) {
+          for (size_t column = 0; column < order; column += 2 * lanes) {
+#pragma GCC unroll 4
+            for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+              vectorTile[tileRow][0] = *(vector_t *) (c + (row + tileRow) * order + column);
+              vectorTile[tileRow][1] = *(vector_t *) (c + (row + tileRow) * order + column + lanes);
+            }
+            for (size_t depth = depthBlock; depth < depthEnd; depth++) {
+              bVector0 = *(const vector_t *) (b + depth * order + column);
+              bVector1 = *(const vector_t *) (b + depth * order + column + lanes);
+#pragma GCC unroll 4
+              for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+                aValue = a[(row + tileRow) * order + depth];
+                vectorTile[tileRow][0] += aValue * bVector0;
+                vectorTile[tileRow][1] += aValue * bVector1;
+              }
+            }
+#pragma GCC unroll 4
+            for (size_t tileRow = 0; tileRow < LINEARALGEBRA_TILE_ROWS; tileRow++) {
+              *(vector_t *) (c + (row + tileRow) * order + column) = vectorTile[tileRow][0];
+              *(vector_t *) (c + (row + tileRow) * order + column + lanes) = vectorTile[tileRow][1];
+            }
+          }
+        }
+      }
+      break;
+    case lv_naive_e:
+    default:
+      for (size_t row = rowStart; row < rowEnd; row++) {
+        for (size_t column = 0; column < order; column++) {
+          sum = 0;
+          for (size_t depth = 0; depth < order; depth++) {
+            sum += a[row * order + depth] * b[depth * order + column];
+          }
+          c[row * order + column] = sum;
+        }
+      }
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* Runs the kernel on the rows owned by this thread.
+* @return  the thread arguments.
+*****************************************************************************/
+template<class classType>
+void *linearAlgebra_Pthread(void *inArgs) {
+  linearAlgebraThread_t *threadInfo = (linearAlgebraThread_t *) inArgs;
+
+  pthread_barrier_wait(threadInfo->startBarrier);
+  threadInfo->timeStart = getTime();
+  for (size_t pass = 0; pass < threadInfo->passes; pass++) {
+    if (la_gemm_e == threadInfo->kernel) {
+      linearAlgebraGemm<classType>(threadInfo->variant, (const classType *) threadInfo->a,
+                                   (const classType *) threadInfo->b, (classType *) threadInfo->c, threadInfo->order,
+                                   threadInfo->rowStart, threadInfo->rowEnd);
+    } else {
+      linearAlgebraGemv<classType>(threadInfo->variant, (const classType *) threadInfo->a,
+                                   (const classType *) threadInfo->b, (classType *) threadInfo->c, threadInfo->order,
+                                   threadInfo->rowStart, threadInfo->rowEnd);
+    }
+  }
+  threadInfo->timeStop = getTime();
+  return inArgs;
+}
+
+/******************************************************************************
+* Splits the output rows over the thread team in whole register tiles.
+* @return  wall time from the first thread leaving the barrier to the last
+*          thread finishing, negative on failure.
+*****************************************************************************/
+template<class classType>
+double linearAlgebraMeasure(linearAlgebraKernel_et kernel, linearAlgebraVariant_et variant, const classType *a,
+                            const classType *b, classType *c, size_t order, size_t threadCount, size_t passes) {
+  size_t tiles = order / LINEARALGEBRA_TILE_ROWS;
+  size_t tilesPerThread = (tiles + threadCount - 1) / threadCount;
+  std::vector<linearAlgebraThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  pthread_barrier_t startBarrier;
+  double timeStart = 0.0, timeStop = 0.0;
+  bool isValid;
+
+  pthread_barrier_init(&startBarrier, NULL, threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    threadInfo[threadIndex].kernel = kernel;
+    threadInfo[threadIndex].variant = variant;
+    threadInfo[threadIndex].order = order;
+    threadInfo[threadIndex].rowStart = std::min(tiles, threadIndex * tilesPerThread) * LINEARALGEBRA_TILE_ROWS;
+    threadInfo[threadIndex].rowEnd = std::min(tiles, (threadIndex + 1) * tilesPerThread) * LINEARALGEBRA_TILE_ROWS;
+    threadInfo[threadIndex].passes = passes;
+    threadInfo[threadIndex].a = a;
+    threadInfo[threadIndex].b = b;
+    threadInfo[threadIndex].c = c;
+    threadInfo[threadIndex].startBarrier = &startBarrier;
+    threadInfo[threadIndex].timeStart = 0.0;
+    threadInfo[threadIndex].timeStop = 0.0;
+    threadArgs[threadIndex] = &threadInfo[threadIndex];
+  }
+  isValid = threadTeamRun(linearAlgebra_Pthread<classType>, threadArgs, true);
+  pthread_barrier_destroy(&startBarrier);
+
+  if (isValid) {
+    timeStart = threadInfo[0].timeStart;
+    for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+      timeStart = std::min(timeStart, threadInfo[threadIndex].timeStart);
+      timeStop = std::max(timeStop, threadInfo[threadIndex].timeStop);
+    }
+  }
+  return isValid ? (timeStop - timeStart) : -1.0;
+}
+
+/******************************************************************************
+* GEMV and GEMM of one type for every variant, memory level and thread count
+* doubling up to threadMax. Orders follow the roofline working sets; GEMM
+* orders are capped, so its larger levels collapse onto the cap.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void linearAlgebraMeasureType(FILE *fileContext, size_t threadMax, size_t passesOption) {
+  const size_t matrices[la_count_e] = {1, 3};
+  size_t workingSetLevel[rl_count_e];
+  size_t order, orderLast, workingSet, elements, passes, threadCores;
+  classType *a, *b, *c;
+  std::vector<classType> reference;
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  rooflinePeak_t peak;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double operations, timeDelta, gigaflops, peakGigaflops, difference, magnitude;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  rooflinePeakMeasure<classType>(ROOFLINE_ITERATIONS_DEFAULT, peak);
+  rooflineWorkingSetSelect(workingSetLevel);
+  for (size_t kernel = 0; kernel < la_count_e; kernel++) {
+    orderLast = 0;
+    for (size_t level = 0; level < rl_count_e; level++) {
+      if (0 == workingSetLevel[level]) {
+        continue;
+      }
+      order = (size_t) std::sqrt((double) workingSetLevel[level] / (double) (matrices[kernel] * sizeof(classType)));
+      order = std::max((size_t) LINEARALGEBRA_ORDER_STEP, order - (order % LINEARALGEBRA_ORDER_STEP));
+      if (la_gemm_e == kernel) {
+        order = std::min(order, (size_t) LINEARALGEBRA_GEMM_ORDER_MAX);
+      }
+      if (order == orderLast) {
+        continue;
+      }
+      orderLast = order;
+      elements = (la_gemm_e == kernel) ? (order * order) : order;
+      workingSet = (order * order + 2 * elements) * sizeof(classType);
+      operations = 2.0 * (double) order * (double) order * ((la_gemm_e == kernel) ? (double) order : 1.0);
+      passes = (passesOption > 0) ? passesOption
+                                  : std::max((size_t) 1, (size_t) (LINEARALGEBRA_FLOPS_PER_MEASUREMENT / operations));
+      a = (classType *) aligned_alloc(ROOFLINE_VECTOR_BYTES, order * order * sizeof(classType));
+      b = (classType *) aligned_alloc(ROOFLINE_VECTOR_BYTES, elements * sizeof(classType));
+      c = (classType *) aligned_alloc(ROOFLINE_VECTOR_BYTES, elements * sizeof(classType));
+      if ((NULL == a) || (NULL == b) || (NULL == c)) {
+        fprintf(stderr, "Error on line %d : %s.\n", __LINE__, strerror(errno));
+        free(a);
+        free(b);
+        free(c);
+        return;
+      }
+      // Small exact values, every variant rounds the same products.
+      for (size_t index = 0; index < order * order; index++) {
+        a[index] = (classType) ((index % 13) + 1) / (classType) 16;
+      }
+      for (size_t index = 0; index < elements; index++) {
+        b[index] = (classType) ((index % 7) + 1) / (classType) 8;
+      }
+
+      for (size_t threadCount = 1; threadCount <= threadMax;) {
+        threadCores = std::min(threadCount, (size_t) getNumCores());
+        peakGigaflops = peak.operationsPerSecond[rc_vector_e] * (double) threadCores / 1e9;
+        for (size_t variant = 0; variant < lv_count_e; variant++) {
+          frequencyStart = frequencyMonitorRead(harnessMonitor);
+          timeDelta = linearAlgebraMeasure<classType>((linearAlgebraKernel_et) kernel,
+                                                      (linearAlgebraVariant_et) variant, a, b, c, order, threadCount,
+                                                      passes);
+          frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+          if (lv_naive_e == variant) {
+            reference.assign(c, c + elements);
+          }
+          difference = 0.0;
+          magnitude = 0.0;
+          for (size_t index = 0; index < elements; index++) {
+            difference = std::max(difference, (double) std::fabs(c[index] - reference[index]));
+            magnitude = std::max(magnitude, (double) std::fabs(reference[index]));
+          }
+          gigaflops = (timeDelta > 0.0) ? ((operations * (double) passes) / timeDelta / 1e9) : 0.0;
+          resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %zu, %zu, %s, %zu, %zu, %f, %f, %f, %f, %e",
+                         linearAlgebraKernelName((linearAlgebraKernel_et) kernel), typeNameBuffer,
+                         linearAlgebraVariantName((linearAlgebraVariant_et) variant), order, workingSet,
+                         rooflineLevelName(linearAlgebraLevel(workingSet)), threadCount, passes, timeDelta,
+                         gigaflops, peakGigaflops, (peakGigaflops > 0.0) ? (gigaflops / peakGigaflops) : 0.0,
+                         (magnitude > 0.0) ? (difference / magnitude) : difference);
+        }
+        if ((threadCount < threadMax) && ((2 * threadCount) > threadMax)) {
+          threadCount = threadMax;
+        } else {
+          threadCount *= 2;
+        }
+      }
+      free(a);
+      free(b);
+      free(c);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures GEMV and GEMM in naive, blocked, register tiled and vectorized
+* forms from L1 resident to DRAM resident sizes, threaded over output rows,
+* and reports GFLOP/s against the measured vector multiply-add peak.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_LinearAlgebra(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Kernel, Type System, Variant, Order, Working Set Bytes, Memory Level, Threads, Passes, "
+                            "Time for Operations, GFLOP per Second, Measured Peak GFLOP per Second, Fraction of Peak, "
+                            "Max Relative Difference versus Naive";
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Peak is the %d byte vector multiply-add peak of one core times the cores in use.\n", ROOFLINE_VECTOR_BYTES);
+  fileContext = resultFileOpen("LinearAlgebra", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  linearAlgebraMeasureType<float>(fileContext, threadMax, options.iterations);
+  linearAlgebraMeasureType<double>(fileContext, threadMax, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKLINEARALGEBRA_HPP_
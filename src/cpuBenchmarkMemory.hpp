@@ -0,0 +1,765 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the roofline family for buffer alignment.
+
+#ifndef _CPUBENCHMARKMEMORY_HPP_
+#define _CPUBENCHMARKMEMORY_HPP_
+
+// String instructions and vector loops are compiled per function and selected at run time.
+#if defined(__x86_64__)
+#define MEMORY_EXTENSION_ENABLE 1
+#define MEMORY_TARGET "avx2"
+#define MEMORY_VECTOR_BYTES 32
+#else
+#define MEMORY_EXTENSION_ENABLE 0
+#endif
+
+#define MEMORY_BYTES_MIN 1 // Default sweep of the operation size, grows by MEMORY_BYTES_STEP ...
+#define MEMORY_BYTES_MAX (1ULL << 30) // ... up to this many, -n selects a single size
+#define MEMORY_BYTES_STEP 2
+#define MEMORY_BYTES_PER_MEASUREMENT (1ULL << 26) // Small sizes repeat until about this much was touched ...
+#define MEMORY_CALLS_MAX (1ULL << 20) // ... or this many calls
+#define MEMORY_MISALIGN_SOURCE 1 // Byte offsets of the misaligned case, different so the
+#define MEMORY_MISALIGN_DESTINATION 3 // buffers are not aligned to each other either
+#define MEMORY_SET_VALUE 0x5A
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum memoryOp_e {
+  mp_memcpy_e = 0, // Disjoint buffers
+  mp_memset_e = 1,
+  mp_memmoveUp_e = 2, // Destination half way into the source, copies from the end
+  mp_memmoveDown_e = 3, // Source half way into the destination, copies from the start
+  mp_memcmp_e = 4, // Equal buffers but the last byte, the whole length is compared
+  mp_strlen_e = 5, // Terminator in the last byte
+  mp_count_e = 6
+} memoryOp_et;
+
+typedef enum memoryImplementation_e {
+  mi_libc_e = 0, // C library, picks its own strategy by size and CPU
+  mi_repString_e = 1, // rep movsb, rep stosb, std rep movsb, repe cmpsb or repne scasb
+  mi_avx2_e = 2, // 32 byte unaligned load and store loop
+  mi_nonTemporal_e = 3, // 32 byte streaming stores bypassing the caches, copy and set only
+  mi_count_e = 4
+} memoryImplementation_et;
+
+typedef enum memoryAlignment_e {
+  ma_aligned_e = 0, // Both buffers on a ROOFLINE_VECTOR_BYTES boundary
+  ma_misaligned_e = 1, // Offset by MEMORY_MISALIGN_SOURCE and MEMORY_MISALIGN_DESTINATION
+  ma_count_e = 2
+} memoryAlignment_et;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *memoryOpName(memoryOp_et op);
+
+const char *memoryImplementationName(memoryImplementation_et implementation);
+
+const char *memoryAlignmentName(memoryAlignment_et alignment);
+
+uint8_t memoryPattern(size_t index);
+
+#if MEMORY_EXTENSION_ENABLE
+void memoryRepMovsb(uint8_t *destination, const uint8_t *source, size_t bytes);
+
+void memoryRepMovsbBackward(uint8_t *destination, const uint8_t *source, size_t bytes);
+
+void memoryRepStosb(uint8_t *destination, uint8_t value, size_t bytes);
+
+int memoryRepCmpsb(const uint8_t *left, const uint8_t *right, size_t bytes);
+
+size_t memoryRepScasb(const uint8_t *string);
+
+__attribute__((target(MEMORY_TARGET)))
+void memoryVectorCopy(uint8_t *destination, const uint8_t *source, size_t bytes);
+
+__attribute__((target(MEMORY_TARGET)))
+void memoryVectorCopyBackward(uint8_t *destination, const uint8_t *source, size_t bytes);
+
+__attribute__((target(MEMORY_TARGET)))
+void memoryVectorSet(uint8_t *destination, uint8_t value, size_t bytes);
+
+__attribute__((target(MEMORY_TARGET)))
+int memoryVectorCompare(const uint8_t *left, const uint8_t *right, size_t bytes);
+
+__attribute__((target(MEMORY_TARGET)))
+size_t memoryVectorLength(const uint8_t *string);
+
+__attribute__((target(MEMORY_TARGET)))
+void memoryStreamCopy(uint8_t *destination, const uint8_t *source, size_t bytes);
+
+__attribute__((target(MEMORY_TARGET)))
+void memoryStreamSet(uint8_t *destination, uint8_t value, size_t bytes);
+#endif // MEMORY_EXTENSION_ENABLE
+
+bool memoryIsImplemented(memoryOp_et op, memoryImplementation_et implementation);
+
+int64_t memoryRun(memoryOp_et op, memoryImplementation_et implementation, uint8_t *destination, uint8_t *source,
+                  size_t bytes);
+
+void memoryPrepare(memoryOp_et op, uint8_t *destination, uint8_t *source, size_t bytes, size_t shift);
+
+bool memoryVerify(memoryOp_et op, const uint8_t *destination, const uint8_t *source, size_t bytes, size_t shift,
+                  int64_t result);
+
+int testharness_Memory(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the operation.
+*****************************************************************************/
+const char *memoryOpName(memoryOp_et op) {
+  const char *opName;
+  switch (op) {
+    case mp_memcpy_e:
+      opName = "memcpy";
+      break;
+    case mp_memset_e:
+      opName = "memset";
+      break;
+    case mp_memmoveUp_e:
+      opName = "memmove_up";
+      break;
+    case mp_memmoveDown_e:
+      opName = "memmove_down";
+      break;
+    case mp_memcmp_e:
+      opName = "memcmp";
+      break;
+    case mp_strlen_e:
+      opName = "strlen";
+      break;
+    default:
+      opName = "unknown";
+      break;
+  }
+  return opName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the implementation.
+*****************************************************************************/
+const char *memoryImplementationName(memoryImplementation_et implementation) {
+  const char *implementationName;
+  switch (implementation) {
+    case mi_libc_e:
+      implementationName = "libc";
+      break;
+    case mi_repString_e:
+      implementationName = "rep_string";
+      break;
+    case mi_avx2_e:
+      implementationName = "avx2";
+      break;
+    case mi_nonTemporal_e:
+      implementationName = "nontemporal";
+      break;
+    default:
+      implementationName = "unknown";
+      break;
+  }
+  return implementationName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the alignment.
+*****************************************************************************/
+const char *memoryAlignmentName(memoryAlignment_et alignment) {
+  const char *alignmentName;
+  switch (alignment) {
+    case ma_aligned_e:
+      alignmentName = "aligned";
+      break;
+    case ma_misaligned_e:
+      alignmentName = "misaligned";
+      break;
+    default:
+      alignmentName = "unknown";
+      break;
+  }
+  return alignmentName;
+}
+
+/******************************************************************************
+* Non periodic for any shift below 256, so a move by the wrong distance or in
+* the wrong direction shows up.
+* @return  byte stored at index.
+*****************************************************************************/
+uint8_t memoryPattern(size_t index) {
+  return (uint8_t) ((index * 131) + (index >> 8) + 7);
+}
+
+#if MEMORY_EXTENSION_ENABLE
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+__attribute__((noinline))
+void memoryRepMovsb(uint8_t *destination, const uint8_t *source, size_t bytes) {
+  __asm__ __volatile__("rep movsb" : "+D"(destination), "+S"(source), "+c"(bytes) : : "memory");
+  return;
+}
+
+/******************************************************************************
+* Copies from the last byte down with the direction flag set, the overlap
+* safe form when the destination is above the source.
+* @return  None
+*****************************************************************************/
+__attribute__((noinline))
+void memoryRepMovsbBackward(uint8_t *destination, const uint8_t *source, size_t bytes) {
+  if (bytes > 0) {
+    destination += bytes - 1;
+    source += bytes - 1;
+    __asm__ __volatile__("std\n\trep movsb\n\tcld" : "+D"(destination), "+S"(source), "+c"(bytes) : : "memory");
+  }
+  return;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+__attribute__((noinline))
+void memoryRepStosb(uint8_t *destination, uint8_t value, size_t bytes) {
+  __asm__ __volatile__("rep stosb" : "+D"(destination), "+c"(bytes) : "a"(value) : "memory");
+  return;
+}
+
+/******************************************************************************
+* Both pointers stop one past the first difference, or past the last byte
+* when the buffers are equal, so the last pair compared gives the result.
+* @return  difference of the first unequal bytes, zero when equal.
+*****************************************************************************/
+__attribute__((noinline))
+int memoryRepCmpsb(const uint8_t *left, const uint8_t *right, size_t bytes) {
+  if (0 == bytes) {
+    return 0;
+  }
+  __asm__ __volatile__("repe cmpsb" : "+S"(left), "+D"(right), "+c"(bytes) : : "memory", "cc");
+  return (int) left[-1] - (int) right[-1];
+}
+
+/******************************************************************************
+*
+* @return  length of the string.
+*****************************************************************************/
+__attribute__((noinline))
+size_t memoryRepScasb(const uint8_t *string) {
+  size_t count = SIZE_MAX;
+
+  __asm__ __volatile__("repne scasb" : "+D"(string), "+c"(count) : "a"(0) : "memory", "cc");
+  return ~count - 1;
+}
+
+/******************************************************************************
+* Forward loop, safe when the destination is below the source because every
+* store lands on bytes already loaded.
+* @return  None
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+void memoryVectorCopy(uint8_t *destination, const uint8_t *source, size_t bytes) {
+  size_t index = 0;
+
+  for (; (index + MEMORY_VECTOR_BYTES) <= bytes; index += MEMORY_VECTOR_BYTES) {
+    _mm256_storeu_si256((__m256i *) (destination + index), _mm256_loadu_si256((const __m256i *) (source + index)));
+  }
+  for (; index < bytes; index++) {
+    destination[index] = source[index];
+  }
+  return;
+}
+
+/******************************************************************************
+* Backward loop, safe when the destination is above the source.
+* @return  None
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+void memoryVectorCopyBackward(uint8_t *destination, const uint8_t *source, size_t bytes) {
+  size_t index = bytes;
+
+  while (index >= MEMORY_VECTOR_BYTES) {
+    index -= MEMORY_VECTOR_BYTES;
+    _mm256_storeu_si256((__m256i *) (destination + index), _mm256_loadu_si256((const __m256i *) (source + index)));
+  }
+  while (index > 0) {
+    index--;
+    destination[index] = source[index];
+  }
+  return;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+void memoryVectorSet(uint8_t *destination, uint8_t value, size_t bytes) {
+  const __m256i fill = _mm256_set1_epi8((char) value);
+  size_t index = 0;
+
+  for (; (index + MEMORY_VECTOR_BYTES) <= bytes; index += MEMORY_VECTOR_BYTES) {
+    _mm256_storeu_si256((__m256i *) (destination + index), fill);
+  }
+  for (; index < bytes; index++) {
+    destination[index] = value;
+  }
+  return;
+}
+
+/******************************************************************************
+*
+* @return  difference of the first unequal bytes, zero when equal.
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+int memoryVectorCompare(const uint8_t *left, const uint8_t *right, size_t bytes) {
+  uint32_t equalMask;
+  size_t index = 0;
+
+  for (; (index + MEMORY_VECTOR_BYTES) <= bytes; index += MEMORY_VECTOR_BYTES) {
+    equalMask = (uint32_t) _mm256_movemask_epi8(
+      _mm256_cmpeq_epi8(_mm256_loadu_si256((const __m256i *) (left + index)),
+                        _mm256_loadu_si256((const __m256i *) (right + index))));
+    if (UINT32_MAX != equalMask) {
+      index += (size_t) __builtin_ctz(~equalMask);
+      return (int) left[index] - (int) right[index];
+    }
+  }
+  for (; index < bytes; index++) {
+    if (left[index] != right[index]) {
+      return (int) left[index] - (int) right[index];
+    }
+  }
+  return 0;
+}
+
+/******************************************************************************
+* Aligned loads never cross a page, so reading the bytes before the string
+* within its first vector is safe; they are shifted out of the mask.
+* @return  length of the string.
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+size_t memoryVectorLength(const uint8_t *string) {
+  const __m256i zero = _mm256_setzero_si256();
+  const uint8_t *block = (const uint8_t *) ((uintptr_t) string & ~((uintptr_t) MEMORY_VECTOR_BYTES - 1));
+  uint32_t zeroMask;
+
+  zeroMask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) block), zero));
+  zeroMask >>= (uintptr_t) (string - block);
+  if (0 != zeroMask) {
+    return (size_t) __builtin_ctz(zeroMask);
+  }
+  do {
+    block += MEMORY_VECTOR_BYTES;
+    zeroMask = (uint32_t) _mm256_movemask_epi8(_mm256_cmpeq_epi8(_mm256_load_si256((const __m256i *) block), zero));
+  } while (0 == zeroMask);
+  return (size_t) (block - string) + (size_t) __builtin_ctz(zeroMask);
+}
+
+/******************************************************************************
+* Streaming stores need an aligned destination, the head up to the first
+* boundary and the tail go through plain stores.
+* @return  None
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+void memoryStreamCopy(uint8_t *destination, const uint8_t *source, size_t bytes) {
+  size_t head = (MEMORY_VECTOR_BYTES - ((uintptr_t) destination & (MEMORY_VECTOR_BYTES - 1))) &
+                (MEMORY_VECTOR_BYTES - 1);
+  size_t index = 0;
+
+  head = (head < bytes) ? head : bytes;
+  for (; index < head; index++) {
+    destination[index] = source[index];
+  }
+  for (; (index + MEMORY_VECTOR_BYTES) <= bytes; index += MEMORY_VECTOR_BYTES) {
+    _mm256_stream_si256((__m256i *) (destination + index), _mm256_loadu_si256((const __m256i *) (source + index)));
+  }
+  for (; index < bytes; index++) {
+    destination[index] = source[index];
+  }
+  _mm_sfence();
+  return;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+__attribute__((noinline, target(MEMORY_TARGET)))
+void memoryStreamSet(uint8_t *destination, uint8_t value, size_t bytes) {
+  const __m256i fill = _mm256_set1_epi8((char) value);
+  size_t head = (MEMORY_VECTOR_BYTES - ((uintptr_t) destination & (MEMORY_VECTOR_BYTES - 1))) &
+                (MEMORY_VECTOR_BYTES - 1);
+  size_t index = 0;
+
+  head = (head < bytes) ? head : bytes;
+  for (; index < head; index++) {
+    destination[index] = value;
+  }
+  for (; (index + MEMORY_VECTOR_BYTES) <= bytes; index += MEMORY_VECTOR_BYTES) {
+    _mm256_stream_si256((__m256i *) (destination + index), fill);
+  }
+  for (; index < bytes; index++) {
+    destination[index] = value;
+  }
+  _mm_sfence();
+  return;
+}
+#endif // MEMORY_EXTENSION_ENABLE
+
+/******************************************************************************
+* Streaming stores only make sense for the write only operations, and
+* overlapping moves would read back lines still in flight.
+* @return  true when the implementation has a variant of the operation.
+*****************************************************************************/
+bool memoryIsImplemented(memoryOp_et op, memoryImplementation_et implementation) {
+  bool isImplemented;
+  switch (implementation) {
+    case mi_libc_e:
+      isImplemented = true;
+      break;
+    case mi_nonTemporal_e:
+      isImplemented = (MEMORY_EXTENSION_ENABLE) && ((mp_memcpy_e == op) || (mp_memset_e == op));
+      break;
+    default:
+      isImplemented = (MEMORY_EXTENSION_ENABLE);
+      break;
+  }
+  return isImplemented;
+}
+
+/******************************************************************************
+* One call of the operation. The moves take their region from destination,
+* the source pointer then points into the same region.
+* @return  comparison or length result, zero for the copies and sets.
+*****************************************************************************/
+__attribute__((noinline))
+int64_t memoryRun(memoryOp_et op, memoryImplementation_et implementation, uint8_t *destination, uint8_t *source,
+                  size_t bytes) {
+  int64_t result = 0;
+  switch (op) {
+    case mp_memcpy_e:
+      switch (implementation) {
+#if MEMORY_EXTENSION_ENABLE
+        case mi_repString_e:
+          memoryRepMovsb(destination, source, bytes);
+          break;
+        case mi_avx2_e:
+          memoryVectorCopy(destination, source, bytes);
+          break;
+        case mi_nonTemporal_e:
+          memoryStreamCopy(destination, source, bytes);
+          break;
+#endif // MEMORY_EXTENSION_ENABLE
+        default:
+          memcpy(destination, source, bytes);
+          break;
+      }
+      break;
+    case mp_memset_e:
+      switch (implementation) {
+#if MEMORY_EXTENSION_ENABLE
+        case mi_repString_e:
+          memoryRepStosb(destination, MEMORY_SET_VALUE, bytes);
+          break;
+        case mi_avx2_e:
+          memoryVectorSet(destination, MEMORY_SET_VALUE, bytes);
+          break;
+        case mi_nonTemporal_e:
+          memoryStreamSet(destination, MEMORY_SET_VALUE, bytes);
+          break;
+#endif // MEMORY_EXTENSION_ENABLE
+        default:
+          memset(destination, MEMORY_SET_VALUE, bytes);
+          break;
+      }
+      break;
+    case mp_memmoveUp_e:
+    case mp_memmoveDown_e:
+      switch (implementation) {
+#if MEMORY_EXTENSION_ENABLE
+        case mi_repString_e:
+          if (destination > source) {
+            memoryRepMovsbBackward(destination, source, bytes);
+          } else {
+            memoryRepMovsb(destination, source, bytes);
+          }
+          break;
+        case mi_avx2_e:
+          if (destination > source) {
+            memoryVectorCopyBackward(destination, source, bytes);
+          } else {
+            memoryVectorCopy(destination, source, bytes);
+          }
+          break;
+#endif // MEMORY_EXTENSION_ENABLE
+        default:
+          memmove(destination, source, bytes);
+          break;
+      }
+      break;
+    case mp_memcmp_e:
+      switch (implementation) {
+#if MEMORY_EXTENSION_ENABLE
+        case mi_repString_e:
+          result = memoryRepCmpsb(source, destination, bytes);
+          break;
+        case mi_avx2_e:
+          result = memoryVectorCompare(source, destination, bytes);
+          break;
+#endif // MEMORY_EXTENSION_ENABLE
+        default:
+          result = memcmp(source, destination, bytes);
+          break;
+      }
+      break;
+    case mp_strlen_e:
+      switch (implementation) {
+#if MEMORY_EXTENSION_ENABLE
+        case mi_repString_e:
+          result = (int64_t) memoryRepScasb(source);
+          break;
+        case mi_avx2_e:
+          result = (int64_t) memoryVectorLength(source);
+          break;
+#endif // MEMORY_EXTENSION_ENABLE
+        default:
+          result = (int64_t) strlen((const char *) source);
+          break;
+      }
+      break;
+    default:
+      break;
+  }
+  return result;
+}
+
+/******************************************************************************
+* Writes the inputs of one operation. For the moves destination is the start
+* of a region of bytes plus shift bytes holding the pattern.
+* @return  None
+*****************************************************************************/
+void memoryPrepare(memoryOp_et op, uint8_t *destination, uint8_t *source, size_t bytes, size_t shift) {
+  switch (op) {
+    case mp_memmoveUp_e:
+    case mp_memmoveDown_e:
+      for (size_t index = 0; index < (bytes + shift); index++) {
+        destination[index] = memoryPattern(index);
+      }
+      break;
+    case mp_memcmp_e:
+      for (size_t index = 0; index < bytes; index++) {
+        source[index] = memoryPattern(index);
+      }
+      memcpy(destination, source, bytes);
+      destination[bytes - 1] ^= 1;
+      break;
+    case mp_strlen_e:
+      for (size_t index = 0; index < bytes; index++) {
+        source[index] = memoryPattern(index) | 1;
+      }
+      source[bytes - 1] = 0;
+      break;
+    case mp_memcpy_e:
+    case mp_memset_e:
+    default:
+      for (size_t index = 0; index < bytes; index++) {
+        source[index] = memoryPattern(index);
+      }
+      memset(destination, 0, bytes);
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* Checks one call made right after memoryPrepare.
+* @return  true when the operation produced the C library result.
+*****************************************************************************/
+bool memoryVerify(memoryOp_et op, const uint8_t *destination, const uint8_t *source, size_t bytes, size_t shift,
+                  int64_t result) {
+  bool isValid = true;
+  int expected;
+  switch (op) {
+    case mp_memcpy_e:
+      isValid = (0 == memcmp(destination, source, bytes));
+      break;
+    case mp_memset_e:
+      for (size_t index = 0; isValid && (index < bytes); index++) {
+        isValid = (MEMORY_SET_VALUE == destination[index]);
+      }
+      break;
+    case mp_memmoveUp_e:
+      for (size_t index = 0; isValid && (index < bytes); index++) {
+        isValid = (memoryPattern(index) == destination[shift + index]);
+      }
+      break;
+    case mp_memmoveDown_e:
+      for (size_t index = 0; isValid && (index < bytes); index++) {
+        isValid = (memoryPattern(shift + index) == destination[index]);
+      }
+      break;
+    case mp_memcmp_e:
+      expected = memcmp(source, destination, bytes);
+      isValid = ((expected < 0) == (result < 0)) && ((expected > 0) == (result > 0));
+      break;
+    case mp_strlen_e:
+      isValid = ((int64_t) (bytes - 1) == result);
+      break;
+    default:
+      break;
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* Compares the C library memcpy, memset, memmove, memcmp and strlen with
+* string instructions, AVX2 loops and streaming stores from one byte to
+* 1 GiB, aligned and misaligned. A second file lists the sizes where the
+* fastest implementation of an operation changes.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Memory(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Operation, Implementation, Alignment, Bytes, Repetitions, Time for Operations, "
+                            "Nanoseconds per Call, Bytes per Cycle, Gigabytes per Second, Verified";
+  const char crossoverHeader[] = "Operation, Alignment, Bytes, Previous Fastest, Fastest, Previous Bytes per Cycle, "
+                                 "Bytes per Cycle";
+  const size_t offsets[ma_count_e][2] = {{0, 0}, {MEMORY_MISALIGN_SOURCE, MEMORY_MISALIGN_DESTINATION}};
+  size_t bytesFirst = (options.iterations > 0) ? options.iterations : MEMORY_BYTES_MIN;
+  size_t bytesLast = (options.iterations > 0) ? options.iterations : MEMORY_BYTES_MAX;
+  size_t sourceBytes, destinationBytes, repetitions, shift;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE], crossoverNameAbsolute[CHAR_BUFFER_SIZE];
+  bool isVectorAvailable = false, isValid, hasPrevious[ma_count_e][mp_count_e] = {};
+  memoryImplementation_et fastest, fastestPrevious[ma_count_e][mp_count_e];
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double timeStart, timeDelta, bytesPerCycle, bytesPerCycleBest, bytesPerCyclePrevious[ma_count_e][mp_count_e];
+  volatile int64_t memorySink = 0;
+  uint64_t cycleStart, cycleDelta;
+  uint8_t *sourceBuffer, *destinationBuffer, *source, *destination;
+  FILE *fileContext, *crossoverContext;
+
+#if MEMORY_EXTENSION_ENABLE
+  isVectorAvailable = __builtin_cpu_supports("avx2");
+#endif // MEMORY_EXTENSION_ENABLE
+  if (!isVectorAvailable) {
+    printf("AVX2 is not available, the vector and streaming variants are skipped.\n");
+  }
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  // The moves need the operation size plus half of it again in one region.
+  sourceBytes = (bytesLast + 2 * ROOFLINE_VECTOR_BYTES) & ~((size_t) ROOFLINE_VECTOR_BYTES - 1);
+  destinationBytes = (bytesLast + bytesLast / 2 + 3 * ROOFLINE_VECTOR_BYTES) & ~((size_t) ROOFLINE_VECTOR_BYTES - 1);
+  sourceBuffer = (uint8_t *) aligned_alloc(ROOFLINE_VECTOR_BYTES, sourceBytes);
+  destinationBuffer = (uint8_t *) aligned_alloc(ROOFLINE_VECTOR_BYTES, destinationBytes);
+  if ((NULL == sourceBuffer) || (NULL == destinationBuffer)) {
+    printf("Unable to allocate %zu bytes for the memory buffers.\n", sourceBytes + destinationBytes);
+    free(sourceBuffer);
+    free(destinationBuffer);
+    return EXIT_FAILURE;
+  }
+  // Fault every page in before any measurement.
+  memset(sourceBuffer, 0, sourceBytes);
+  memset(destinationBuffer, 0, destinationBytes);
+  fileContext = resultFileOpen("Memory", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    free(sourceBuffer);
+    free(destinationBuffer);
+    return EXIT_FAILURE;
+  }
+  crossoverContext = resultFileOpen("MemoryCrossover", crossoverHeader, false, crossoverNameAbsolute);
+  if (NULL == crossoverContext) {
+    resultFileClose(fileContext, fileNameAbsolute);
+    free(sourceBuffer);
+    free(destinationBuffer);
+    return EXIT_FAILURE;
+  }
+  for (size_t bytes = bytesFirst; bytes <= bytesLast; bytes *= MEMORY_BYTES_STEP) {
+    repetitions = (bytes < MEMORY_BYTES_PER_MEASUREMENT) ? (MEMORY_BYTES_PER_MEASUREMENT / bytes) : 1;
+    repetitions = (repetitions < MEMORY_CALLS_MAX) ? repetitions : MEMORY_CALLS_MAX;
+    shift = (bytes > 1) ? (bytes / 2) : 1;
+    for (size_t alignment = 0; alignment < ma_count_e; alignment++) {
+      for (size_t op = 0; op < mp_count_e; op++) {
+        fastest = mi_libc_e;
+        bytesPerCycleBest = 0.0;
+        for (size_t implementation = 0; implementation < mi_count_e; implementation++) {
+          if (!memoryIsImplemented((memoryOp_et) op, (memoryImplementation_et) implementation) ||
+              ((mi_libc_e != implementation) && (mi_repString_e != implementation) && !isVectorAvailable)) {
+            continue;
+          }
+          source = sourceBuffer + offsets[alignment][0];
+          destination = destinationBuffer + offsets[alignment][1];
+          memoryPrepare((memoryOp_et) op, destination, source, bytes, shift);
+          if (mp_memmoveDown_e == op) {
+            source = destination + shift;
+          }
+          if (mp_memmoveUp_e == op) {
+            source = destination;
+            destination = source + shift;
+          }
+          memorySink = memoryRun((memoryOp_et) op, (memoryImplementation_et) implementation, destination, source,
+                                 bytes);
+          isValid = memoryVerify((memoryOp_et) op, (mp_memmoveUp_e == op) ? source : destination, source, bytes,
+                                 shift, memorySink);
+          frequencyStart = frequencyMonitorRead(harnessMonitor);
+          timeStart = getTime();
+          cycleStart = getCycleCount();
+          for (size_t repetition = 0; repetition < repetitions; repetition++) {
+            memorySink = memoryRun((memoryOp_et) op, (memoryImplementation_et) implementation, destination, source,
+                                   bytes);
+          }
+          cycleDelta = getCycleCount() - cycleStart;
+          timeDelta = getTime() - timeStart;
+          frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+          bytesPerCycle = (cycleDelta > 0) ? ((double) bytes * (double) repetitions / (double) cycleDelta) : 0.0;
+          if (bytesPerCycle > bytesPerCycleBest) {
+            bytesPerCycleBest = bytesPerCycle;
+            fastest = (memoryImplementation_et) implementation;
+          }
+          resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %zu, %zu, %f, %f, %f, %f, %d",
+                         memoryOpName((memoryOp_et) op),
+                         memoryImplementationName((memoryImplementation_et) implementation),
+                         memoryAlignmentName((memoryAlignment_et) alignment), bytes, repetitions, timeDelta,
+                         (timeDelta * 1e9) / (double) repetitions, bytesPerCycle,
+                         (timeDelta > 0.0) ? ((double) bytes * (double) repetitions / timeDelta / 1e9) : 0.0,
+                         isValid ? 1 : 0);
+        }
+        if (hasPrevious[alignment][op] && (fastest != fastestPrevious[alignment][op])) {
+          resultPrintRow(crossoverContext, false, NULL, "%s, %s, %zu, %s, %s, %f, %f", memoryOpName((memoryOp_et) op),
+                         memoryAlignmentName((memoryAlignment_et) alignment), bytes,
+                         memoryImplementationName(fastestPrevious[alignment][op]), memoryImplementationName(fastest),
+                         bytesPerCyclePrevious[alignment][op], bytesPerCycleBest);
+        }
+        hasPrevious[alignment][op] = true;
+        fastestPrevious[alignment][op] = fastest;
+        bytesPerCyclePrevious[alignment][op] = bytesPerCycleBest;
+      }
+    }
+  }
+  resultFileClose(crossoverContext, crossoverNameAbsolute);
+  resultFileClose(fileContext, fileNameAbsolute);
+  free(sourceBuffer);
+  free(destinationBuffer);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKMEMORY_HPP_
@@ -0,0 +1,364 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKNOISE_HPP_
+#define _CPUBENCHMARKNOISE_HPP_
+
+#include <algorithm>
+#include <functional>
+
+#define NOISE_QUANTA_DEFAULT (1 << 15) // Quanta per method and core, -n overrides
+#define NOISE_UNIT_STEPS 32 // Dependent multiply add steps in one work unit
+#define NOISE_FWQ_UNITS 256 // Work units in one fixed work quantum, about ten microseconds
+#define NOISE_FTQ_NANOSECONDS 50000 // Length of one fixed time quantum
+#define NOISE_THRESHOLD_NANOSECONDS 2000 // Lost time above which a quantum counts as interrupted
+#define NOISE_BASELINE_PERMILLE 10 // Rank of the undisturbed quantum, a few fast outliers do not set the baseline
+#define NOISE_EVENTS_MAX (1 << 12) // Interruptions kept per method and core, the rest are only counted
+#define NOISE_HISTOGRAM_BUCKETS 32 // Power of two nanosecond buckets of lost time
+#define NOISE_CALIBRATE_SECONDS 0.1 // Wall time used to convert time stamp counter cycles to nanoseconds
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum noiseMethod_e {
+  nm_fixedWork_e = 0, // FWQ, time a fixed amount of work, lost time is the excess over the baseline quantum
+  nm_fixedTime_e = 1, // FTQ, count work in a fixed time window, lost time is the shortfall from the baseline window
+  nm_count_e = 2
+} noiseMethod_et;
+
+typedef struct alignas(CACHE_LINE_SIZE) noiseThread {
+  noiseMethod_et method; // Work loop to run
+  size_t quanta; // Quanta to run
+  uint64_t quantumCycles; // Fixed time quantum length in time stamp counter cycles
+  uint64_t *quantumStart; // Per quantum start in cycles, fixed work only
+  uint64_t *quantumValue; // Per quantum cycles for fixed work, work units for fixed time
+  uint64_t workSink; // Result of the work units, keeps them alive
+  pthread_barrier_t *startBarrier; // Releases all cores at once
+  uint64_t cycleStart; // Cycle count when the thread passed the barrier
+  double timeDelta; // Time for all quanta
+} noiseThread_t;
+
+typedef struct noiseEvent {
+  uint64_t timestamp; // Nanoseconds since the start of the method
+  uint64_t lost; // Nanoseconds lost in the quantum
+} noiseEvent_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *noiseMethodName(noiseMethod_et method);
+
+uint64_t noiseWorkUnit(uint64_t value);
+
+double noiseCyclesPerNanosecond(void);
+
+bool noiseCpuListContains(const char *fileName, size_t core);
+
+void *noiseQuanta_Pthread(void *inArgs);
+
+size_t noiseHistogramBucket(uint64_t lost);
+
+int testharness_Noise(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the method.
+*****************************************************************************/
+const char *noiseMethodName(noiseMethod_et method) {
+  const char *methodName;
+  switch (method) {
+    case nm_fixedWork_e:
+      methodName = "fixed_work_quantum";
+      break;
+    case nm_fixedTime_e:
+      methodName = "fixed_time_quantum";
+      break;
+    default:
+      methodName = "unknown";
+      break;
+  }
+  return methodName;
+}
+
+/******************************************************************************
+* A dependent chain of multiply adds, the same amount of work every call and
+* no memory traffic to add noise of its own.
+* @return  the advanced value.
+*****************************************************************************/
+inline uint64_t noiseWorkUnit(uint64_t value) {
+  for (size_t step = 0; step < NOISE_UNIT_STEPS; step++) {
+    value = (value * 6364136223846793005ULL) + 1442695040888963407ULL;
+  }
+  return value;
+}
+
+/******************************************************************************
+* Spins against the wall clock to convert time stamp counter cycles.
+* @return  cycles per nanosecond.
+*****************************************************************************/
+double noiseCyclesPerNanosecond(void) {
+  double timeStart = getTime(), timeDelta;
+  uint64_t cycleStart = getCycleCount();
+
+  do {
+    timeDelta = getTime() - timeStart;
+  } while (timeDelta < NOISE_CALIBRATE_SECONDS);
+  return (double) (getCycleCount() - cycleStart) / (timeDelta * 1e9);
+}
+
+/******************************************************************************
+* Parses a kernel cpu list such as "1-3,6" from sysfs.
+* @return  true when the core is in the list, false when it is not or the
+*          file is missing.
+*****************************************************************************/
+bool noiseCpuListContains(const char *fileName, size_t core) {
+  char lineBuffer[CHAR_BUFFER_SIZE];
+  bool isContained = false;
+  unsigned long first, last;
+  char *cursor, *next;
+  FILE *listContext;
+
+  listContext = fopen(fileName, "r");
+  if (NULL == listContext) {
+    return false;
+  }
+  if (NULL != fgets(lineBuffer, sizeof(lineBuffer), listContext)) {
+    cursor = lineBuffer;
+    while (!isContained && isdigit((unsigned char) *cursor)) {
+      first = strtoul(cursor, &next, 10);
+      last = first;
+      if ('-' == *next) {
+        last = strtoul(next + 1, &next, 10);
+      }
+      isContained = (core >= first) && (core <= last);
+      cursor = (',' == *next) ? (next + 1) : next;
+    }
+  }
+  fclose(listContext);
+  return isContained;
+}
+
+/******************************************************************************
+* Runs the quanta of one method on a pinned core and keeps the raw values,
+* the analysis happens after every core is done.
+* @return  the thread arguments.
+*****************************************************************************/
+void *noiseQuanta_Pthread(void *inArgs) {
+  noiseThread_t *threadInfo = (noiseThread_t *) inArgs;
+  uint64_t value = (uint64_t) (uintptr_t) inArgs;
+  uint64_t cycleNow, quantumEnd, units;
+  double timeStart;
+
+  pthread_barrier_wait(threadInfo->startBarrier);
+  timeStart = getTime();
+  threadInfo->cycleStart = getCycleCount();
+  if (nm_fixedWork_e == threadInfo->method) {
+    for (size_t quantum = 0; quantum < threadInfo->quanta; quantum++) {
+      cycleNow = getCycleCount();
+      for (size_t unit = 0; unit < NOISE_FWQ_UNITS; unit++) {
+        value = noiseWorkUnit(value);
+      }
+      threadInfo->quantumStart[quantum] = cycleNow;
+      threadInfo->quantumValue[quantum] = getCycleCount() - cycleNow;
+    }
+  } else {
+    // Windows follow each other on a fixed grid, an interruption that spans a boundary shortens both.
+    quantumEnd = threadInfo->cycleStart;
+    for (size_t quantum = 0; quantum < threadInfo->quanta; quantum++) {
+      quantumEnd += threadInfo->quantumCycles;
+      units = 0;
+      do {
+        value = noiseWorkUnit(value);
+        units++;
+      } while (getCycleCount() < quantumEnd);
+      threadInfo->quantumValue[quantum] = units;
+    }
+  }
+  threadInfo->timeDelta = getTime() - timeStart;
+  threadInfo->workSink = value;
+  return inArgs;
+}
+
+/******************************************************************************
+* Bucket 0 holds less than 2 ns, bucket b holds [2^b, 2^(b+1)) ns.
+* @return  histogram bucket of the lost time.
+*****************************************************************************/
+size_t noiseHistogramBucket(uint64_t lost) {
+  size_t bucket = (lost < 2) ? 0 : (size_t) (63 - __builtin_clzll(lost));
+  return (bucket < NOISE_HISTOGRAM_BUCKETS) ? bucket : (NOISE_HISTOGRAM_BUCKETS - 1);
+}
+
+/******************************************************************************
+* Runs fixed work and fixed time quanta on every allowed core at once, each
+* thread pinned to its core. A quantum that loses more than the threshold
+* against the baseline quantum of its core is an interruption and is written
+* with its timestamp and lost time; all quanta go into per core power of two
+* histograms. A core is quiet when no quantum crossed the threshold, which is
+* what an isolated (isolcpus, nohz_full) core should show before other
+* families are trusted on it.
+* @return EXIT_SUCCESS when every core ran.
+*****************************************************************************/
+int testharness_Noise(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Method, Core, Isolated, No HZ Full, Quanta, Quantum Nanoseconds, Time for Quanta, "
+                            "Mean Lost Nanoseconds, Max Lost Nanoseconds, Noise Fraction, Interruptions, "
+                            "Dropped Interruptions, Quiet";
+  const char histogramHeader[] = "Method, Core, Bucket Low Nanoseconds, Bucket High Nanoseconds, Quanta";
+  const char eventHeader[] = "Method, Core, Timestamp Nanoseconds, Lost Nanoseconds";
+  size_t quanta = (options.iterations > 0) ? options.iterations : NOISE_QUANTA_DEFAULT;
+  size_t threadCount = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE], histogramNameAbsolute[CHAR_BUFFER_SIZE];
+  char eventNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext, *histogramContext, *eventContext;
+  std::vector<noiseThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  std::vector<uint64_t> quantumStart(threadCount * quanta), quantumValue(threadCount * quanta);
+  std::vector<uint64_t> sortedValues(quanta), histogram(NOISE_HISTOGRAM_BUCKETS);
+  size_t baselineRank = (quanta * NOISE_BASELINE_PERMILLE) / 1000;
+  std::vector<noiseEvent_t> events;
+  pthread_barrier_t startBarrier;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double cyclesPerNanosecond, unitNanoseconds, quantumNanoseconds, lostSum, lostNanoseconds, lostMax;
+  uint64_t baselineValue;
+  volatile uint64_t workSink = 0;
+  size_t interruptions, core, noisyCores;
+  bool isIsolated, isNoHzFull, isValid = true;
+
+  cyclesPerNanosecond = noiseCyclesPerNanosecond();
+  printf("Time stamp counter %f cycles per nanosecond, threshold %d ns.\n", cyclesPerNanosecond,
+         NOISE_THRESHOLD_NANOSECONDS);
+  fileContext = resultFileOpen("Noise", fileHeader, true, fileNameAbsolute);
+  histogramContext = resultFileOpen("NoiseHistogram", histogramHeader, false, histogramNameAbsolute);
+  eventContext = resultFileOpen("NoiseEvents", eventHeader, false, eventNameAbsolute);
+  if ((NULL == fileContext) || (NULL == histogramContext) || (NULL == eventContext)) {
+    if (NULL != fileContext) {
+      resultFileClose(fileContext, fileNameAbsolute);
+    }
+    if (NULL != histogramContext) {
+      resultFileClose(histogramContext, histogramNameAbsolute);
+    }
+    return EXIT_FAILURE;
+  }
+  for (size_t method = 0; method < nm_count_e; method++) {
+    pthread_barrier_init(&startBarrier, NULL, threadCount);
+    for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+      threadInfo[threadIndex].method = (noiseMethod_et) method;
+      threadInfo[threadIndex].quanta = quanta;
+      threadInfo[threadIndex].quantumCycles = (uint64_t) (NOISE_FTQ_NANOSECONDS * cyclesPerNanosecond);
+      threadInfo[threadIndex].quantumStart = &quantumStart[threadIndex * quanta];
+      threadInfo[threadIndex].quantumValue = &quantumValue[threadIndex * quanta];
+      threadInfo[threadIndex].workSink = 0;
+      threadInfo[threadIndex].startBarrier = &startBarrier;
+      threadInfo[threadIndex].cycleStart = 0;
+      threadInfo[threadIndex].timeDelta = 0.0;
+      threadArgs[threadIndex] = &threadInfo[threadIndex];
+    }
+    // The frequency monitor thread would wake on the measured cores every sample period.
+    frequencyStart = frequencyMonitorRead(harnessMonitor);
+    frequencyMonitorPause(harnessMonitor, true);
+    isValid &= threadTeamRun(noiseQuanta_Pthread, threadArgs, true);
+    frequencyMonitorPause(harnessMonitor, false);
+    frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+    pthread_barrier_destroy(&startBarrier);
+
+    noisyCores = 0;
+    for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+      const uint64_t *values = threadInfo[threadIndex].quantumValue;
+      core = threadCoreSelect(threadIndex);
+      workSink ^= threadInfo[threadIndex].workSink;
+      // The quantum ranked one percent from the best is taken as undisturbed.
+      std::copy(values, values + quanta, sortedValues.begin());
+      if (nm_fixedWork_e == method) {
+        std::nth_element(sortedValues.begin(), sortedValues.begin() + baselineRank, sortedValues.end());
+      } else {
+        std::nth_element(sortedValues.begin(), sortedValues.begin() + baselineRank, sortedValues.end(),
+                         std::greater<uint64_t>());
+      }
+      baselineValue = sortedValues[baselineRank];
+      // A fixed time unit costs the window over the baseline count.
+      if (nm_fixedWork_e == method) {
+        quantumNanoseconds = (double) baselineValue / cyclesPerNanosecond;
+        unitNanoseconds = 0.0;
+      } else {
+        quantumNanoseconds = NOISE_FTQ_NANOSECONDS;
+        unitNanoseconds = quantumNanoseconds / (double) std::max<uint64_t>(baselineValue, 1);
+      }
+      std::fill(histogram.begin(), histogram.end(), 0);
+      events.clear();
+      interruptions = 0;
+      lostSum = 0.0;
+      lostMax = 0.0;
+      for (size_t quantum = 0; quantum < quanta; quantum++) {
+        if (nm_fixedWork_e == method) {
+          lostNanoseconds = (double) ((values[quantum] > baselineValue) ? (values[quantum] - baselineValue) : 0) /
+                            cyclesPerNanosecond;
+        } else {
+          lostNanoseconds = (double) ((values[quantum] < baselineValue) ? (baselineValue - values[quantum]) : 0) *
+                            unitNanoseconds;
+        }
+        lostSum += lostNanoseconds;
+        lostMax = std::max(lostMax, lostNanoseconds);
+        histogram[noiseHistogramBucket((uint64_t) lostNanoseconds)]++;
+        if (lostNanoseconds > NOISE_THRESHOLD_NANOSECONDS) {
+          interruptions++;
+          if (events.size() < NOISE_EVENTS_MAX) {
+            noiseEvent_t event;
+            if (nm_fixedWork_e == method) {
+              event.timestamp = (uint64_t) ((double) (threadInfo[threadIndex].quantumStart[quantum] -
+                                                      threadInfo[threadIndex].cycleStart) / cyclesPerNanosecond);
+            } else {
+              event.timestamp = (uint64_t) (quantum * quantumNanoseconds);
+            }
+            event.lost = (uint64_t) lostNanoseconds;
+            events.push_back(event);
+          }
+        }
+      }
+      isIsolated = noiseCpuListContains("/sys/devices/system/cpu/isolated", core);
+      isNoHzFull = noiseCpuListContains("/sys/devices/system/cpu/nohz_full", core);
+      noisyCores += (interruptions > 0) ? 1 : 0;
+      resultPrintRow(fileContext, true, &frequency, "%s, %zu, %d, %d, %zu, %f, %f, %f, %f, %f, %zu, %zu, %d",
+                     noiseMethodName((noiseMethod_et) method), core, isIsolated ? 1 : 0, isNoHzFull ? 1 : 0, quanta,
+                     quantumNanoseconds, threadInfo[threadIndex].timeDelta, lostSum / (double) quanta, lostMax,
+                     lostSum / (threadInfo[threadIndex].timeDelta * 1e9), interruptions,
+                     interruptions - events.size(), (0 == interruptions) ? 1 : 0);
+      for (size_t bucket = 0; bucket < NOISE_HISTOGRAM_BUCKETS; bucket++) {
+        if (histogram[bucket] > 0) {
+          resultPrintRow(histogramContext, false, NULL, "%s, %zu, %llu, %llu, %lu",
+                         noiseMethodName((noiseMethod_et) method), core, (0 == bucket) ? 0ULL : (1ULL << bucket),
+                         1ULL << (bucket + 1), histogram[bucket]);
+        }
+      }
+      for (size_t event = 0; event < events.size(); event++) {
+        resultPrintRow(eventContext, false, NULL, "%s, %zu, %lu, %lu", noiseMethodName((noiseMethod_et) method),
+                       core, events[event].timestamp, events[event].lost);
+      }
+    }
+    printf("%s: %zu of %zu cores interrupted for more than %d ns.\n", noiseMethodName((noiseMethod_et) method),
+           noisyCores, threadCount, NOISE_THRESHOLD_NANOSECONDS);
+  }
+  resultFileClose(eventContext, eventNameAbsolute);
+  resultFileClose(histogramContext, histogramNameAbsolute);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return isValid ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#endif // _CPUBENCHMARKNOISE_HPP_
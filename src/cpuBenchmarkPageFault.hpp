@@ -0,0 +1,367 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKPAGEFAULT_HPP_
+#define _CPUBENCHMARKPAGEFAULT_HPP_
+
+// Virtual memory calls are Linux specific.
+#if !(defined(_WIN32) | defined(_WIN64))
+#define PAGEFAULT_ENABLE 1
+#include <sys/mman.h>
+#include <sys/resource.h>
+#else
+#define PAGEFAULT_ENABLE 0
+#endif
+
+#define PAGEFAULT_REGION_BYTES (1ULL << 30) // Memory faulted per measurement, split over the threads, -n overrides
+#define PAGEFAULT_HUGE_BYTES (1ULL << 21) // Transparent huge page size, slices are multiples of it
+#define PAGEFAULT_CHURN_BYTES (1ULL << 18) // Mapping size of the map, touch, unmap churn
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum pageFaultScenario_e {
+  pf_firstTouchSmall_e = 0, // Write one byte per base page of a fresh mapping, huge pages disabled
+  pf_firstTouchHuge_e = 1, // Same on a huge page aligned mapping with MADV_HUGEPAGE
+  pf_mmapChurn_e = 2, // Each thread maps, touches and unmaps PAGEFAULT_CHURN_BYTES at a time
+  pf_dontneedRefault_e = 3, // MADV_DONTNEED on a faulted slice, then touch it again
+  pf_mlock_e = 4, // mlock of a fresh slice, which faults every page in
+  pf_populate_e = 5, // Each thread maps and prefaults its slice, then touches it
+  pf_count_e = 6
+} pageFaultScenario_et;
+
+typedef struct alignas(CACHE_LINE_SIZE) pageFaultThread {
+  pageFaultScenario_et scenario; // Scenario under test
+  uint8_t *slice; // Part of the shared region, or the own mapping of the populate scenario
+  size_t sliceBytes; // Bytes of the slice
+  size_t pageBytes; // Base page size
+  pthread_barrier_t *startBarrier; // Releases all threads at once
+  bool isValid; // Every system call succeeded
+  double timeDelta; // Time for the scenario
+} pageFaultThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *pageFaultScenarioName(pageFaultScenario_et scenario);
+
+#if PAGEFAULT_ENABLE
+void pageFaultTouch(uint8_t *address, size_t bytes, size_t pageBytes);
+
+uint64_t pageFaultMinorCount(void);
+
+size_t pageFaultHugeBytes(void);
+
+void *pageFault_Pthread(void *inArgs);
+
+void pageFaultMeasure(FILE *fileContext, pageFaultScenario_et scenario, size_t threadCount, size_t regionBytes);
+#endif // PAGEFAULT_ENABLE
+
+int testharness_PageFault(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the scenario.
+*****************************************************************************/
+const char *pageFaultScenarioName(pageFaultScenario_et scenario) {
+  const char *scenarioName;
+  switch (scenario) {
+    case pf_firstTouchSmall_e:
+      scenarioName = "first_touch_4k";
+      break;
+    case pf_firstTouchHuge_e:
+      scenarioName = "first_touch_thp";
+      break;
+    case pf_mmapChurn_e:
+      scenarioName = "mmap_munmap_churn";
+      break;
+    case pf_dontneedRefault_e:
+      scenarioName = "madvise_dontneed_refault";
+      break;
+    case pf_mlock_e:
+      scenarioName = "mlock";
+      break;
+    case pf_populate_e:
+      scenarioName = "map_populate";
+      break;
+    default:
+      scenarioName = "unknown";
+      break;
+  }
+  return scenarioName;
+}
+
+#if PAGEFAULT_ENABLE
+/******************************************************************************
+* Writes one byte per page, a write fault maps a private page where a read
+* would map the shared zero page.
+* @return  None
+*****************************************************************************/
+void pageFaultTouch(uint8_t *address, size_t bytes, size_t pageBytes) {
+  volatile uint8_t *page = address;
+
+  for (size_t offset = 0; offset < bytes; offset += pageBytes) {
+    page[offset] = 1;
+  }
+  return;
+}
+
+/******************************************************************************
+* Counts the whole process, so it includes every thread of the team.
+* @return  minor page faults so far.
+*****************************************************************************/
+uint64_t pageFaultMinorCount(void) {
+  struct rusage usage;
+
+  if (0 != getrusage(RUSAGE_SELF, &usage)) {
+    return 0;
+  }
+  return (uint64_t) usage.ru_minflt;
+}
+
+/******************************************************************************
+* Reads AnonHugePages of the process from /proc/self/smaps_rollup.
+* @return  bytes of anonymous memory mapped by huge pages, 0 when unknown.
+*****************************************************************************/
+size_t pageFaultHugeBytes(void) {
+  char lineBuffer[CHAR_BUFFER_SIZE];
+  size_t kilobytes = 0;
+  FILE *smapsContext;
+
+  smapsContext = fopen("/proc/self/smaps_rollup", "r");
+  if (NULL == smapsContext) {
+    return 0;
+  }
+  while (NULL != fgets(lineBuffer, sizeof(lineBuffer), smapsContext)) {
+    if (1 == sscanf(lineBuffer, "AnonHugePages: %zu kB", &kilobytes)) {
+      break;
+    }
+  }
+  fclose(smapsContext);
+  return kilobytes * 1024;
+}
+
+/******************************************************************************
+* Runs the scenario on the thread's slice.
+* @return  the thread arguments.
+*****************************************************************************/
+void *pageFault_Pthread(void *inArgs) {
+  pageFaultThread_t *threadInfo = (pageFaultThread_t *) inArgs;
+  uint8_t *mapping;
+  double timeStart;
+  bool isMapPopulate;
+
+  threadInfo->isValid = true;
+  pthread_barrier_wait(threadInfo->startBarrier);
+  timeStart = getTime();
+  switch (threadInfo->scenario) {
+    case pf_mmapChurn_e:
+      for (size_t offset = 0; offset < threadInfo->sliceBytes; offset += PAGEFAULT_CHURN_BYTES) {
+        mapping = (uint8_t *) mmap(NULL, PAGEFAULT_CHURN_BYTES, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                   -1, 0);
+        if (MAP_FAILED == mapping) {
+          threadInfo->isValid = false;
+          break;
+        }
+        madvise(mapping, PAGEFAULT_CHURN_BYTES, MADV_NOHUGEPAGE);
+        pageFaultTouch(mapping, PAGEFAULT_CHURN_BYTES, threadInfo->pageBytes);
+        threadInfo->isValid = (0 == munmap(mapping, PAGEFAULT_CHURN_BYTES)) && threadInfo->isValid;
+      }
+      break;
+    case pf_dontneedRefault_e:
+      threadInfo->isValid = (0 == madvise(threadInfo->slice, threadInfo->sliceBytes, MADV_DONTNEED));
+      pageFaultTouch(threadInfo->slice, threadInfo->sliceBytes, threadInfo->pageBytes);
+      break;
+    case pf_mlock_e:
+      threadInfo->isValid = (0 == mlock(threadInfo->slice, threadInfo->sliceBytes));
+      break;
+    case pf_populate_e:
+#if defined(MADV_POPULATE_WRITE)
+      // MAP_POPULATE faults before a hint can be given, so huge pages are disabled first and the prefault follows.
+      mapping = (uint8_t *) mmap(NULL, threadInfo->sliceBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                 -1, 0);
+      isMapPopulate = false;
+      if ((MAP_FAILED != mapping) &&
+          ((0 != madvise(mapping, threadInfo->sliceBytes, MADV_NOHUGEPAGE)) ||
+           (0 != madvise(mapping, threadInfo->sliceBytes, MADV_POPULATE_WRITE)))) {
+        // Kernels before 5.14 reject MADV_POPULATE_WRITE with EINVAL, those prefault through MAP_POPULATE.
+        isMapPopulate = (EINVAL == errno);
+        munmap(mapping, threadInfo->sliceBytes);
+        mapping = (uint8_t *) MAP_FAILED;
+      }
+#else // !defined(MADV_POPULATE_WRITE)
+      isMapPopulate = true;
+#endif // defined(MADV_POPULATE_WRITE)
+      if (isMapPopulate) {
+        mapping = (uint8_t *) mmap(NULL, threadInfo->sliceBytes, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_ANONYMOUS | MAP_POPULATE, -1, 0);
+      }
+      if (MAP_FAILED == mapping) {
+        threadInfo->isValid = false;
+        threadInfo->slice = NULL;
+      } else {
+        pageFaultTouch(mapping, threadInfo->sliceBytes, threadInfo->pageBytes);
+        threadInfo->slice = mapping;
+      }
+      break;
+    case pf_firstTouchSmall_e:
+    case pf_firstTouchHuge_e:
+    default:
+      pageFaultTouch(threadInfo->slice, threadInfo->sliceBytes, threadInfo->pageBytes);
+      break;
+  }
+  threadInfo->timeDelta = getTime() - timeStart;
+  return inArgs;
+}
+
+/******************************************************************************
+* Maps the shared region, prepares it for the scenario and runs the team on
+* equal slices. Huge pages are disabled except for the huge page scenario so
+* the other scenarios measure base pages whatever the system THP setting.
+* @return  None
+*****************************************************************************/
+void pageFaultMeasure(FILE *fileContext, pageFaultScenario_et scenario, size_t threadCount, size_t regionBytes) {
+  const size_t pageBytes = (size_t) sysconf(_SC_PAGESIZE);
+  size_t sliceBytes = (regionBytes / threadCount) & ~(PAGEFAULT_HUGE_BYTES - 1);
+  size_t hugeBytesBefore, hugeBytes = 0, pages;
+  std::vector<pageFaultThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  pthread_barrier_t startBarrier;
+  uint8_t *mapping = NULL, *region = NULL;
+  uint64_t faultsBefore, faults;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency = frequencyUnknown;
+  double timeDelta = 0.0;
+  bool isValid;
+
+  sliceBytes = (sliceBytes > 0) ? sliceBytes : PAGEFAULT_HUGE_BYTES;
+  regionBytes = sliceBytes * threadCount;
+  pages = regionBytes / pageBytes;
+  hugeBytesBefore = pageFaultHugeBytes();
+  // The own mappings of churn and populate need no shared region, the others get one aligned to a huge page.
+  isValid = true;
+  if ((pf_mmapChurn_e != scenario) && (pf_populate_e != scenario)) {
+    mapping = (uint8_t *) mmap(NULL, regionBytes + PAGEFAULT_HUGE_BYTES, PROT_READ | PROT_WRITE,
+                               MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    isValid = (MAP_FAILED != mapping);
+    if (isValid) {
+      region = (uint8_t *) (((uintptr_t) mapping + PAGEFAULT_HUGE_BYTES - 1) & ~(uintptr_t) (PAGEFAULT_HUGE_BYTES - 1));
+      madvise(region, regionBytes, (pf_firstTouchHuge_e == scenario) ? MADV_HUGEPAGE : MADV_NOHUGEPAGE);
+      if (pf_dontneedRefault_e == scenario) {
+        pageFaultTouch(region, regionBytes, pageBytes);
+      }
+    }
+  }
+  if (!isValid) {
+    resultPrintRow(fileContext, true, &frequency, "%s, %zu, %zu, %zu, %f, %lu, %f, %f, %zu, %d",
+                   pageFaultScenarioName(scenario), threadCount, regionBytes, pages, 0.0, (uint64_t) 0, 0.0, 0.0,
+                   (size_t) 0, 0);
+    return;
+  }
+  pthread_barrier_init(&startBarrier, NULL, threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    threadInfo[threadIndex].scenario = scenario;
+    threadInfo[threadIndex].slice = (NULL != region) ? (region + threadIndex * sliceBytes) : NULL;
+    threadInfo[threadIndex].sliceBytes = sliceBytes;
+    threadInfo[threadIndex].pageBytes = pageBytes;
+    threadInfo[threadIndex].startBarrier = &startBarrier;
+    threadInfo[threadIndex].isValid = false;
+    threadInfo[threadIndex].timeDelta = 0.0;
+    threadArgs[threadIndex] = &threadInfo[threadIndex];
+  }
+  faultsBefore = pageFaultMinorCount();
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  isValid = threadTeamRun(pageFault_Pthread, threadArgs, true);
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  faults = pageFaultMinorCount() - faultsBefore;
+  pthread_barrier_destroy(&startBarrier);
+  hugeBytes = pageFaultHugeBytes();
+  hugeBytes = (hugeBytes > hugeBytesBefore) ? (hugeBytes - hugeBytesBefore) : 0;
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    timeDelta = std::max(timeDelta, threadInfo[threadIndex].timeDelta);
+    isValid = isValid && threadInfo[threadIndex].isValid;
+    if ((pf_populate_e == scenario) && (NULL != threadInfo[threadIndex].slice)) {
+      munmap(threadInfo[threadIndex].slice, sliceBytes);
+    }
+    if ((pf_mlock_e == scenario) && threadInfo[threadIndex].isValid) {
+      munlock(threadInfo[threadIndex].slice, sliceBytes);
+    }
+  }
+  if (NULL != region) {
+    munmap(mapping, regionBytes + PAGEFAULT_HUGE_BYTES);
+  }
+  resultPrintRow(fileContext, true, &frequency, "%s, %zu, %zu, %zu, %f, %lu, %f, %f, %zu, %d",
+                 pageFaultScenarioName(scenario), threadCount, regionBytes, pages, timeDelta, faults,
+                 (timeDelta * 1e9) / (double) pages, (timeDelta * 1e3) / ((double) regionBytes / 1e9), hugeBytes,
+                 isValid ? 1 : 0);
+  return;
+}
+#endif // PAGEFAULT_ENABLE
+
+/******************************************************************************
+* Measures first touch faults with base and transparent huge pages, mmap and
+* munmap churn, MADV_DONTNEED refaults, mlock and prefaulting for thread
+* counts doubling up to the thread count. Cost is per base page and per
+* gigabyte of the region; mlock may fail under RLIMIT_MEMLOCK, its rows are
+* then marked invalid.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_PageFault(const benchmarkOptions_t &options) {
+#if PAGEFAULT_ENABLE
+  const char fileHeader[] = "Scenario, Threads, Region Bytes, Base Pages, Time for Operations, Minor Faults, "
+                            "Nanoseconds per Page, Milliseconds per Gigabyte, Huge Page Bytes, Verified";
+  size_t regionBytes = (options.iterations > 0) ? options.iterations : PAGEFAULT_REGION_BYTES;
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  char lineBuffer[CHAR_BUFFER_SIZE];
+  FILE *fileContext, *thpContext;
+
+  thpContext = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if ((NULL != thpContext) && (NULL != fgets(lineBuffer, sizeof(lineBuffer), thpContext))) {
+    printf("Transparent huge pages: %s", lineBuffer);
+  }
+  if (NULL != thpContext) {
+    fclose(thpContext);
+  }
+  fileContext = resultFileOpen("PageFault", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  for (size_t scenario = 0; scenario < pf_count_e; scenario++) {
+    for (size_t threadCount = 1; threadCount <= threadMax;) {
+      pageFaultMeasure(fileContext, (pageFaultScenario_et) scenario, threadCount, regionBytes);
+      if ((threadCount < threadMax) && ((2 * threadCount) > threadMax)) {
+        threadCount = threadMax;
+      } else {
+        threadCount *= 2;
+      }
+    }
+  }
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+#else // !PAGEFAULT_ENABLE
+  (void) options;
+  printf("The page fault family needs mmap, madvise and mlock.\n");
+  return EXIT_FAILURE;
+#endif // PAGEFAULT_ENABLE
+}
+
+#endif // _CPUBENCHMARKPAGEFAULT_HPP_
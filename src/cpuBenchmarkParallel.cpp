@@ -39,7 +39,10 @@ extern "C++" {
 #include <iostream>
 #include <limits.h>
 #include <pthread.h>
+#include <sched.h>
+#include <stdarg.h>
 #include <sys/stat.h>
+#include <string>
 #include <string.h>
 #include <stdio.h>
 #include <stdlib.h>
@@ -59,10 +62,27 @@ extern "C++" {
 
 #endif // defined(_WIN32) | defined(_WIN64)
 
+#if defined(__x86_64__) | defined(__i386__)
+#include <x86intrin.h>
+#endif // defined(__x86_64__) | defined(__i386__)
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#endif // defined(__linux__)
+
 #define ENABLE_DEBUG 0
 #define CHAR_BUFFER_SIZE 1024
 #define PATH_MAX 4096
 
+// Destructive interference granularity, used to keep per-thread state on its own cache line.
+// @note std::hardware_destructive_interference_size changes with -mtune, so GCC warns on its use in layouts.
+//       Build with -DCACHE_LINE_SIZE=128 for processors with adjacent line prefetch pairs.
+#ifndef CACHE_LINE_SIZE
+#define CACHE_LINE_SIZE 64
+#endif // CACHE_LINE_SIZE
+
 // Use (void) to silent unused warnings.
 #define assertm(exp, msg) assert(((void)msg, exp))
 
@@ -87,8 +107,12 @@ strerror(errno), \
   (uint64_t)tid) \
 
 #define OPERANDS_2_IN 2
+#define TYPELESS_VECTOR_LENGTH 64 // Elements of the dot product operand vectors, power of two.
+#define TYPELESS_HORNER_DEGREE 8 // Degree of the polynomial evaluated by Horner's rule.
 #define RESULTANTS_1_OUT 1
+#define TYPELESS_INT128_DIGITS 48 // Sign, 39 decimal digits and the terminator of a 128 bit integer, rounded up.
 #define ENABLE_BASIC_C_ALLOC 0
+#define ARENA_CHUNK_BYTES (1 << 16) // Default chunk of the run arena, larger requests get a chunk of their own
 
 /* Random Method Selection
  * 1=RAND based random number generator.
@@ -113,6 +137,149 @@ typedef enum fileState_e {
   fs_IsNotExecutable_vet = (1 << 8)
 } fileState_et;
 
+// Extended types, each enabled when the compiler provides it.
+#if defined(__SIZEOF_INT128__)
+#define TYPELESS_INT128_ENABLE 1
+typedef __int128 typelessInt128_t;
+typedef unsigned __int128 typelessUInt128_t;
+#else // !defined(__SIZEOF_INT128__)
+#define TYPELESS_INT128_ENABLE 0
+#endif // defined(__SIZEOF_INT128__)
+
+#if defined(__FLT16_MANT_DIG__)
+#define TYPELESS_FLOAT16_ENABLE 1
+typedef _Float16 typelessFloat16_t;
+#else // !defined(__FLT16_MANT_DIG__)
+#define TYPELESS_FLOAT16_ENABLE 0
+#endif // defined(__FLT16_MANT_DIG__)
+
+#if defined(__SIZEOF_FLOAT128__)
+#define TYPELESS_FLOAT128_ENABLE 1
+typedef __float128 typelessFloat128_t;
+#else // !defined(__SIZEOF_FLOAT128__)
+#define TYPELESS_FLOAT128_ENABLE 0
+#endif // defined(__SIZEOF_FLOAT128__)
+
+// bfloat16 arithmetic is native from GCC 13; older compilers only store __bf16, so operations round through float.
+#if defined(__BFLT16_MANT_DIG__)
+#define TYPELESS_BFLOAT16_NATIVE 1
+typedef __bf16 typelessBFloat16_t;
+#else // !defined(__BFLT16_MANT_DIG__)
+#define TYPELESS_BFLOAT16_NATIVE 0
+typedef struct typelessBFloat16 {
+  uint16_t bits; // Upper half of the binary32 encoding
+
+  typelessBFloat16() = default;
+
+  typelessBFloat16(long double value) {
+    float single = (float) value;
+    uint32_t encoding;
+    memcpy(&encoding, &single, sizeof(encoding));
+    if (std::isnan(single)) {
+      this->bits = (uint16_t) ((encoding >> 16) | 0x0040); // Quiet NaN
+    } else {
+      this->bits = (uint16_t) ((encoding + 0x7FFF + ((encoding >> 16) & 1)) >> 16); // Round to nearest even
+    }
+  }
+
+  float toFloat() const {
+    uint32_t encoding = (uint32_t) this->bits << 16;
+    float single;
+    memcpy(&single, &encoding, sizeof(single));
+    return single;
+  }
+
+  operator long double() const {
+    return this->toFloat();
+  }
+
+  typelessBFloat16 operator+(typelessBFloat16 rhs) const {
+    return typelessBFloat16(this->toFloat() + rhs.toFloat());
+  }
+
+  typelessBFloat16 operator-(typelessBFloat16 rhs) const {
+    return typelessBFloat16(this->toFloat() - rhs.toFloat());
+  }
+
+  typelessBFloat16 operator*(typelessBFloat16 rhs) const {
+    return typelessBFloat16(this->toFloat() * rhs.toFloat());
+  }
+
+  typelessBFloat16 operator/(typelessBFloat16 rhs) const {
+    return typelessBFloat16(this->toFloat() / rhs.toFloat());
+  }
+} typelessBFloat16_t;
+#endif // defined(__BFLT16_MANT_DIG__)
+
+// Product and quotient width of the fixed point storage types.
+template<class storageType>
+struct typelessFixedWide;
+
+template<>
+struct typelessFixedWide<int16_t> {
+  typedef int32_t type;
+};
+
+template<>
+struct typelessFixedWide<int32_t> {
+  typedef int64_t type;
+};
+
+#if TYPELESS_INT128_ENABLE
+template<>
+struct typelessFixedWide<int64_t> {
+  typedef typelessInt128_t type;
+};
+#endif // TYPELESS_INT128_ENABLE
+
+/* Q-format fixed point, the value is raw / 2^fractionBits. Addition and subtraction wrap like the storage integer,
+ * multiplication and division go through the wide type and truncate toward negative infinity.
+ */
+template<class storageType, size_t fractionBits>
+struct typelessFixed {
+  typedef typename std::make_unsigned<storageType>::type unsignedType;
+  typedef typename typelessFixedWide<storageType>::type wideType;
+  storageType raw;
+
+  typelessFixed() = default;
+
+  typelessFixed(long double value) {
+    this->raw = (storageType) (wideType) (value * (long double) ((wideType) 1 << fractionBits));
+  }
+
+  static typelessFixed fromRaw(storageType value) {
+    typelessFixed result;
+    result.raw = value;
+    return result;
+  }
+
+  operator long double() const {
+    return (long double) this->raw / (long double) ((wideType) 1 << fractionBits);
+  }
+
+  typelessFixed operator+(typelessFixed rhs) const {
+    return fromRaw((storageType) ((unsignedType) this->raw + (unsignedType) rhs.raw));
+  }
+
+  typelessFixed operator-(typelessFixed rhs) const {
+    return fromRaw((storageType) ((unsignedType) this->raw - (unsignedType) rhs.raw));
+  }
+
+  typelessFixed operator*(typelessFixed rhs) const {
+    return fromRaw((storageType) (((wideType) this->raw * rhs.raw) >> fractionBits));
+  }
+
+  typelessFixed operator/(typelessFixed rhs) const {
+    return fromRaw((storageType) (((wideType) this->raw * ((wideType) 1 << fractionBits)) / rhs.raw));
+  }
+};
+
+typedef typelessFixed<int16_t, 8> typelessFixedQ7_8_t;
+typedef typelessFixed<int32_t, 16> typelessFixedQ15_16_t;
+#if TYPELESS_INT128_ENABLE
+typedef typelessFixed<int64_t, 32> typelessFixedQ31_32_t;
+#endif // TYPELESS_INT128_ENABLE
+
 typedef enum TypeSystemEnumeration_e {
   tse_int8_e = 1,
   tse_uint8_e = 2,
@@ -125,7 +292,15 @@ typedef enum TypeSystemEnumeration_e {
   tse_float_e = 9,
   tse_double_e = 10,
   tse_long_double_e = 11,
-  tse_unknown_e = 12
+  tse_int128_e = 12,
+  tse_uint128_e = 13,
+  tse_float16_e = 14,
+  tse_bfloat16_e = 15,
+  tse_float128_e = 16,
+  tse_fixed_q7_8_e = 17,
+  tse_fixed_q15_16_e = 18,
+  tse_fixed_q31_32_e = 19,
+  tse_unknown_e = 20
 } TypeSystemEnumeration_t;
 
 typedef union dynamicCompact {
@@ -140,9 +315,26 @@ typedef union dynamicCompact {
   float float_data;
   double double_data;
   long double longdouble_data;
+#if TYPELESS_INT128_ENABLE
+  typelessInt128_t int128_data;
+  typelessUInt128_t uint128_data;
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+  typelessFloat16_t float16_data;
+#endif // TYPELESS_FLOAT16_ENABLE
+  typelessBFloat16_t bfloat16_data;
+#if TYPELESS_FLOAT128_ENABLE
+  typelessFloat128_t float128_data;
+#endif // TYPELESS_FLOAT128_ENABLE
+  typelessFixedQ7_8_t fixedQ7_8_data;
+  typelessFixedQ15_16_t fixedQ15_16_data;
+#if TYPELESS_INT128_ENABLE
+  typelessFixedQ31_32_t fixedQ31_32_data;
+#endif // TYPELESS_INT128_ENABLE
 } dynamicCompact_t;
 
-typedef struct threadContextMeta {
+// Each thread writes isExecuting into its own context, so contexts are padded to a cache line to avoid false sharing.
+typedef struct alignas(CACHE_LINE_SIZE) threadContextMeta {
   size_t loopSetSize; // Iterations of arithmetic
   uint16_t threadTag; // Thread identification
   uint8_t isExecuting; // Debug flag
@@ -173,12 +365,229 @@ typedef struct threadContextArray {
   size_t size;
 } threadContextArray_t;
 
+// Benchmark family selected on the command line.
+typedef enum benchmarkMode_e {
+  bm_arithmetic_e = 0,
+  bm_falseSharing_e = 1,
+  bm_branch_e = 2,
+  bm_dispatch_e = 3,
+  bm_transcendental_e = 4,
+  bm_roofline_e = 5,
+  bm_bitManip_e = 6,
+  bm_division_e = 7,
+  bm_specialValues_e = 8,
+  bm_summation_e = 9,
+  bm_linearAlgebra_e = 10,
+  bm_fft_e = 11,
+  bm_stencil_e = 12,
+  bm_sort_e = 13,
+  bm_search_e = 14,
+  bm_hash_e = 15,
+  bm_checksum_e = 16,
+  bm_memory_e = 17,
+  bm_allocator_e = 18,
+  bm_pageFault_e = 19,
+  bm_syscall_e = 20,
+  bm_noise_e = 21,
+  bm_compare_e = 22,
+  bm_query_e = 23,
+  bm_unknown_e
+} benchmarkMode_et;
+
+// Command line names of the benchmark families, indexed by benchmarkMode_et.
+const char *const benchmarkModeNames[bm_unknown_e] = {
+  "arithmetic", "falsesharing", "branch", "dispatch", "transcendental", "roofline", "bitmanip",
+  "division", "specialvalues", "summation", "linearalgebra", "fft", "stencil", "sort",
+  "search", "hash", "checksum", "memory", "allocator", "pagefault", "syscall", "noise",
+  "compare", "query"};
+
+typedef struct benchmarkOptions {
+  benchmarkMode_et mode; // Benchmark family to execute
+  size_t iterations; // Loop iterations per measurement, 0 selects the family default
+  size_t threadCount; // Threads to use, 0 selects the online core count
+  size_t patternLength; // Period of generated branch and target patterns
+  size_t targetCount; // Targets of indirect branch tables
+  const char *distribution; // Input distribution of summation, NULL selects all
+  size_t repeatCount; // Runs of the family, rows of later runs are appended as samples
+  const char *baselineFile; // Result file compare mode measures against
+  const char *candidateFile; // Result file compare mode checks for regressions
+  const char *metric; // Column compare mode tests, NULL selects the first measurement
+  double threshold; // Percent a median may worsen before compare mode fails
+  double significance; // Largest p value compare mode treats as a real shift
+  const char *storeDirectory; // Result store the run is appended to and query mode reads, NULL stores nothing
+  const char *fingerprint; // Query mode host fingerprint prefix, NULL selects all
+  const char *family; // Query mode result family such as Syscall, NULL selects all
+  const char *typeName; // Query mode Type System, NULL selects all
+  const char *operation; // Query mode text the operation contains, NULL selects all
+  bool showHelp; // Print usage and exit
+
+  benchmarkOptions() {
+    this->mode = bm_arithmetic_e;
+    this->iterations = 0;
+    this->threadCount = 0;
+    this->patternLength = 16;
+    this->targetCount = 8;
+    this->distribution = NULL;
+    this->repeatCount = 1;
+    this->baselineFile = NULL;
+    this->candidateFile = NULL;
+    this->metric = NULL;
+    this->threshold = 5.0;
+    this->significance = 0.05;
+    this->storeDirectory = NULL;
+    this->fingerprint = NULL;
+    this->family = NULL;
+    this->typeName = NULL;
+    this->operation = NULL;
+    this->showHelp = false;
+  }
+} benchmarkOptions_t;
+
+// Bump allocated chunk of a run arena, the usable bytes follow the header.
+typedef struct arenaChunk {
+  struct arenaChunk *next; // Older chunk
+  size_t capacity; // Usable bytes
+  size_t used; // Bytes handed out, including alignment padding
+} arenaChunk_t;
+
+// Destructor call registered for an allocation of a type that is not trivially destructible.
+typedef struct arenaFinalizer {
+  void (*destroy)(void *address, size_t count); // Destroys count objects at address
+  void *address;
+  size_t count;
+  struct arenaFinalizer *next; // Older finalizer
+} arenaFinalizer_t;
+
+// Allocations live until the arena is released, all at once.
+typedef struct runArena {
+  pthread_mutex_t lock; // Held by arenaAllocate, worker threads allocate as well
+  arenaChunk_t *chunks; // Newest chunk first, allocations come from it
+  arenaFinalizer_t *finalizers; // Newest first, run in that order on release
+  arenaChunk_t *spares; // Emptied by arenaReset, reused before asking malloc for a chunk
+  size_t bytesReserved; // Chunk bytes obtained from malloc
+} runArena_t;
+
+// Backs safeAlloc, reset after every repetition and released when a run of the harness ends.
+runArena_t harnessArena = {PTHREAD_MUTEX_INITIALIZER, NULL, NULL, NULL, 0};
+
+#define FREQUENCY_SAMPLE_MILLISECONDS 100 // Period of the monitor thread, result rows sample as well
+#define FREQUENCY_HISTORY_SAMPLES 4096 // Temperatures kept for the regions, about seven minutes of samples
+#define FREQUENCY_CALIBRATE_SECONDS 0.02 // Wall time used to find the nominal (time stamp counter) frequency
+#define FREQUENCY_THROTTLE_RATIO 0.95 // Below this fraction of nominal a row is flagged as throttled
+#define FREQUENCY_MSR_MPERF 0xE7 // Reference cycles while the core is not halted
+#define FREQUENCY_MSR_APERF 0xE8 // Actual cycles while the core is not halted
+
+// Source of the effective frequency, tried in this order.
+typedef enum frequencySource_e {
+  fq_none_e = 0, // Nothing readable, rows get empty frequency cells
+  fq_msr_e = 1, // APERF over MPERF of every core from /dev/cpu/N/msr
+  fq_scalingCurrent_e = 2, // cpufreq scaling_cur_freq of every core
+  fq_perf_e = 3 // Cycles over reference cycles of this process and its threads from perf
+} frequencySource_et;
+
+// Effective frequency, temperature and throttle events of the timed regions behind the result rows.
+typedef struct frequencyMonitor {
+  pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER; // Held by the sampling thread and by result rows
+  pthread_cond_t wake = PTHREAD_COND_INITIALIZER; // Signalled to stop the sampling thread early
+  pthread_t samplerContext;
+  bool isStarted; // Sampling thread is running
+  bool isStopping; // Set under the lock to end the sampling thread
+  bool isPaused; // The sampling thread waits without waking, set while noise is measured
+  frequencySource_et source;
+  size_t coreCount; // Entries of the per core arrays
+  int *descriptors; // msr file per core, or the perf cycles and reference cycles pair
+  uint64_t *lastActual; // Previous actual cycle counter per core
+  uint64_t *lastReference; // Previous reference cycle counter per core
+  uint64_t *lastBusy; // Previous busy jiffies of /proc/stat per core, weights scaling_cur_freq
+  double nominalMegahertz; // Time stamp counter frequency
+  uint64_t totalActual; // Actual cycles since the monitor started
+  uint64_t totalReference; // Reference cycles since the monitor started
+  double totalMegahertzSum; // Busy weighted scaling_cur_freq averages since the monitor started
+  size_t totalSamples;
+  double celsiusHistory[FREQUENCY_HISTORY_SAMPLES]; // Hottest thermal zone of each sample, negative when unknown
+  size_t celsiusCount; // Samples taken, the history wraps around
+  bool hasThrottleCount; // thermal_throttle counters exist
+} frequencyMonitor_t;
+
+// Monitor totals at the start of a timed region, the result row of the region reports the difference.
+typedef struct frequencySnapshot {
+  uint64_t actual;
+  uint64_t reference;
+  double megahertzSum;
+  size_t samples;
+  size_t celsiusCount;
+  uint64_t throttleCount; // Thermal throttle events of all cores
+  bool isValid; // Taken while the monitor was running
+} frequencySnapshot_t;
+
+// Monitor values of a timed region, negative when unknown.
+typedef struct frequencySample {
+  double megahertz; // Average effective frequency
+  double celsius; // Hottest thermal zone
+  bool isThrottled;
+  bool isKnown; // The throttle flag is known
+} frequencySample_t;
+
+// Monitor cells of rows that are no timed region, such as values derived from other rows.
+const frequencySample_t frequencyUnknown = {-1.0, -1.0, false, false};
+
+// Annotates every family result row, started and stopped by main.
+frequencyMonitor_t harnessMonitor = {};
+
+#define ENERGY_DOMAINS_MAX 16 // Package and core powercap zones read around a timed region
+
+// Powercap (RAPL) energy_uj files, Intel and AMD both register intel-rapl zones.
+typedef struct energyMeter {
+  size_t domainCount; // Zones found, 0 when powercap is absent or unreadable
+  char domainFiles[ENERGY_DOMAINS_MAX][CHAR_BUFFER_SIZE]; // energy_uj of each zone
+  uint64_t domainRanges[ENERGY_DOMAINS_MAX]; // max_energy_range_uj, the counter wraps to 0 past it
+  bool isCore[ENERGY_DOMAINS_MAX]; // Core (PP0) subzone, otherwise a package zone
+  bool hasCore; // At least one core subzone
+  bool isShared; // Several arithmetic types run at once, their regions are not read
+} energyMeter_t;
+
+// Counters of every zone at one point in time.
+typedef struct energyCounters {
+  uint64_t microjoules[ENERGY_DOMAINS_MAX];
+  bool isValid; // Every zone was read
+} energyCounters_t;
+
+// Energy of a timed region, negative when unknown.
+typedef struct energySample {
+  double packageJoules; // Sum over the packages
+  double coreJoules; // Sum over the core subzones
+} energySample_t;
+
+// Read around the arithmetic regions, found by main.
+energyMeter_t harnessEnergy = {};
+
+// Run of the selected family under --repeat, later runs append to the result files of the first.
+size_t harnessRepetition = 0;
+
+// Result files created by this run, copied into the --store directory when it ends.
+std::vector<std::string> harnessResultFiles;
+
 // function pointers for pthreads_create
 // Code reads inside out such that *func_ptr is the function declaration.
 // func_ptr is a function pointer such that the first void* is the return
 // data and takes in the second void*.
 typedef void *(*func_ptr)(void *);
 
+// Holds the threads of a team until all of them are created, an aborted team never runs its function.
+typedef struct threadTeamGate {
+  pthread_mutex_t lock = PTHREAD_MUTEX_INITIALIZER;
+  pthread_cond_t opened = PTHREAD_COND_INITIALIZER; // Broadcast once isOpen or isAborted is set
+  bool isOpen = false; // Every thread was created
+  bool isAborted = false; // A creation failed, the threads return without running
+} threadTeamGate_t;
+
+// Argument of threadTeam_Pthread, the team function and its argument behind the gate.
+typedef struct threadTeamStart {
+  threadTeamGate_t *gate;
+  func_ptr threadFunction;
+  void *threadArgs;
+} threadTeamStart_t;
+
 /*======================================================================================================================
  * Functions prototypes
  * ===================================================================================================================*/
@@ -196,6 +605,45 @@ int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]);
 #endif // LIBRARY_MODE
 
 // Helper functions.
+void *arenaAllocateUnlocked(runArena_t &arena, size_t bytes, size_t alignment);
+
+void *arenaAllocate(runArena_t &arena, size_t bytes, size_t alignment);
+
+bool arenaFinalizerAdd(runArena_t &arena, void (*destroy)(void *, size_t), void *address, size_t count);
+
+void arenaReset(runArena_t &arena);
+
+void arenaRelease(runArena_t &arena);
+
+bool frequencyMonitorStart(frequencyMonitor_t &monitor);
+
+void frequencyMonitorStop(frequencyMonitor_t &monitor);
+
+void frequencyMonitorPause(frequencyMonitor_t &monitor, bool isPaused);
+
+void frequencyMonitorSampleUnlocked(frequencyMonitor_t &monitor);
+
+void *frequencyMonitor_Pthread(void *inArgs);
+
+frequencySnapshot_t frequencyMonitorRead(frequencyMonitor_t &monitor);
+
+frequencySample_t frequencyMonitorDelta(frequencyMonitor_t &monitor, const frequencySnapshot_t &start);
+
+double thermalZoneMaxCelsius(void);
+
+bool thermalThrottleCount(uint64_t &throttleCount);
+
+const char *frequencySourceName(frequencySource_et source);
+
+bool energyMeterStart(energyMeter_t &meter);
+
+energyCounters_t energyRead(const energyMeter_t &meter);
+
+energySample_t energyDelta(const energyMeter_t &meter, const energyCounters_t &start, const energyCounters_t &stop);
+
+template<typename Type>
+void safeAllocDestroy(void *address, size_t count);
+
 template<typename Type>
 bool safeAlloc(Type *&address, size_t size);
 
@@ -203,12 +651,35 @@ void showUsage(void);
 
 void printArgs(int argc, char *argv[]);
 
+bool parseArgs(int argc, char *argv[], benchmarkOptions_t &options);
+
+int benchmarkModeRun(const benchmarkOptions_t &options);
+
+void *threadTeam_Pthread(void *inArgs);
+
+bool threadTeamRun(func_ptr threadFunction, std::vector<void *> &threadArgs, bool isPinned);
+
+size_t threadCoreSelect(size_t threadIndex);
+
+bool resultFileIsContinued(const char fileName[CHAR_BUFFER_SIZE]);
+
+FILE *resultFileOpen(const char *familyName, const char *fileHeader, bool isMonitored,
+                     char fileNameAbsolute[CHAR_BUFFER_SIZE]);
+
+void resultFileClose(FILE *fileContext, const char fileNameAbsolute[CHAR_BUFFER_SIZE]);
+
+void resultPrintRow(FILE *fileContext, bool isEcho, const frequencySample_t *frequency, const char *format, ...);
+
 int32_t printFullPath(const char *partialPath);
 
 uint32_t getNumCores(void);
 
 double getTime(void);
 
+uint64_t getCycleCount(void);
+
+size_t getCacheSize(size_t level);
+
 void setCharArray(char content[CHAR_BUFFER_SIZE]);
 
 bool fileDelete(char fileName[CHAR_BUFFER_SIZE]);
@@ -240,8 +711,6 @@ int fileDirectoryExists(const char selectPath[CHAR_BUFFER_SIZE]);
 int fileGetDirectory(const char selectPath[CHAR_BUFFER_SIZE],
                      char foundDirectory[CHAR_BUFFER_SIZE]);
 
-double getCPUInfoTokenDouble(const char *matchString, uint64_t matchStringSize);
-
 long double getCPUFrequency(void);
 
 // Template functions.
@@ -266,6 +735,14 @@ classType typelessValid(int select, bool debug);
 template<class classType>
 TypeSystemEnumeration_t typelessClassify(classType inType);
 
+template<class classType>
+const char *typelessTypeName(void);
+
+#if TYPELESS_INT128_ENABLE
+template<class classType>
+void typelessInt128String(classType inA, char printBuffer[TYPELESS_INT128_DIGITS]);
+#endif // TYPELESS_INT128_ENABLE
+
 // Pass pointer-to-template-function as function argument.
 // Arithmetic Call template method on class template parameters.
 // @note typedef template function pointer
@@ -275,8 +752,8 @@ classType performOp(classType a, classType b);
 // Arithmetic functions - ISA Arithmetic support
 // https://web.archive.org/web/20130929035331/http://download-software.intel.com/sites/default/files/319433-015.pdf
 // https://www.felixcloutier.com/x86/
-// Supported: +, -, *, /
-// Not Supported (yet): square root, reciprocal, exponential, Sine, Cosine, Multiply-Add, Multiply-Subtract
+// Supported: +, -, *, /, Multiply-Add (fused and unfused)
+// Not Supported (yet): square root, reciprocal, exponential, Sine, Cosine, Multiply-Subtract
 template<class classType>
 classType typelessSubtraction(classType u, classType v);
 
@@ -289,11 +766,45 @@ classType typelessMultiplication(classType u, classType v);
 template<class classType>
 classType typelessDivision(classType u, classType v);
 
+template<class classType>
+classType typelessMultiplyAdd(classType u, classType v, classType w);
+
+template<class classType>
+constexpr bool typelessIsFused();
+
+template<class classType>
+classType typelessFusedMultiplyAdd(classType u, classType v, classType w);
+
+// Arithmetic Call template method on three operand functors such as multiply-add.
+template<template<typename> class tFunctor, class classType>
+classType performTernaryOp(classType a, classType b, classType c);
+
+// Arithmetic functors, defined with the implementations.
+template<class classType>
+struct tSubtract;
+
+template<class classType>
+struct tAddition;
+
+template<class classType>
+struct tMultiplication;
+
+template<class classType>
+struct tDivision;
+
+template<class classType>
+struct tMultiplyAdd;
+
+template<class classType>
+struct tFusedMultiplyAdd;
+
 // Pass pointer-to-template-function as function argument
 // Arithmetic Print Call template method on class template parameters
 template<template<typename> class tPFunctor, class classType>
 classType performPrint(classType inA, classType inB, classType outR, const char operationName[CHAR_BUFFER_SIZE],
-                       FILE *writeFileContext, long double timeDelta, size_t loopIterations);
+                       FILE *writeFileContext, long double timeDelta, const energySample_t &energy,
+                       const frequencySample_t &frequency, size_t loopIterations,
+                       size_t operationsPerIteration);
 
 // Print function for Arithmetic
 template<class classType>
@@ -301,9 +812,16 @@ void typelessStringName(classType inA, char printBuffer[CHAR_BUFFER_SIZE], bool
 
 template<class classType>
 classType typelessPrint(classType inA, classType inB, classType outR, const char operationName[CHAR_BUFFER_SIZE],
-                        FILE *writeFileContext, long double timeDelta, size_t loopIterations);
+                        FILE *writeFileContext, long double timeDelta, const energySample_t &energy,
+                        const frequencySample_t &frequency, size_t loopIterations,
+                        size_t operationsPerIteration);
+
+template<typename Type, size_t additions, size_t multiplications, size_t divisions>
+Type typelessMixedChain(Type inA, Type inB, size_t loopIterations);
 
 // Tests
+int testharness_Arithmetic(const benchmarkOptions_t &options);
+
 void *testTypes_Template_Pthread(void *inArgs);
 
 template<typename Type>
@@ -336,6 +854,38 @@ bool testTypes_Template_Pthread_init(threadContextArray_t *&threadVector,
                                      size_t indexThread,
                                      size_t dataSetSize);
 
+/*======================================================================================================================
+ * Host probe
+ * ===================================================================================================================*/
+#include "cpuBenchmarkHostProbe.hpp"
+
+/*======================================================================================================================
+ * Benchmark families
+ * ===================================================================================================================*/
+#include "cpuBenchmarkFalseSharing.hpp"
+#include "cpuBenchmarkBranch.hpp"
+#include "cpuBenchmarkDispatch.hpp"
+#include "cpuBenchmarkTranscendental.hpp"
+#include "cpuBenchmarkRoofline.hpp"
+#include "cpuBenchmarkBitManip.hpp"
+#include "cpuBenchmarkDivision.hpp"
+#include "cpuBenchmarkSpecialValues.hpp"
+#include "cpuBenchmarkSummation.hpp"
+#include "cpuBenchmarkLinearAlgebra.hpp"
+#include "cpuBenchmarkFFT.hpp"
+#include "cpuBenchmarkStencil.hpp"
+#include "cpuBenchmarkSort.hpp"
+#include "cpuBenchmarkSearch.hpp"
+#include "cpuBenchmarkHash.hpp"
+#include "cpuBenchmarkChecksum.hpp"
+#include "cpuBenchmarkMemory.hpp"
+#include "cpuBenchmarkAllocator.hpp"
+#include "cpuBenchmarkPageFault.hpp"
+#include "cpuBenchmarkSyscall.hpp"
+#include "cpuBenchmarkNoise.hpp"
+#include "cpuBenchmarkCompare.hpp"
+#include "cpuBenchmarkStore.hpp"
+
 /*======================================================================================================================
  * Function definition and implementation
  * ===================================================================================================================*/
@@ -362,6 +912,43 @@ classType typelessDivision(classType u, classType v) {
   return u / v;
 }
 
+template<class classType>
+classType typelessMultiplyAdd(classType u, classType v, classType w) {
+  classType product = u * v;
+#if defined(__x86_64__)
+  if constexpr (std::is_same<classType, float>::value || std::is_same<classType, double>::value) {
+    // Keeps the compiler from contracting the product and sum into a fused multiply-add.
+    __asm__("" : "+x"(product));
+  }
+#endif // defined(__x86_64__)
+  return product + w;
+}
+
+// Types with a single rounding multiply-add, the others emulate it with a rounded product and sum.
+template<class classType>
+constexpr bool typelessIsFused() {
+#if TYPELESS_FLOAT128_ENABLE
+  if constexpr (std::is_same<classType, typelessFloat128_t>::value) {
+    return true;
+  }
+#endif // TYPELESS_FLOAT128_ENABLE
+  return std::is_floating_point<classType>::value;
+}
+
+template<class classType>
+classType typelessFusedMultiplyAdd(classType u, classType v, classType w) {
+#if TYPELESS_FLOAT128_ENABLE
+  // std::fma has no __float128 overload.
+  if constexpr (std::is_same<classType, typelessFloat128_t>::value) {
+    return __builtin_fmaf128(u, v, w);
+  } else
+#endif // TYPELESS_FLOAT128_ENABLE
+  if constexpr (typelessIsFused<classType>()) {
+    return std::fma(u, v, w);
+  }
+  return u * v + w;
+}
+
 template<class classType>
 struct tSubtract {
   classType operator()(classType a, classType b) {
@@ -390,14 +977,32 @@ struct tDivision {
   }
 };
 
+template<class classType>
+struct tMultiplyAdd {
+  classType operator()(classType a, classType b, classType c) {
+    return typelessMultiplyAdd<classType>(a, b, c);
+  }
+};
+
+template<class classType>
+struct tFusedMultiplyAdd {
+  classType operator()(classType a, classType b, classType c) {
+    return typelessFusedMultiplyAdd<classType>(a, b, c);
+  }
+};
+
 template<class classType>
 struct tPrint {
   classType operator()(classType inA, classType inB, classType outR,
                        const char operationName[CHAR_BUFFER_SIZE],
                        FILE *writeFileContext,
                        long double timeDelta,
-                       size_t loopIterations) {
-    return typelessPrint<classType>(inA, inB, outR, operationName, writeFileContext, timeDelta, loopIterations);
+                       const energySample_t &energy,
+                       const frequencySample_t &frequency,
+                       size_t loopIterations,
+                       size_t operationsPerIteration) {
+    return typelessPrint<classType>(inA, inB, outR, operationName, writeFileContext, timeDelta, energy,
+                                    frequency, loopIterations, operationsPerIteration);
   }
 };
 
@@ -413,17 +1018,29 @@ classType performOp(classType a, classType b) {
   return tFunctor<classType>()(a, b);
 }
 
+/******************************************************************************
+*
+* @return
+*****************************************************************************/
+template<template<typename> class tFunctor, class classType>
+classType performTernaryOp(classType a, classType b, classType c) {
+  return tFunctor<classType>()(a, b, c);
+}
+
 /******************************************************************************
 *
 * @return
 *****************************************************************************/
 template<template<typename> class tPFunctor, class classType>
 classType performPrint(classType inA, classType inB, classType outR, const char operationName[CHAR_BUFFER_SIZE],
-                       FILE *writeFileContext, long double timeDelta, size_t loopIterations) {
+                       FILE *writeFileContext, long double timeDelta, const energySample_t &energy,
+                       const frequencySample_t &frequency, size_t loopIterations,
+                       size_t operationsPerIteration) {
   // Equivalent to this:
   // tPFunctor<classType> functor;
   // return functor(inA, inB, outR, operationName);
-  return tPFunctor<classType>()(inA, inB, outR, operationName, writeFileContext, timeDelta, loopIterations);
+  return tPFunctor<classType>()(inA, inB, outR, operationName, writeFileContext, timeDelta, energy, frequency,
+                                loopIterations, operationsPerIteration);
 }
 
 /*****************************************************************************
@@ -475,6 +1092,30 @@ void typelessStringName(classType inA, char printBuffer[CHAR_BUFFER_SIZE], bool
     case tse_long_double_e:
       snprintf(printBuffer, CHAR_BUFFER_SIZE, "longdouble");
       break;
+    case tse_int128_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "int128");
+      break;
+    case tse_uint128_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "uint128");
+      break;
+    case tse_float16_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "float16");
+      break;
+    case tse_bfloat16_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "bfloat16");
+      break;
+    case tse_float128_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "float128");
+      break;
+    case tse_fixed_q7_8_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "fixedq7.8");
+      break;
+    case tse_fixed_q15_16_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "fixedq15.16");
+      break;
+    case tse_fixed_q31_32_e:
+      snprintf(printBuffer, CHAR_BUFFER_SIZE, "fixedq31.32");
+      break;
     default:
       // Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R
       snprintf(printBuffer, CHAR_BUFFER_SIZE,
@@ -494,11 +1135,18 @@ void typelessStringName(classType inA, char printBuffer[CHAR_BUFFER_SIZE], bool
 // template <class classType, std::enable_if_t<!std::is_arithmetic<classType>::value>* = nullptr>
 template<class classType>
 classType typelessPrint(classType inA, classType inB, classType outR, const char operationName[CHAR_BUFFER_SIZE],
-                        FILE *fileContext, long double timeDelta, size_t loopIterations) {
+                        FILE *fileContext, long double timeDelta, const energySample_t &energy,
+                        const frequencySample_t &frequency, size_t loopIterations,
+                        size_t operationsPerIteration) {
   TypeSystemEnumeration_t mtA = typelessClassify<classType>(inA);
   TypeSystemEnumeration_t mtB = typelessClassify<classType>(inB);
   TypeSystemEnumeration_t mtR = typelessClassify<classType>(outR);
   char printBuffer[CHAR_BUFFER_SIZE];
+#if TYPELESS_INT128_ENABLE
+  char valueBuffer[3][TYPELESS_INT128_DIGITS];
+#endif // TYPELESS_INT128_ENABLE
+  long double operationsPerSecond;
+  size_t printLength;
   bool areAllSameType = ((mtA == mtB) && (mtB == mtR));
   setCharArray(printBuffer);
 
@@ -508,7 +1156,8 @@ classType typelessPrint(classType inA, classType inB, classType outR, const char
      * A 64-bit, double precision IEEE754 number has 53 mantissa bits, which gives about 52+1 * log10(2) = 15.95 ~ 16 digits of precision.
      * A 128-bit, long double precision IEEE754 number has 112 mantissa bits, which gives about 112+1 * log10(2) = 34.01 ~ 35 digits of precision.
      */
-    // Header is: Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R
+    // Header is: Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R,
+    //            Operations per Iteration, Operations per Second
     switch (mtR) {
       case tse_int8_e:
         snprintf(printBuffer, CHAR_BUFFER_SIZE, "int8_t, %s, %Lf, %lu, %d, %d, %d",
@@ -565,6 +1214,42 @@ classType typelessPrint(classType inA, classType inB, classType outR, const char
                  operationName, timeDelta, loopIterations,
                  (long double) inA, (long double) inB, (long double) outR);
         break;
+#if TYPELESS_INT128_ENABLE
+      case tse_int128_e:
+      case tse_uint128_e:
+        typelessInt128String<classType>(inA, valueBuffer[0]);
+        typelessInt128String<classType>(inB, valueBuffer[1]);
+        typelessInt128String<classType>(outR, valueBuffer[2]);
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "%s, %s, %Lf, %lu, %s, %s, %s",
+                 (tse_int128_e == mtR) ? "__int128" : "unsigned __int128", operationName, timeDelta, loopIterations,
+                 valueBuffer[0], valueBuffer[1], valueBuffer[2]);
+        break;
+#endif // TYPELESS_INT128_ENABLE
+      case tse_float16_e:
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "_Float16, %s, %Lf, %lu, %.4f, %.4f, %.4f",
+                 operationName, timeDelta, loopIterations,
+                 (float) inA, (float) inB, (float) outR);
+        break;
+      case tse_bfloat16_e:
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "__bf16, %s, %Lf, %lu, %.3f, %.3f, %.3f",
+                 operationName, timeDelta, loopIterations,
+                 (float) inA, (float) inB, (float) outR);
+        break;
+      case tse_float128_e:
+        // Printed through long double, quadmath is not linked.
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "__float128, %s, %Lf, %lu, %.35Lf, %.35Lf, %.35Lf",
+                 operationName, timeDelta, loopIterations,
+                 (long double) inA, (long double) inB, (long double) outR);
+        break;
+      case tse_fixed_q7_8_e:
+      case tse_fixed_q15_16_e:
+      case tse_fixed_q31_32_e:
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "%s, %s, %Lf, %lu, %.10Lf, %.10Lf, %.10Lf",
+                 (tse_fixed_q7_8_e == mtR) ? "fixed_q7.8" : ((tse_fixed_q15_16_e == mtR) ? "fixed_q15.16" :
+                                                              "fixed_q31.32"),
+                 operationName, timeDelta, loopIterations,
+                 (long double) inA, (long double) inB, (long double) outR);
+        break;
       default:
         // Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R
         snprintf(printBuffer, CHAR_BUFFER_SIZE,
@@ -573,10 +1258,28 @@ classType typelessPrint(classType inA, classType inB, classType outR, const char
                  __LINE__, operationName, timeDelta, loopIterations);
         break;
     }
-    if (ENABLE_DEBUG) {
-      printf("%s\n", printBuffer);
+    // Operations per Iteration, Operations per Second (FLOP/s for the floating point types)
+    operationsPerSecond = (timeDelta > 0) ? ((long double) loopIterations * operationsPerIteration) / timeDelta : 0;
+    printLength = strnlen(printBuffer, CHAR_BUFFER_SIZE);
+    printLength += snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", %zu, %Lf",
+                            operationsPerIteration, operationsPerSecond);
+    // Package Joules, Core Joules, Joules per Operation, Operations per Watt; empty without powercap.
+    if ((printLength < CHAR_BUFFER_SIZE) && (energy.packageJoules > 0.0) && (timeDelta > 0)) {
+      printLength += snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", %f", energy.packageJoules);
+      if ((printLength < CHAR_BUFFER_SIZE) && (energy.coreJoules >= 0.0)) {
+        printLength += snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", %f", energy.coreJoules);
+      } else if (printLength < CHAR_BUFFER_SIZE) {
+        printLength += snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", ");
+      }
+      if (printLength < CHAR_BUFFER_SIZE) {
+        snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", %.12Lf, %Lf",
+                 (long double) energy.packageJoules / ((long double) loopIterations * operationsPerIteration),
+                 operationsPerSecond / ((long double) energy.packageJoules / timeDelta));
+      }
+    } else if (printLength < CHAR_BUFFER_SIZE) {
+      snprintf(printBuffer + printLength, CHAR_BUFFER_SIZE - printLength, ", , , , ");
     }
-    fprintf(fileContext, "%s\n", printBuffer);
+    resultPrintRow(fileContext, ENABLE_DEBUG, &frequency, "%s", printBuffer);
   }
   return outR;
 }
@@ -588,10 +1291,22 @@ classType typelessPrint(classType inA, classType inB, classType outR, const char
 template<typename Type>
 void testTypes_Template_typeless(Type inA, Type inB, FILE *fileContext, size_t datasetSize) {
   long double timeStart, timeStop, timeDelta;
+  energyCounters_t energyStart;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  energySample_t energy;
   bool isOdd;
   size_t loopIterations = datasetSize;
+  size_t dotIterations = loopIterations - (loopIterations % 4);
+  size_t lane;
   Type typelessResult_add, typelessResult_sub, typelessResult_mul, typelessResult_div;
+  Type typelessResult_fma, typelessResult_madd, typelessResult_dot, typelessResult_horner, typelessResult_mixed;
+  Type dotAccumulator0, dotAccumulator1, dotAccumulator2, dotAccumulator3;
+  Type vectorA[TYPELESS_VECTOR_LENGTH], vectorB[TYPELESS_VECTOR_LENGTH];
+  Type coefficients[TYPELESS_HORNER_DEGREE];
 
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
   timeStart = getTime();
   typelessResult_add = performOp<tAddition>(inA, inB);
   for (size_t index = 0; index < loopIterations; index++) {
@@ -606,8 +1321,13 @@ void testTypes_Template_typeless(Type inA, Type inB, FILE *fileContext, size_t d
   }
   timeStop = getTime();
   timeDelta = timeStop - timeStart;
-  performPrint<tPrint>(inA, inB, typelessResult_add, "addition", fileContext, timeDelta, loopIterations);
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_add, "addition", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 1);
 
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
   timeStart = getTime();
   for (size_t index = 0; index < loopIterations; index++) {
     isOdd = index & 1;
@@ -621,8 +1341,13 @@ void testTypes_Template_typeless(Type inA, Type inB, FILE *fileContext, size_t d
   }
   timeStop = getTime();
   timeDelta = timeStop - timeStart;
-  performPrint<tPrint>(inA, inB, typelessResult_sub, "subtraction", fileContext, timeDelta, loopIterations);
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_sub, "subtraction", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 1);
 
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
   timeStart = getTime();
   for (size_t index = 0; index < loopIterations; index++) {
     isOdd = index & 1;
@@ -636,8 +1361,13 @@ void testTypes_Template_typeless(Type inA, Type inB, FILE *fileContext, size_t d
   }
   timeStop = getTime();
   timeDelta = timeStop - timeStart;
-  performPrint<tPrint>(inA, inB, typelessResult_mul, "multiplication", fileContext, timeDelta, loopIterations);
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_mul, "multiplication", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 1);
 
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
   timeStart = getTime();
   for (size_t index = 0; index < loopIterations; index++) {
     isOdd = index & 1;
@@ -651,18 +1381,155 @@ void testTypes_Template_typeless(Type inA, Type inB, FILE *fileContext, size_t d
   }
   timeStop = getTime();
   timeDelta = timeStop - timeStart;
-  performPrint<tPrint>(inA, inB, typelessResult_div, "division", fileContext, timeDelta, loopIterations);
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_div, "division", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 1);
+
+  // Multiply-add chains, the result feeds the multiplicand so each step waits on the previous one.
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_fma = inA;
+  for (size_t index = 0; index < loopIterations; index++) {
+    typelessResult_fma = performTernaryOp<tFusedMultiplyAdd>(typelessResult_fma, inB, inA);
+  }
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_fma,
+                       typelessIsFused<Type>() ? "fused_multiply-add" : "multiply-add_emulated", fileContext,
+                       timeDelta, energy, frequency, loopIterations, 2);
+
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_madd = inA;
+  for (size_t index = 0; index < loopIterations; index++) {
+    typelessResult_madd = performTernaryOp<tMultiplyAdd>(typelessResult_madd, inB, inA);
+  }
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_madd, "multiply-add_unfused", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 2);
+
+  // Dot product reduction with four independent accumulators, bound by throughput rather than latency.
+  for (size_t index = 0; index < TYPELESS_VECTOR_LENGTH; index++) {
+    vectorA[index] = (index & 1) ? inA : inB;
+    vectorB[index] = (index & 1) ? inB : inA;
+  }
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  dotAccumulator0 = dotAccumulator1 = dotAccumulator2 = dotAccumulator3 = 0;
+  for (size_t index = 0; index < dotIterations; index += 4) {
+    lane = index & (TYPELESS_VECTOR_LENGTH - 1);
+    dotAccumulator0 = performTernaryOp<tFusedMultiplyAdd>(vectorA[lane], vectorB[lane], dotAccumulator0);
+    dotAccumulator1 = performTernaryOp<tFusedMultiplyAdd>(vectorA[lane + 1], vectorB[lane + 1], dotAccumulator1);
+    dotAccumulator2 = performTernaryOp<tFusedMultiplyAdd>(vectorA[lane + 2], vectorB[lane + 2], dotAccumulator2);
+    dotAccumulator3 = performTernaryOp<tFusedMultiplyAdd>(vectorA[lane + 3], vectorB[lane + 3], dotAccumulator3);
+  }
+  typelessResult_dot = performOp<tAddition>(performOp<tAddition>(dotAccumulator0, dotAccumulator1),
+                                            performOp<tAddition>(dotAccumulator2, dotAccumulator3));
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_dot, "dot_product", fileContext, timeDelta, energy, frequency,
+                       dotIterations, 2);
+
+  // Horner's rule at x = inB, the previous value is the leading coefficient of the next polynomial.
+  for (size_t index = 0; index < TYPELESS_HORNER_DEGREE; index++) {
+    coefficients[index] = (index & 1) ? inB : inA;
+  }
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_horner = inA;
+  for (size_t index = 0; index < loopIterations; index++) {
+    for (size_t degree = 0; degree < TYPELESS_HORNER_DEGREE; degree++) {
+      typelessResult_horner = performTernaryOp<tFusedMultiplyAdd>(typelessResult_horner, inB, coefficients[degree]);
+    }
+  }
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_horner, "horner_polynomial", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 2 * TYPELESS_HORNER_DEGREE);
+
+  // Mixed operation ratios, named add:mul:div.
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_mixed = typelessMixedChain<Type, 1, 1, 1>(inA, inB, loopIterations);
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_mixed, "mixed_1:1:1", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 3);
+
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_mixed = typelessMixedChain<Type, 4, 2, 1>(inA, inB, loopIterations);
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_mixed, "mixed_4:2:1", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 7);
+
+  energyStart = energyRead(harnessEnergy);
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  typelessResult_mixed = typelessMixedChain<Type, 8, 4, 1>(inA, inB, loopIterations);
+  timeStop = getTime();
+  timeDelta = timeStop - timeStart;
+  energy = energyDelta(harnessEnergy, energyStart, energyRead(harnessEnergy));
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  performPrint<tPrint>(inA, inB, typelessResult_mixed, "mixed_8:4:1", fileContext, timeDelta, energy, frequency,
+                       loopIterations, 13);
 
   return;
 }
 
+/******************************************************************************
+* One dependent chain per iteration: additions of inB, multiplications by inA,
+* then divisions by inB.
+* @return  the chained result.
+*****************************************************************************/
+template<typename Type, size_t additions, size_t multiplications, size_t divisions>
+Type typelessMixedChain(Type inA, Type inB, size_t loopIterations) {
+  Type typelessResult = inA;
+
+  for (size_t index = 0; index < loopIterations; index++) {
+    for (size_t count = 0; count < additions; count++) {
+      typelessResult = performOp<tAddition>(typelessResult, inB);
+    }
+    for (size_t count = 0; count < multiplications; count++) {
+      typelessResult = performOp<tMultiplication>(typelessResult, inA);
+    }
+    for (size_t count = 0; count < divisions; count++) {
+      typelessResult = performOp<tDivision>(typelessResult, inB);
+    }
+  }
+  return typelessResult;
+}
+
 /******************************************************************************
 *
 * @return
 *****************************************************************************/
 template<typename Type>
 bool testTypes_Template_Pthread_init(threadContextArray_t *&threadVector, size_t indexThread, size_t dataSetSize) {
-  const std::string fileHeader = "Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R";
+  const std::string fileHeader = "Type System, Operation Set Name, Time for Operations, Count of Operations Performed, LHS, RHS, R, "
+                                 "Operations per Iteration, Operations per Second, Package Joules, Core Joules, "
+                                 "Joules per Operation, Operations per Watt, Average MHz, Max Celsius, Throttled";
 #if (defined(__WIN64__) && defined(__WIN64__))
   const char fileDirectory[] = "\\data\\";
 #else // !(defined(__WIN64__) && defined(__WIN64__))
@@ -675,7 +1542,7 @@ bool testTypes_Template_Pthread_init(threadContextArray_t *&threadVector, size_t
   char *typeNameBuffer = NULL;
   char *messages = NULL;
   Type operandsMeta[OPERANDS_2_IN];
-  Type resultantsMeta;
+  Type resultantsMeta = (Type) 0;
   threadContextMeta_t *threadItem = NULL;
   bool isValid;
 
@@ -796,6 +1663,62 @@ void *testTypes_Template_Pthread(void *inArgs) {
                                                threadInfo->saveFileContext,
                                                threadInfo->loopSetSize);
       break;
+#if TYPELESS_INT128_ENABLE
+    case tse_int128_e:
+      testTypes_Template_typeless<typelessInt128_t>(threadInfo->operandsMeta[0].int128_data,
+                                                    threadInfo->operandsMeta[1].int128_data,
+                                                    threadInfo->saveFileContext,
+                                                    threadInfo->loopSetSize);
+      break;
+    case tse_uint128_e:
+      testTypes_Template_typeless<typelessUInt128_t>(threadInfo->operandsMeta[0].uint128_data,
+                                                     threadInfo->operandsMeta[1].uint128_data,
+                                                     threadInfo->saveFileContext,
+                                                     threadInfo->loopSetSize);
+      break;
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+    case tse_float16_e:
+      testTypes_Template_typeless<typelessFloat16_t>(threadInfo->operandsMeta[0].float16_data,
+                                                     threadInfo->operandsMeta[1].float16_data,
+                                                     threadInfo->saveFileContext,
+                                                     threadInfo->loopSetSize);
+      break;
+#endif // TYPELESS_FLOAT16_ENABLE
+    case tse_bfloat16_e:
+      testTypes_Template_typeless<typelessBFloat16_t>(threadInfo->operandsMeta[0].bfloat16_data,
+                                                      threadInfo->operandsMeta[1].bfloat16_data,
+                                                      threadInfo->saveFileContext,
+                                                      threadInfo->loopSetSize);
+      break;
+#if TYPELESS_FLOAT128_ENABLE
+    case tse_float128_e:
+      testTypes_Template_typeless<typelessFloat128_t>(threadInfo->operandsMeta[0].float128_data,
+                                                      threadInfo->operandsMeta[1].float128_data,
+                                                      threadInfo->saveFileContext,
+                                                      threadInfo->loopSetSize);
+      break;
+#endif // TYPELESS_FLOAT128_ENABLE
+    case tse_fixed_q7_8_e:
+      testTypes_Template_typeless<typelessFixedQ7_8_t>(threadInfo->operandsMeta[0].fixedQ7_8_data,
+                                                       threadInfo->operandsMeta[1].fixedQ7_8_data,
+                                                       threadInfo->saveFileContext,
+                                                       threadInfo->loopSetSize);
+      break;
+    case tse_fixed_q15_16_e:
+      testTypes_Template_typeless<typelessFixedQ15_16_t>(threadInfo->operandsMeta[0].fixedQ15_16_data,
+                                                         threadInfo->operandsMeta[1].fixedQ15_16_data,
+                                                         threadInfo->saveFileContext,
+                                                         threadInfo->loopSetSize);
+      break;
+#if TYPELESS_INT128_ENABLE
+    case tse_fixed_q31_32_e:
+      testTypes_Template_typeless<typelessFixedQ31_32_t>(threadInfo->operandsMeta[0].fixedQ31_32_data,
+                                                         threadInfo->operandsMeta[1].fixedQ31_32_data,
+                                                         threadInfo->saveFileContext,
+                                                         threadInfo->loopSetSize);
+      break;
+#endif // TYPELESS_INT128_ENABLE
     default:
       asserterrorthread(threadInfo->threadTag);
       break;
@@ -883,8 +1806,9 @@ bool threadContextArray_init(threadContextArray_t *&threadContextArrayData,
     isLevel_1_Allocated = true;
   }
 
-  if (threadContextArrayData->threadContextVectorMeta.capacity() < reserveSize) {
-    threadContextArrayData->threadContextVectorMeta.reserve(reserveSize);
+  // Construct the contexts in place so each one starts on its own cache line.
+  if (threadContextArrayData->threadContextVectorMeta.size() < reserveSize) {
+    threadContextArrayData->threadContextVectorMeta.resize(reserveSize);
   }
   isLevel_2_Allocated = true;
 
@@ -920,7 +1844,6 @@ bool threadContextMeta_set(threadContextMeta_t *threadContextData,
                            char messages[CHAR_BUFFER_SIZE],
                            const std::string fileHeader) {
   Type tmp;
-  size_t dataTypeSize;
   bool isAllocated = false;
   char directoryPath[CHAR_BUFFER_SIZE];
   setCharArray(directoryPath);
@@ -940,14 +1863,16 @@ bool threadContextMeta_set(threadContextMeta_t *threadContextData,
     }
 
     if (NULL == threadContextData->saveFileContext) {
-      if (fs_Found_vet == fileIsFound(threadContextData->saveFilename)) {
-        fileDelete(threadContextData->saveFilename);
-      } else {
-        fileGetDirectory(threadContextData->saveFilename, directoryPath);
-        fileMakeDirectories(directoryPath);
+      if (!resultFileIsContinued(threadContextData->saveFilename)) {
+        if (fs_Found_vet == fileIsFound(threadContextData->saveFilename)) {
+          fileDelete(threadContextData->saveFilename);
+        } else {
+          fileGetDirectory(threadContextData->saveFilename, directoryPath);
+          fileMakeDirectories(directoryPath);
+        }
+        fileOverwriteNil(threadContextData->saveFilename);
+        fileCreate(threadContextData->saveFilename, (char *) fileHeader.c_str());
       }
-      fileOverwriteNil(threadContextData->saveFilename);
-      fileCreate(threadContextData->saveFilename, (char *) fileHeader.c_str());
       threadContextData->saveFileContext = fopen(threadContextData->saveFilename, "a+");
       printf("File %s opened in a+ mode.\n", threadContextData->saveFilename);
     } else {
@@ -960,8 +1885,7 @@ bool threadContextMeta_set(threadContextMeta_t *threadContextData,
     }
     setCharArray(threadContextData->datatypeIDName);
     // Extract name from type
-    dataTypeSize = sizeof(typeid(tmp).name());
-    strncpy(threadContextData->datatypeIDName, typeid(tmp).name(), dataTypeSize);
+    snprintf(threadContextData->datatypeIDName, CHAR_BUFFER_SIZE, "%s", typelessTypeName<Type>());
 
     threadContextData->typeSystemName = typelessClassify<Type>(tmp);
     switch (threadContextData->typeSystemName) {
@@ -1020,6 +1944,54 @@ bool threadContextMeta_set(threadContextMeta_t *threadContextData,
         threadContextData->operandsMeta[1].longdouble_data = operandsMeta[1];
         threadContextData->resultantsMeta.longdouble_data = resultantsMeta;
         break;
+#if TYPELESS_INT128_ENABLE
+      case tse_int128_e:
+        threadContextData->operandsMeta[0].int128_data = operandsMeta[0];
+        threadContextData->operandsMeta[1].int128_data = operandsMeta[1];
+        threadContextData->resultantsMeta.int128_data = resultantsMeta;
+        break;
+      case tse_uint128_e:
+        threadContextData->operandsMeta[0].uint128_data = operandsMeta[0];
+        threadContextData->operandsMeta[1].uint128_data = operandsMeta[1];
+        threadContextData->resultantsMeta.uint128_data = resultantsMeta;
+        break;
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+      case tse_float16_e:
+        threadContextData->operandsMeta[0].float16_data = operandsMeta[0];
+        threadContextData->operandsMeta[1].float16_data = operandsMeta[1];
+        threadContextData->resultantsMeta.float16_data = resultantsMeta;
+        break;
+#endif // TYPELESS_FLOAT16_ENABLE
+      case tse_bfloat16_e:
+        threadContextData->operandsMeta[0].bfloat16_data = (typelessBFloat16_t) operandsMeta[0];
+        threadContextData->operandsMeta[1].bfloat16_data = (typelessBFloat16_t) operandsMeta[1];
+        threadContextData->resultantsMeta.bfloat16_data = (typelessBFloat16_t) resultantsMeta;
+        break;
+#if TYPELESS_FLOAT128_ENABLE
+      case tse_float128_e:
+        threadContextData->operandsMeta[0].float128_data = operandsMeta[0];
+        threadContextData->operandsMeta[1].float128_data = operandsMeta[1];
+        threadContextData->resultantsMeta.float128_data = resultantsMeta;
+        break;
+#endif // TYPELESS_FLOAT128_ENABLE
+      case tse_fixed_q7_8_e:
+        threadContextData->operandsMeta[0].fixedQ7_8_data = (typelessFixedQ7_8_t) operandsMeta[0];
+        threadContextData->operandsMeta[1].fixedQ7_8_data = (typelessFixedQ7_8_t) operandsMeta[1];
+        threadContextData->resultantsMeta.fixedQ7_8_data = (typelessFixedQ7_8_t) resultantsMeta;
+        break;
+      case tse_fixed_q15_16_e:
+        threadContextData->operandsMeta[0].fixedQ15_16_data = (typelessFixedQ15_16_t) operandsMeta[0];
+        threadContextData->operandsMeta[1].fixedQ15_16_data = (typelessFixedQ15_16_t) operandsMeta[1];
+        threadContextData->resultantsMeta.fixedQ15_16_data = (typelessFixedQ15_16_t) resultantsMeta;
+        break;
+#if TYPELESS_INT128_ENABLE
+      case tse_fixed_q31_32_e:
+        threadContextData->operandsMeta[0].fixedQ31_32_data = (typelessFixedQ31_32_t) operandsMeta[0];
+        threadContextData->operandsMeta[1].fixedQ31_32_data = (typelessFixedQ31_32_t) operandsMeta[1];
+        threadContextData->resultantsMeta.fixedQ31_32_data = (typelessFixedQ31_32_t) resultantsMeta;
+        break;
+#endif // TYPELESS_INT128_ENABLE
       default:
         bool isValid_Numerical = false;
         printf("Operation=unknownType, A=unknown\n");
@@ -1053,34 +2025,168 @@ int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]) {
 #pragma message("LIBRARY_MODE DEFAULT")
 int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]) {
 #endif // LIBRARY_MODE
+  benchmarkOptions_t options;
+  int exitStatus = EXIT_SUCCESS;
+
   showUsage();
   printArgs(argc, argv);
-  const size_t waitTime = 6;
-  const size_t oneMinute = (waitTime >= 1) ? (60 / waitTime) : waitTime;
-  const size_t testSize = 11;
-  volatile size_t dataSetSize = (1 << 30); // Choose 28 to 31 bits. Used to ensure compiler does not optimize.
-  std::vector<size_t> notStartedQueue;
-  std::vector<size_t> inProgressQueue;
-  std::vector<size_t> completedQueue;
-  std::vector<size_t> errorQueue;
-  size_t waitCount;
-  size_t coreCount;
-  size_t activeThreadCount;
-  size_t threadStatus;
-  size_t threadIndex;
-  size_t notStartedSize;
-  size_t inProgressSize;
-  func_ptr myTypelessTestFuncs;
-  threadContextArray_t *threadVector;
-  pthread_t *threadContext;
-  size_t *threadID;
+  if (!parseArgs(argc, argv, options)) {
+    return EXIT_FAILURE;
+  }
+  if (options.showHelp) {
+    return EXIT_SUCCESS;
+  }
+  if (bm_compare_e == options.mode) {
+    return testharness_Compare(options);
+  }
+  if (bm_query_e == options.mode) {
+    return testharness_Query(options);
+  }
+  hostProbeRun(harnessHost);
+  printf("Host fingerprint 0x%016" PRIx64 ", %s, %s.\n", harnessHost.fingerprint, harnessHost.brand, GIT_REVISION);
+  frequencyMonitorStart(harnessMonitor);
+  energyMeterStart(harnessEnergy);
+
+  for (harnessRepetition = 0; harnessRepetition < options.repeatCount; harnessRepetition++) {
+    if (options.repeatCount > 1) {
+      printf("Repetition %zu of %zu.\n", harnessRepetition + 1, options.repeatCount);
+    }
+    exitStatus = benchmarkModeRun(options);
+    // Every buffer of a repetition is dead here, the next one reuses the chunks.
+    arenaReset(harnessArena);
+    if (EXIT_SUCCESS != exitStatus) {
+      break;
+    }
+  }
+  if ((EXIT_SUCCESS == exitStatus) && (NULL != options.storeDirectory) && !storeRunAppend(options.storeDirectory)) {
+    exitStatus = EXIT_FAILURE;
+  }
+  frequencyMonitorStop(harnessMonitor);
+  arenaRelease(harnessArena);
+  return exitStatus;
+}
 
-  setvbuf(stdout, NULL, _IONBF, BUFSIZ); // Set buffer size.
-  waitCount = 0;
-  threadVector = NULL;
+/******************************************************************************
+* Runs the benchmark family selected on the command line once.
+* @return  exit status of the family.
+*****************************************************************************/
+int benchmarkModeRun(const benchmarkOptions_t &options) {
+  int exitStatus;
+
+  switch (options.mode) {
+    case bm_falseSharing_e:
+      exitStatus = testharness_FalseSharing(options);
+      break;
+    case bm_branch_e:
+      exitStatus = testharness_Branch(options);
+      break;
+    case bm_dispatch_e:
+      exitStatus = testharness_Dispatch(options);
+      break;
+    case bm_transcendental_e:
+      exitStatus = testharness_Transcendental(options);
+      break;
+    case bm_roofline_e:
+      exitStatus = testharness_Roofline(options);
+      break;
+    case bm_bitManip_e:
+      exitStatus = testharness_BitManip(options);
+      break;
+    case bm_division_e:
+      exitStatus = testharness_Division(options);
+      break;
+    case bm_specialValues_e:
+      exitStatus = testharness_SpecialValues(options);
+      break;
+    case bm_summation_e:
+      exitStatus = testharness_Summation(options);
+      break;
+    case bm_linearAlgebra_e:
+      exitStatus = testharness_LinearAlgebra(options);
+      break;
+    case bm_fft_e:
+      exitStatus = testharness_FFT(options);
+      break;
+    case bm_stencil_e:
+      exitStatus = testharness_Stencil(options);
+      break;
+    case bm_sort_e:
+      exitStatus = testharness_Sort(options);
+      break;
+    case bm_search_e:
+      exitStatus = testharness_Search(options);
+      break;
+    case bm_hash_e:
+      exitStatus = testharness_Hash(options);
+      break;
+    case bm_checksum_e:
+      exitStatus = testharness_Checksum(options);
+      break;
+    case bm_memory_e:
+      exitStatus = testharness_Memory(options);
+      break;
+    case bm_allocator_e:
+      exitStatus = testharness_Allocator(options);
+      break;
+    case bm_pageFault_e:
+      exitStatus = testharness_PageFault(options);
+      break;
+    case bm_syscall_e:
+      exitStatus = testharness_Syscall(options);
+      break;
+    case bm_noise_e:
+      exitStatus = testharness_Noise(options);
+      break;
+    case bm_arithmetic_e:
+    default:
+      exitStatus = testharness_Arithmetic(options);
+      break;
+  }
+  return exitStatus;
+}
+
+/******************************************************************************
+* Runs every type of the type system through the arithmetic chains, one
+* thread per type, limited to the online core count. Package energy counts
+* every running thread, so with powercap zones the types run one at a time
+* unless -t asks for more; concurrent types leave the energy cells empty.
+* @return EXIT_SUCCESS when all threads completed.
+*****************************************************************************/
+int testharness_Arithmetic(const benchmarkOptions_t &options) {
+  const size_t waitTime = 6;
+  const size_t oneMinute = (waitTime >= 1) ? (60 / waitTime) : waitTime;
+  const size_t testSize = 11 + 3 * TYPELESS_INT128_ENABLE + TYPELESS_FLOAT16_ENABLE + TYPELESS_FLOAT128_ENABLE + 3;
+  volatile size_t dataSetSize = (1 << 30); // Choose 28 to 31 bits. Used to ensure compiler does not optimize.
+  std::vector<size_t> notStartedQueue;
+  std::vector<size_t> inProgressQueue;
+  std::vector<size_t> completedQueue;
+  std::vector<size_t> errorQueue;
+  size_t waitCount;
+  size_t coreCount;
+  size_t activeThreadCount;
+  size_t threadStatus;
+  size_t threadIndex;
+  size_t notStartedSize;
+  size_t inProgressSize;
+  func_ptr myTypelessTestFuncs;
+  threadContextArray_t *threadVector;
+  pthread_t *threadContext;
+  size_t *threadID;
+
+  setvbuf(stdout, NULL, _IONBF, BUFSIZ); // Set buffer size.
+  waitCount = 0;
+  threadVector = NULL;
   threadContext = NULL;
   threadID = NULL;
-  coreCount = getNumCores();
+  coreCount = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  if ((harnessEnergy.domainCount > 0) && (0 == options.threadCount)) {
+    coreCount = 1;
+    printf("Energy counters found, types run one at a time.\n");
+  }
+  harnessEnergy.isShared = (coreCount > 1);
+  if (options.iterations > 0) {
+    dataSetSize = options.iterations;
+  }
   activeThreadCount = 0;
   printf("Cores for Pthread() usage are: %zu\n", coreCount);
   printf("CPU frequency %Lf KHz\n", getCPUFrequency());
@@ -1101,6 +2207,21 @@ int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]) {
   testTypes_Template_Pthread_init<float>(threadVector, 8, dataSetSize);
   testTypes_Template_Pthread_init<double>(threadVector, 9, dataSetSize);
   testTypes_Template_Pthread_init<long double>(threadVector, 10, dataSetSize);
+  threadIndex = 11;
+  testTypes_Template_Pthread_init<typelessBFloat16_t>(threadVector, threadIndex++, dataSetSize);
+  testTypes_Template_Pthread_init<typelessFixedQ7_8_t>(threadVector, threadIndex++, dataSetSize);
+  testTypes_Template_Pthread_init<typelessFixedQ15_16_t>(threadVector, threadIndex++, dataSetSize);
+#if TYPELESS_INT128_ENABLE
+  testTypes_Template_Pthread_init<typelessInt128_t>(threadVector, threadIndex++, dataSetSize);
+  testTypes_Template_Pthread_init<typelessUInt128_t>(threadVector, threadIndex++, dataSetSize);
+  testTypes_Template_Pthread_init<typelessFixedQ31_32_t>(threadVector, threadIndex++, dataSetSize);
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+  testTypes_Template_Pthread_init<typelessFloat16_t>(threadVector, threadIndex++, dataSetSize);
+#endif // TYPELESS_FLOAT16_ENABLE
+#if TYPELESS_FLOAT128_ENABLE
+  testTypes_Template_Pthread_init<typelessFloat128_t>(threadVector, threadIndex++, dataSetSize);
+#endif // TYPELESS_FLOAT128_ENABLE
 
   safeAlloc<pthread_t>(threadContext, testSize);
   safeAlloc<size_t>(threadID, testSize);
@@ -1168,6 +2289,7 @@ int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]) {
         } else {
           printf("Thread %ld complete. Wait queue is %ld.\n", threadIndex, inProgressQueue.size());
           push_back(completedQueue, threadIndex);
+          activeThreadCount--;
         }
         inProgressSize--;
       }
@@ -1184,30 +2306,704 @@ int testharness_CPUBenchmarkParallel_main(int argc, char *argv[]) {
     fclose(threadVector->threadContextVectorMeta[threadIndexLocal].saveFileContext);
     printFullPath(threadVector->threadContextVectorMeta[threadIndexLocal].saveFilename);
   }
-  // Deconstruct
-  delete[] threadContext;
-  delete[] threadID;
-  pthread_exit(NULL);
-
   return EXIT_SUCCESS;
 }
 
 /*======================================================================================================================
  * Helper functions
  * ===================================================================================================================*/
+/******************************************************************************
+* Bump allocation from the newest chunk, the caller holds the arena lock or
+* owns the arena.
+* @return  address of bytes of uninitialized memory, NULL when out of memory.
+*****************************************************************************/
+void *arenaAllocateUnlocked(runArena_t &arena, size_t bytes, size_t alignment) {
+  arenaChunk_t *chunk = arena.chunks;
+  uintptr_t start, offset;
+  size_t capacity;
+
+  alignment = (alignment > 0) ? alignment : 1;
+  if (NULL != chunk) {
+    start = (uintptr_t) (chunk + 1);
+    offset = ((start + chunk->used + alignment - 1) & ~((uintptr_t) alignment - 1)) - start;
+    if ((offset + bytes) <= chunk->capacity) {
+      chunk->used = offset + bytes;
+      return (void *) (start + offset);
+    }
+  }
+  capacity = bytes + alignment;
+  if ((NULL != arena.spares) && (arena.spares->capacity >= capacity)) {
+    chunk = arena.spares;
+    arena.spares = chunk->next;
+  } else {
+    capacity = (capacity > ARENA_CHUNK_BYTES) ? capacity : ARENA_CHUNK_BYTES;
+    chunk = (arenaChunk_t *) malloc(sizeof(arenaChunk_t) + capacity);
+    if (NULL == chunk) {
+      return NULL;
+    }
+    chunk->capacity = capacity;
+    arena.bytesReserved += capacity;
+  }
+  chunk->used = 0;
+  // A chunk made for one large request goes behind the current one, which may still have room.
+  if ((NULL != arena.chunks) && (capacity > ARENA_CHUNK_BYTES)) {
+    chunk->next = arena.chunks->next;
+    arena.chunks->next = chunk;
+  } else {
+    chunk->next = arena.chunks;
+    arena.chunks = chunk;
+  }
+  start = (uintptr_t) (chunk + 1);
+  offset = ((start + alignment - 1) & ~((uintptr_t) alignment - 1)) - start;
+  chunk->used = offset + bytes;
+  return (void *) (start + offset);
+}
+
+/******************************************************************************
+* Thread safe bump allocation, alignment is a power of two.
+* @return  address of bytes of uninitialized memory, NULL when out of memory.
+*****************************************************************************/
+void *arenaAllocate(runArena_t &arena, size_t bytes, size_t alignment) {
+  void *address;
+
+  pthread_mutex_lock(&arena.lock);
+  address = arenaAllocateUnlocked(arena, bytes, alignment);
+  pthread_mutex_unlock(&arena.lock);
+  return address;
+}
+
+/******************************************************************************
+* Registers a destructor to run when the arena is released.
+* @return  true when the finalizer was recorded.
+*****************************************************************************/
+bool arenaFinalizerAdd(runArena_t &arena, void (*destroy)(void *, size_t), void *address, size_t count) {
+  arenaFinalizer_t *finalizer;
+
+  pthread_mutex_lock(&arena.lock);
+  finalizer = (arenaFinalizer_t *) arenaAllocateUnlocked(arena, sizeof(arenaFinalizer_t), alignof(arenaFinalizer_t));
+  if (NULL != finalizer) {
+    finalizer->destroy = destroy;
+    finalizer->address = address;
+    finalizer->count = count;
+    finalizer->next = arena.finalizers;
+    arena.finalizers = finalizer;
+  }
+  pthread_mutex_unlock(&arena.lock);
+  return (NULL != finalizer);
+}
+
+/******************************************************************************
+* Runs the finalizers newest first and keeps every chunk as a spare, so the
+* next allocations reuse the memory instead of going back to malloc.
+* @return  None
+*****************************************************************************/
+void arenaReset(runArena_t &arena) {
+  arenaFinalizer_t *finalizer;
+  arenaChunk_t *chunk;
+
+  pthread_mutex_lock(&arena.lock);
+  for (finalizer = arena.finalizers; NULL != finalizer; finalizer = finalizer->next) {
+    finalizer->destroy(finalizer->address, finalizer->count);
+  }
+  arena.finalizers = NULL;
+  while (NULL != arena.chunks) {
+    chunk = arena.chunks;
+    arena.chunks = chunk->next;
+    chunk->next = arena.spares;
+    arena.spares = chunk;
+  }
+  pthread_mutex_unlock(&arena.lock);
+  return;
+}
+
+/******************************************************************************
+* Runs the finalizers newest first, then returns every chunk and spare. The
+* arena is empty and usable again afterwards.
+* @return  None
+*****************************************************************************/
+void arenaRelease(runArena_t &arena) {
+  arenaChunk_t *chunk;
+
+  arenaReset(arena);
+  pthread_mutex_lock(&arena.lock);
+  while (NULL != arena.spares) {
+    chunk = arena.spares;
+    arena.spares = chunk->next;
+    free(chunk);
+  }
+  arena.bytesReserved = 0;
+  pthread_mutex_unlock(&arena.lock);
+  return;
+}
+
 /******************************************************************************
 *
-* @return
+* @return  printable name of the frequency source.
+*****************************************************************************/
+const char *frequencySourceName(frequencySource_et source) {
+  const char *sourceName;
+  switch (source) {
+    case fq_msr_e:
+      sourceName = "APERF/MPERF from msr";
+      break;
+    case fq_scalingCurrent_e:
+      sourceName = "cpufreq scaling_cur_freq";
+      break;
+    case fq_perf_e:
+      sourceName = "perf cycles over reference cycles";
+      break;
+    case fq_none_e:
+    default:
+      sourceName = "none";
+      break;
+  }
+  return sourceName;
+}
+
+/******************************************************************************
+* Picks the first frequency source this process may read, records the
+* nominal frequency and starts the sampling thread. Without a source the
+* thread still tracks temperatures and throttle events.
+* @return  true when a frequency source was found.
+*****************************************************************************/
+bool frequencyMonitorStart(frequencyMonitor_t &monitor) {
+  double timeStart, timeDelta;
+  uint64_t cycleStart, throttleCount;
+
+  pthread_mutex_lock(&monitor.lock);
+  monitor.source = fq_none_e;
+  monitor.coreCount = getNumCores();
+  monitor.nominalMegahertz = 0.0;
+  monitor.totalActual = 0;
+  monitor.totalReference = 0;
+  monitor.totalMegahertzSum = 0.0;
+  monitor.totalSamples = 0;
+  monitor.celsiusCount = 0;
+  monitor.isStopping = false;
+  monitor.isPaused = false;
+  // The run arena is reset between repetitions, the per core arrays live until the monitor stops.
+  monitor.descriptors = (int *) calloc(monitor.coreCount, sizeof(int));
+  monitor.lastActual = (uint64_t *) calloc(monitor.coreCount, sizeof(uint64_t));
+  monitor.lastReference = (uint64_t *) calloc(monitor.coreCount, sizeof(uint64_t));
+  monitor.lastBusy = (uint64_t *) calloc(monitor.coreCount, sizeof(uint64_t));
+  if ((NULL == monitor.descriptors) || (NULL == monitor.lastActual) || (NULL == monitor.lastReference) ||
+      (NULL == monitor.lastBusy)) {
+    monitor.coreCount = 0;
+  }
+  for (size_t core = 0; core < monitor.coreCount; core++) {
+    monitor.descriptors[core] = -1;
+    monitor.lastActual[core] = 0;
+    monitor.lastReference[core] = 0;
+    monitor.lastBusy[core] = 0;
+  }
+#if defined(__linux__)
+  char fileName[CHAR_BUFFER_SIZE];
+  struct perf_event_attr eventAttributes;
+
+  // MSR reads need root and the msr module, every core that opens is sampled.
+  for (size_t core = 0; core < monitor.coreCount; core++) {
+    snprintf(fileName, sizeof(fileName), "/dev/cpu/%zu/msr", core);
+    monitor.descriptors[core] = open(fileName, O_RDONLY);
+    if ((monitor.descriptors[core] >= 0) &&
+        ((sizeof(uint64_t) != pread(monitor.descriptors[core], &monitor.lastActual[core], sizeof(uint64_t),
+                                    FREQUENCY_MSR_APERF)) ||
+         (sizeof(uint64_t) != pread(monitor.descriptors[core], &monitor.lastReference[core], sizeof(uint64_t),
+                                    FREQUENCY_MSR_MPERF)))) {
+      close(monitor.descriptors[core]);
+      monitor.descriptors[core] = -1;
+    }
+    if (monitor.descriptors[core] >= 0) {
+      monitor.source = fq_msr_e;
+    }
+  }
+  if ((fq_none_e == monitor.source) && (monitor.coreCount > 0) &&
+      (0 == access("/sys/devices/system/cpu/cpu0/cpufreq/scaling_cur_freq", R_OK))) {
+    monitor.source = fq_scalingCurrent_e;
+  }
+  // User space counts of this process are allowed at the default perf_event_paranoid level.
+  if ((fq_none_e == monitor.source) && (monitor.coreCount >= 2)) {
+    memset(&eventAttributes, 0, sizeof(eventAttributes));
+    eventAttributes.type = PERF_TYPE_HARDWARE;
+    eventAttributes.size = sizeof(eventAttributes);
+    eventAttributes.inherit = 1;
+    eventAttributes.exclude_kernel = 1;
+    eventAttributes.exclude_hv = 1;
+    eventAttributes.config = PERF_COUNT_HW_CPU_CYCLES;
+    monitor.descriptors[0] = (int) syscall(SYS_perf_event_open, &eventAttributes, 0, -1, -1, 0);
+    eventAttributes.config = PERF_COUNT_HW_REF_CPU_CYCLES;
+    monitor.descriptors[1] = (int) syscall(SYS_perf_event_open, &eventAttributes, 0, -1, -1, 0);
+    if ((monitor.descriptors[0] >= 0) && (monitor.descriptors[1] >= 0)) {
+      monitor.source = fq_perf_e;
+    } else {
+      for (size_t descriptor = 0; descriptor < 2; descriptor++) {
+        if (monitor.descriptors[descriptor] >= 0) {
+          close(monitor.descriptors[descriptor]);
+        }
+        monitor.descriptors[descriptor] = -1;
+      }
+    }
+  }
+#endif // defined(__linux__)
+  if (fq_none_e != monitor.source) {
+    timeStart = getTime();
+    cycleStart = getCycleCount();
+    do {
+      timeDelta = getTime() - timeStart;
+    } while (timeDelta < FREQUENCY_CALIBRATE_SECONDS);
+    monitor.nominalMegahertz = (double) (getCycleCount() - cycleStart) / (timeDelta * 1e6);
+  }
+  monitor.hasThrottleCount = thermalThrottleCount(throttleCount);
+  frequencyMonitorSampleUnlocked(monitor);
+  monitor.isStarted = (0 == pthread_create(&monitor.samplerContext, NULL, frequencyMonitor_Pthread, &monitor));
+  pthread_mutex_unlock(&monitor.lock);
+  printf("Frequency monitor source: %s, nominal %f MHz.\n", frequencySourceName(monitor.source),
+         monitor.nominalMegahertz);
+  return (fq_none_e != monitor.source);
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+void frequencyMonitorStop(frequencyMonitor_t &monitor) {
+  pthread_mutex_lock(&monitor.lock);
+  monitor.isStopping = true;
+  pthread_cond_signal(&monitor.wake);
+  pthread_mutex_unlock(&monitor.lock);
+  if (monitor.isStarted) {
+    pthread_join(monitor.samplerContext, NULL);
+  }
+  pthread_mutex_lock(&monitor.lock);
+  for (size_t core = 0; core < monitor.coreCount; core++) {
+    if (monitor.descriptors[core] >= 0) {
+      close(monitor.descriptors[core]);
+      monitor.descriptors[core] = -1;
+    }
+  }
+  free(monitor.descriptors);
+  free(monitor.lastActual);
+  free(monitor.lastReference);
+  free(monitor.lastBusy);
+  monitor.descriptors = NULL;
+  monitor.lastActual = NULL;
+  monitor.lastReference = NULL;
+  monitor.lastBusy = NULL;
+  monitor.source = fq_none_e;
+  monitor.coreCount = 0;
+  monitor.isStarted = false;
+  pthread_mutex_unlock(&monitor.lock);
+  return;
+}
+
+/******************************************************************************
+* Keeps the sampling thread off the cores while a measurement that is itself
+* sensitive to interruptions runs. Rows still sample when they are printed.
+* @return  None
+*****************************************************************************/
+void frequencyMonitorPause(frequencyMonitor_t &monitor, bool isPaused) {
+  pthread_mutex_lock(&monitor.lock);
+  monitor.isPaused = isPaused;
+  pthread_cond_signal(&monitor.wake);
+  pthread_mutex_unlock(&monitor.lock);
+  return;
+}
+
+/******************************************************************************
+* Adds the counter deltas or current frequencies to the totals and records
+* the hottest thermal zone in the history. scaling_cur_freq of a core is weighted by its busy
+* jiffies since the previous sample, idle cores parked at a low frequency do
+* not pull the average down. The caller holds the lock.
+* @return  None
+*****************************************************************************/
+void frequencyMonitorSampleUnlocked(frequencyMonitor_t &monitor) {
+  uint64_t actual, reference;
+  double megahertzSum = 0.0;
+  size_t megahertzCount = 0;
+
+#if defined(__linux__)
+  char fileName[CHAR_BUFFER_SIZE];
+  unsigned long long user, nice, system, irq, softirq, steal, busy;
+  std::vector<uint64_t> busyDelta(monitor.coreCount, 0);
+  double busyWeight = 0.0;
+  unsigned long kilohertz;
+  FILE *fileContext;
+  size_t core;
+
+  switch (monitor.source) {
+    case fq_msr_e:
+      for (size_t core = 0; core < monitor.coreCount; core++) {
+        if ((monitor.descriptors[core] >= 0) &&
+            (sizeof(uint64_t) == pread(monitor.descriptors[core], &actual, sizeof(actual), FREQUENCY_MSR_APERF)) &&
+            (sizeof(uint64_t) == pread(monitor.descriptors[core], &reference, sizeof(reference),
+                                       FREQUENCY_MSR_MPERF))) {
+          monitor.totalActual += actual - monitor.lastActual[core];
+          monitor.totalReference += reference - monitor.lastReference[core];
+          monitor.lastActual[core] = actual;
+          monitor.lastReference[core] = reference;
+        }
+      }
+      break;
+    case fq_scalingCurrent_e:
+      // Lines are cpuN user nice system idle iowait irq softirq steal, the first line is the total.
+      fileContext = fopen("/proc/stat", "r");
+      if (NULL != fileContext) {
+        while (NULL != fgets(fileName, sizeof(fileName), fileContext)) {
+          if (('0' <= fileName[3]) && ('9' >= fileName[3]) &&
+              (7 == sscanf(fileName, "cpu%zu %llu %llu %llu %*u %*u %llu %llu %llu", &core, &user, &nice, &system,
+                                 &irq, &softirq, &steal)) && (core < monitor.coreCount)) {
+            busy = user + nice + system + irq + softirq + steal;
+            busyDelta[core] = (0 != monitor.lastBusy[core]) ? (busy - monitor.lastBusy[core]) : 0;
+            monitor.lastBusy[core] = busy;
+          }
+        }
+        fclose(fileContext);
+      }
+      for (core = 0; core < monitor.coreCount; core++) {
+        snprintf(fileName, sizeof(fileName), "/sys/devices/system/cpu/cpu%zu/cpufreq/scaling_cur_freq", core);
+        fileContext = (busyDelta[core] > 0) ? fopen(fileName, "r") : NULL;
+        if (NULL != fileContext) {
+          if (1 == fscanf(fileContext, "%lu", &kilohertz)) {
+            megahertzSum += ((double) kilohertz / 1000.0) * (double) busyDelta[core];
+            busyWeight += (double) busyDelta[core];
+            megahertzCount++;
+          }
+          fclose(fileContext);
+        }
+      }
+      if (megahertzCount > 0) {
+        monitor.totalMegahertzSum += megahertzSum / busyWeight;
+        monitor.totalSamples++;
+      }
+      break;
+    case fq_perf_e:
+      if ((sizeof(uint64_t) == read(monitor.descriptors[0], &actual, sizeof(actual))) &&
+          (sizeof(uint64_t) == read(monitor.descriptors[1], &reference, sizeof(reference)))) {
+        monitor.totalActual += actual - monitor.lastActual[0];
+        monitor.totalReference += reference - monitor.lastReference[0];
+        monitor.lastActual[0] = actual;
+        monitor.lastReference[0] = reference;
+      }
+      break;
+    case fq_none_e:
+    default:
+      break;
+  }
+#else // !defined(__linux__)
+  (void) actual;
+  (void) reference;
+  (void) megahertzSum;
+  (void) megahertzCount;
+#endif // defined(__linux__)
+  monitor.celsiusHistory[monitor.celsiusCount % FREQUENCY_HISTORY_SAMPLES] = thermalZoneMaxCelsius();
+  monitor.celsiusCount++;
+  return;
+}
+
+/******************************************************************************
+* Samples the monitor every FREQUENCY_SAMPLE_MILLISECONDS so the hottest
+* temperature of long measurements is seen, until the monitor is stopped.
+* @return  the monitor.
+*****************************************************************************/
+void *frequencyMonitor_Pthread(void *inArgs) {
+  frequencyMonitor_t *monitor = (frequencyMonitor_t *) inArgs;
+  struct timespec wakeTime;
+
+  pthread_mutex_lock(&monitor->lock);
+  while (!monitor->isStopping) {
+    clock_gettime(CLOCK_REALTIME, &wakeTime);
+    wakeTime.tv_nsec += FREQUENCY_SAMPLE_MILLISECONDS * 1000000L;
+    wakeTime.tv_sec += wakeTime.tv_nsec / 1000000000L;
+    wakeTime.tv_nsec %= 1000000000L;
+    if (monitor->isPaused) {
+      pthread_cond_wait(&monitor->wake, &monitor->lock);
+    } else {
+      pthread_cond_timedwait(&monitor->wake, &monitor->lock, &wakeTime);
+    }
+    if (!monitor->isStopping && !monitor->isPaused) {
+      frequencyMonitorSampleUnlocked(*monitor);
+    }
+  }
+  pthread_mutex_unlock(&monitor->lock);
+  return inArgs;
+}
+
+/******************************************************************************
+* Samples the monitor and returns its totals, taken when a timed region
+* starts. Concurrent regions each hold their own snapshot.
+* @return  the totals, not valid while the monitor is stopped.
+*****************************************************************************/
+frequencySnapshot_t frequencyMonitorRead(frequencyMonitor_t &monitor) {
+  frequencySnapshot_t snapshot = {};
+
+  pthread_mutex_lock(&monitor.lock);
+  if (monitor.isStarted) {
+    frequencyMonitorSampleUnlocked(monitor);
+    snapshot.actual = monitor.totalActual;
+    snapshot.reference = monitor.totalReference;
+    snapshot.megahertzSum = monitor.totalMegahertzSum;
+    snapshot.samples = monitor.totalSamples;
+    snapshot.celsiusCount = monitor.celsiusCount;
+    snapshot.isValid = true;
+    if (monitor.hasThrottleCount) {
+      thermalThrottleCount(snapshot.throttleCount);
+    }
+  }
+  pthread_mutex_unlock(&monitor.lock);
+  return snapshot;
+}
+
+/******************************************************************************
+* Samples the monitor and reports the region since start. A region is
+* throttled when the average frequency is below FREQUENCY_THROTTLE_RATIO of
+* nominal or a thermal throttle counter moved. Regions longer than the
+* temperature history report the hottest of its most recent samples.
+* @return  the region values, negative when unknown.
+*****************************************************************************/
+frequencySample_t frequencyMonitorDelta(frequencyMonitor_t &monitor, const frequencySnapshot_t &start) {
+  frequencySample_t sample = frequencyUnknown;
+  uint64_t throttleCount;
+  size_t first;
+
+  pthread_mutex_lock(&monitor.lock);
+  if (monitor.isStarted && start.isValid) {
+    frequencyMonitorSampleUnlocked(monitor);
+    if (monitor.totalReference > start.reference) {
+      sample.megahertz = (monitor.nominalMegahertz * (double) (monitor.totalActual - start.actual)) /
+                         (double) (monitor.totalReference - start.reference);
+    } else if (monitor.totalSamples > start.samples) {
+      sample.megahertz = (monitor.totalMegahertzSum - start.megahertzSum) /
+                         (double) (monitor.totalSamples - start.samples);
+    }
+    first = ((monitor.celsiusCount - start.celsiusCount) > FREQUENCY_HISTORY_SAMPLES) ?
+            (monitor.celsiusCount - FREQUENCY_HISTORY_SAMPLES) : start.celsiusCount;
+    for (size_t index = first; index < monitor.celsiusCount; index++) {
+      if (monitor.celsiusHistory[index % FREQUENCY_HISTORY_SAMPLES] > sample.celsius) {
+        sample.celsius = monitor.celsiusHistory[index % FREQUENCY_HISTORY_SAMPLES];
+      }
+    }
+    sample.isThrottled = (sample.megahertz > 0.0) &&
+                         (sample.megahertz < (FREQUENCY_THROTTLE_RATIO * monitor.nominalMegahertz));
+    if (monitor.hasThrottleCount && thermalThrottleCount(throttleCount)) {
+      sample.isThrottled |= (throttleCount > start.throttleCount);
+    }
+    sample.isKnown = (fq_none_e != monitor.source) || monitor.hasThrottleCount;
+  }
+  pthread_mutex_unlock(&monitor.lock);
+  return sample;
+}
+
+/******************************************************************************
+* Finds the package zones intel-rapl:N and their core subzones
+* intel-rapl:N:M of the powercap class. The AMD RAPL driver registers the
+* same zones.
+* @return  true when at least one zone can be read.
+*****************************************************************************/
+bool energyMeterStart(energyMeter_t &meter) {
+  meter.domainCount = 0;
+  meter.hasCore = false;
+  meter.isShared = false;
+#if defined(__linux__)
+  const char powercapDirectory[] = "/sys/class/powercap";
+  char zoneName[CHAR_BUFFER_SIZE / 2], fileName[CHAR_BUFFER_SIZE]; // Zone paths are short, the file names fit
+  unsigned long long range;
+  FILE *fileContext;
+  bool isFound;
+
+  for (size_t package = 0; meter.domainCount < ENERGY_DOMAINS_MAX; package++) {
+    isFound = false;
+    for (size_t subzone = 0; meter.domainCount < ENERGY_DOMAINS_MAX; subzone++) {
+      // Subzone 0 of the walk is the package zone itself.
+      if (0 == subzone) {
+        snprintf(zoneName, sizeof(zoneName), "%s/intel-rapl:%zu", powercapDirectory, package);
+      } else {
+        snprintf(zoneName, sizeof(zoneName), "%s/intel-rapl:%zu:%zu", powercapDirectory, package, subzone - 1);
+      }
+      snprintf(fileName, sizeof(fileName), "%s/name", zoneName);
+      fileContext = fopen(fileName, "r");
+      if (NULL == fileContext) {
+        break;
+      }
+      isFound = true;
+      setCharArray(fileName);
+      if (NULL == fgets(fileName, sizeof(fileName), fileContext)) {
+        fileName[0] = '\0';
+      }
+      fclose(fileContext);
+      // Only packages and cores, uncore and dram zones would be counted twice or not at all.
+      if ((0 == subzone) || (0 == strncmp(fileName, "core", 4))) {
+        meter.isCore[meter.domainCount] = (0 != subzone);
+        snprintf(fileName, sizeof(fileName), "%s/max_energy_range_uj", zoneName);
+        fileContext = fopen(fileName, "r");
+        range = 0;
+        if (NULL != fileContext) {
+          if (1 != fscanf(fileContext, "%llu", &range)) {
+            range = 0;
+          }
+          fclose(fileContext);
+        }
+        meter.domainRanges[meter.domainCount] = range;
+        snprintf(meter.domainFiles[meter.domainCount], CHAR_BUFFER_SIZE, "%s/energy_uj", zoneName);
+        // Newer kernels restrict energy_uj to root.
+        if ((range > 0) && (0 == access(meter.domainFiles[meter.domainCount], R_OK))) {
+          meter.hasCore |= meter.isCore[meter.domainCount];
+          meter.domainCount++;
+        }
+      }
+    }
+    if (!isFound) {
+      break;
+    }
+  }
+#endif // defined(__linux__)
+  if (meter.domainCount > 0) {
+    printf("Energy counters: %zu powercap zones, core zones %s.\n", meter.domainCount,
+           meter.hasCore ? "present" : "absent");
+  } else {
+    printf("Energy counters: powercap is absent or unreadable, energy columns stay empty.\n");
+  }
+  return (meter.domainCount > 0);
+}
+
+/******************************************************************************
+*
+* @return  counters of every zone, isValid false when one could not be read.
+*****************************************************************************/
+energyCounters_t energyRead(const energyMeter_t &meter) {
+  energyCounters_t counters;
+  unsigned long long microjoules;
+  FILE *fileContext;
+
+  counters.isValid = (meter.domainCount > 0) && !meter.isShared;
+  for (size_t domain = 0; counters.isValid && (domain < meter.domainCount); domain++) {
+    fileContext = fopen(meter.domainFiles[domain], "r");
+    counters.isValid = (NULL != fileContext) && (1 == fscanf(fileContext, "%llu", &microjoules));
+    counters.microjoules[domain] = counters.isValid ? microjoules : 0;
+    if (NULL != fileContext) {
+      fclose(fileContext);
+    }
+  }
+  return counters;
+}
+
+/******************************************************************************
+* A counter below its start value wrapped once; regions long enough to wrap
+* twice (minutes at full package power) are not detectable.
+* @return  package and core joules, negative when either read failed.
+*****************************************************************************/
+energySample_t energyDelta(const energyMeter_t &meter, const energyCounters_t &start, const energyCounters_t &stop) {
+  energySample_t sample = {-1.0, -1.0};
+  uint64_t microjoules;
+
+  if (start.isValid && stop.isValid) {
+    sample.packageJoules = 0.0;
+    sample.coreJoules = meter.hasCore ? 0.0 : -1.0;
+    for (size_t domain = 0; domain < meter.domainCount; domain++) {
+      if (stop.microjoules[domain] >= start.microjoules[domain]) {
+        microjoules = stop.microjoules[domain] - start.microjoules[domain];
+      } else {
+        microjoules = (meter.domainRanges[domain] - start.microjoules[domain]) + stop.microjoules[domain];
+      }
+      if (meter.isCore[domain]) {
+        sample.coreJoules += (double) microjoules * 1e-6;
+      } else {
+        sample.packageJoules += (double) microjoules * 1e-6;
+      }
+    }
+  }
+  return sample;
+}
+
+/******************************************************************************
+* Reads every thermal zone, zones are numbered without gaps.
+* @return  hottest zone in degrees Celsius, negative when there is none.
+*****************************************************************************/
+double thermalZoneMaxCelsius(void) {
+  double celsius = -1.0;
+#if defined(__linux__)
+  char fileName[CHAR_BUFFER_SIZE];
+  long millidegrees;
+  FILE *fileContext;
+
+  for (size_t zone = 0;; zone++) {
+    snprintf(fileName, sizeof(fileName), "/sys/class/thermal/thermal_zone%zu/temp", zone);
+    fileContext = fopen(fileName, "r");
+    if (NULL == fileContext) {
+      break;
+    }
+    if ((1 == fscanf(fileContext, "%ld", &millidegrees)) && (((double) millidegrees / 1000.0) > celsius)) {
+      celsius = (double) millidegrees / 1000.0;
+    }
+    fclose(fileContext);
+  }
+#endif // defined(__linux__)
+  return celsius;
+}
+
+/******************************************************************************
+* Sums the core and package thermal throttle event counters of every core.
+* @return  true when at least one counter exists.
+*****************************************************************************/
+bool thermalThrottleCount(uint64_t &throttleCount) {
+  bool isFound = false;
+  throttleCount = 0;
+#if defined(__linux__)
+  const char *counterNames[2] = {"core_throttle_count", "package_throttle_count"};
+  char fileName[CHAR_BUFFER_SIZE];
+  unsigned long long counter;
+  FILE *fileContext;
+
+  for (size_t core = 0; core < getNumCores(); core++) {
+    for (size_t name = 0; name < 2; name++) {
+      snprintf(fileName, sizeof(fileName), "/sys/devices/system/cpu/cpu%zu/thermal_throttle/%s", core,
+               counterNames[name]);
+      fileContext = fopen(fileName, "r");
+      if (NULL != fileContext) {
+        if (1 == fscanf(fileContext, "%llu", &counter)) {
+          throttleCount += counter;
+          isFound = true;
+        }
+        fclose(fileContext);
+      }
+    }
+  }
+#endif // defined(__linux__)
+  return isFound;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+template<typename Type>
+void safeAllocDestroy(void *address, size_t count) {
+  Type *objects = (Type *) address;
+
+  for (size_t index = 0; index < count; index++) {
+    objects[index].~Type();
+  }
+  return;
+}
+
+/******************************************************************************
+* Constructs size objects (at least one) in the harness arena. They are never
+* freed one by one, the arena releases them when the run ends.
+* @return  true when the allocation succeeded.
 *****************************************************************************/
 template<typename Type>
 bool safeAlloc(Type *&address, size_t size) {
   bool isValid = false;
 
 # if !ENABLE_BASIC_C_ALLOC
-  if (size <= 1) {
-    address = new Type;
-  } else {
-    address = new Type[size];
+  size_t count = (size <= 1) ? 1 : size;
+
+  address = (Type *) arenaAllocate(harnessArena, sizeof(Type) * count, alignof(Type));
+  if (NULL != address) {
+    for (size_t index = 0; index < count; index++) {
+      new(address + index) Type();
+    }
+    if (!std::is_trivially_destructible<Type>::value) {
+      arenaFinalizerAdd(harnessArena, safeAllocDestroy<Type>, address, count);
+    }
   }
   isValid = (NULL != address);
 #else // ENABLE_BASIC_C_ALLOC
@@ -1229,6 +3025,26 @@ void showUsage(void) {
   printf("Usage: <option(s)> PARAMETER\n");
   printf("Options:\n");
   printf("\t-h, --help\t\tShow this help message\n");
+  printf("\t-m, --mode NAME\t\tBenchmark family, arithmetic is the default:\n\t\t\t\t");
+  for (size_t mode = 0; mode < bm_unknown_e; mode++) {
+    printf("%s%s", benchmarkModeNames[mode], ((mode + 1) < bm_unknown_e) ? ", " : "\n");
+  }
+  printf("\t-n, --iterations N\tLoop iterations per measurement, 0 selects the family default\n");
+  printf("\t-t, --threads N\t\tThreads to use, 0 selects the online core count\n");
+  printf("\t--pattern-length N\tPeriod of periodic branch patterns (default 16)\n");
+  printf("\t--targets N\t\tTargets of indirect branch tables (default 8)\n");
+  printf("\t--distribution NAME\tSummation inputs: uniform, gaussian, wide or cancel (default all)\n");
+  printf("\t--repeat N\t\tRuns of the family appended to the same result files (default 1)\n");
+  printf("\t--baseline FILE\t\tCompare mode result file to measure against\n");
+  printf("\t--candidate FILE\tCompare mode result file checked for regressions\n");
+  printf("\t--metric NAME\t\tCompare mode column, the first measurement by default\n");
+  printf("\t--threshold PERCENT\tCompare mode worsening of a median that fails the run (default 5)\n");
+  printf("\t--significance P\tCompare mode largest p value of a real shift (default 0.05)\n");
+  printf("\t--store DIR\t\tResult store the run is appended to and query mode reads\n");
+  printf("\t--fingerprint HEX\tQuery mode host fingerprint prefix\n");
+  printf("\t--family NAME\t\tQuery mode result family, such as Syscall\n");
+  printf("\t--type NAME\t\tQuery mode Type System\n");
+  printf("\t--operation TEXT\tQuery mode text the operation contains\n");
 }
 
 /******************************************************************************
@@ -1256,14 +3072,310 @@ void printArgs(int argc, char *argv[]) {
   return;
 }
 
+/******************************************************************************
+* Parses command line options into the benchmark options.
+* @return  true if all options were understood.
+*          false if an option or its parameter is invalid.
+*****************************************************************************/
+bool parseArgs(int argc, char *argv[], benchmarkOptions_t &options) {
+  bool isValid = true;
+  const char *option;
+  const char *parameter;
+
+  for (int i = 1; (i < argc) && isValid; i++) {
+    option = argv[i];
+    parameter = ((i + 1) < argc) ? argv[i + 1] : NULL;
+    if ((0 == strcmp(option, "-h")) || (0 == strcmp(option, "--help"))) {
+      options.showHelp = true;
+      continue;
+    }
+    if (NULL == parameter) {
+      fprintf(stderr, "Option %s requires a parameter.\n", option);
+      isValid = false;
+      break;
+    }
+    if ((0 == strcmp(option, "-m")) || (0 == strcmp(option, "--mode"))) {
+      options.mode = bm_unknown_e;
+      for (size_t mode = 0; mode < bm_unknown_e; mode++) {
+        if (0 == strcmp(parameter, benchmarkModeNames[mode])) {
+          options.mode = (benchmarkMode_et) mode;
+          break;
+        }
+      }
+      if (bm_unknown_e == options.mode) {
+        fprintf(stderr, "Unknown mode %s.\n", parameter);
+        isValid = false;
+      }
+    } else if ((0 == strcmp(option, "-n")) || (0 == strcmp(option, "--iterations"))) {
+      options.iterations = strtoull(parameter, NULL, 0);
+    } else if ((0 == strcmp(option, "-t")) || (0 == strcmp(option, "--threads"))) {
+      options.threadCount = strtoull(parameter, NULL, 0);
+    } else if (0 == strcmp(option, "--pattern-length")) {
+      options.patternLength = std::max((size_t) 1, (size_t) strtoull(parameter, NULL, 0));
+    } else if (0 == strcmp(option, "--targets")) {
+      options.targetCount = std::max((size_t) 1, (size_t) strtoull(parameter, NULL, 0));
+    } else if (0 == strcmp(option, "--distribution")) {
+      options.distribution = parameter;
+    } else if (0 == strcmp(option, "--repeat")) {
+      options.repeatCount = std::max((size_t) 1, (size_t) strtoull(parameter, NULL, 0));
+    } else if (0 == strcmp(option, "--baseline")) {
+      options.baselineFile = parameter;
+    } else if (0 == strcmp(option, "--candidate")) {
+      options.candidateFile = parameter;
+    } else if (0 == strcmp(option, "--metric")) {
+      options.metric = parameter;
+    } else if (0 == strcmp(option, "--threshold")) {
+      options.threshold = fabs(strtod(parameter, NULL));
+    } else if (0 == strcmp(option, "--significance")) {
+      options.significance = strtod(parameter, NULL);
+    } else if (0 == strcmp(option, "--store")) {
+      options.storeDirectory = parameter;
+    } else if (0 == strcmp(option, "--fingerprint")) {
+      options.fingerprint = parameter;
+    } else if (0 == strcmp(option, "--family")) {
+      options.family = parameter;
+    } else if (0 == strcmp(option, "--type")) {
+      options.typeName = parameter;
+    } else if (0 == strcmp(option, "--operation")) {
+      options.operation = parameter;
+    } else {
+      fprintf(stderr, "Unknown option %s.\n", option);
+      isValid = false;
+    }
+    i++;
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* Selects the core for a thread index from the process affinity mask, so
+* pinned threads stay inside any cpuset the harness was started with.
+* @return  core number to pin the thread to.
+*****************************************************************************/
+size_t threadCoreSelect(size_t threadIndex) {
+  size_t coreSelect = threadIndex;
+#if defined(__linux__)
+  cpu_set_t allowedSet;
+  size_t allowedCount;
+  size_t allowedIndex;
+
+  CPU_ZERO(&allowedSet);
+  if (0 == sched_getaffinity(0, sizeof(allowedSet), &allowedSet)) {
+    allowedCount = CPU_COUNT(&allowedSet);
+    if (allowedCount > 0) {
+      allowedIndex = threadIndex % allowedCount;
+      for (size_t core = 0; core < CPU_SETSIZE; core++) {
+        if (CPU_ISSET(core, &allowedSet)) {
+          if (0 == allowedIndex) {
+            coreSelect = core;
+            break;
+          }
+          allowedIndex--;
+        }
+      }
+    }
+  }
+#endif // defined(__linux__)
+  return coreSelect;
+}
+
+/******************************************************************************
+* Waits at the team gate, then runs the team function. The family barriers
+* count every thread of the team, so a thread of an aborted team returns
+* without reaching them.
+* @return  the result of the team function, NULL when the team was aborted.
+*****************************************************************************/
+void *threadTeam_Pthread(void *inArgs) {
+  threadTeamStart_t *threadStart = (threadTeamStart_t *) inArgs;
+  threadTeamGate_t *gate = threadStart->gate;
+  bool isAborted;
+
+  pthread_mutex_lock(&gate->lock);
+  while (!gate->isOpen && !gate->isAborted) {
+    pthread_cond_wait(&gate->opened, &gate->lock);
+  }
+  isAborted = gate->isAborted;
+  pthread_mutex_unlock(&gate->lock);
+  return isAborted ? NULL : threadStart->threadFunction(threadStart->threadArgs);
+}
+
+/******************************************************************************
+* Runs one thread per argument and waits for all of them. Threads are
+* optionally pinned to distinct cores before they start. No thread runs until
+* every thread is created; when one creation fails the team is aborted.
+* @return  true if every thread was created and joined.
+*****************************************************************************/
+bool threadTeamRun(func_ptr threadFunction, std::vector<void *> &threadArgs, bool isPinned) {
+  bool isValid = true;
+  size_t threadCount = threadArgs.size();
+  size_t threadStatus;
+  std::vector<pthread_t> threadContext(threadCount);
+  std::vector<bool> isStarted(threadCount, false);
+  std::vector<threadTeamStart_t> threadStart(threadCount);
+  threadTeamGate_t gate;
+  pthread_attr_t threadAttributes;
+
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    pthread_attr_init(&threadAttributes);
+#if defined(__linux__)
+    if (isPinned) {
+      cpu_set_t coreSet;
+      CPU_ZERO(&coreSet);
+      CPU_SET(threadCoreSelect(threadIndex), &coreSet);
+      pthread_attr_setaffinity_np(&threadAttributes, sizeof(coreSet), &coreSet);
+    }
+#endif // defined(__linux__)
+    threadStart[threadIndex].gate = &gate;
+    threadStart[threadIndex].threadFunction = threadFunction;
+    threadStart[threadIndex].threadArgs = threadArgs[threadIndex];
+    threadStatus = pthread_create(&threadContext[threadIndex], &threadAttributes, threadTeam_Pthread,
+                                  &threadStart[threadIndex]);
+    pthread_attr_destroy(&threadAttributes);
+    if (0 == threadStatus) {
+      isStarted[threadIndex] = true;
+    } else {
+      asserterrorthread(threadIndex);
+      isValid = false;
+      break;
+    }
+  }
+  pthread_mutex_lock(&gate.lock);
+  gate.isOpen = isValid;
+  gate.isAborted = !isValid;
+  pthread_cond_broadcast(&gate.opened);
+  pthread_mutex_unlock(&gate.lock);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    if (isStarted[threadIndex]) {
+      pthread_join(threadContext[threadIndex], NULL);
+    }
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* Repetitions after the first keep the metadata block and header of the first
+* and append their rows, compare mode reads rows with the same key as samples.
+* @return  true if the file exists and rows are appended to it.
+*****************************************************************************/
+bool resultFileIsContinued(const char fileName[CHAR_BUFFER_SIZE]) {
+  return (harnessRepetition > 0) && (fs_Found_vet == fileIsFound(fileName));
+}
+
+/******************************************************************************
+* Creates a result file for a benchmark family in the data directory next to
+* the per-thread arithmetic results and writes the header line, followed by
+* the frequency monitor columns when the rows are measurements. Under
+* --repeat the file of the first repetition is reopened instead.
+* @return  file context opened in a+ mode, NULL on failure.
+*****************************************************************************/
+FILE *resultFileOpen(const char *familyName, const char *fileHeader, bool isMonitored,
+                     char fileNameAbsolute[CHAR_BUFFER_SIZE]) {
+#if (defined(__WIN64__) && defined(__WIN64__))
+  const char fileDirectory[] = "\\data\\";
+#else // !(defined(__WIN64__) && defined(__WIN64__))
+  const char fileDirectory[] = "/data/";
+#endif // (defined(__WIN64__) && defined(__WIN64__))
+  const char fileNamePrefix[] = "cpuBenchmark";
+  const char fileExtension[] = "cvs";
+  const char monitorHeader[] = ", Average MHz, Max Celsius, Throttled";
+  char directoryTree[CHAR_BUFFER_SIZE];
+  char directoryPath[CHAR_BUFFER_SIZE];
+  char headerAnnotated[CHAR_BUFFER_SIZE + sizeof(monitorHeader)];
+  FILE *fileContext = NULL;
+
+  setCharArray(directoryTree);
+  setCharArray(directoryPath);
+  setCharArray(fileNameAbsolute);
+  fileUpCurrentDirectory(directoryTree);
+  snprintf(fileNameAbsolute, CHAR_BUFFER_SIZE, "%s%s%s%s.%s",
+           directoryTree, fileDirectory, fileNamePrefix, familyName, fileExtension);
+
+  if (resultFileIsContinued(fileNameAbsolute)) {
+    fileContext = fopen(fileNameAbsolute, "a+");
+  } else {
+    if (fs_Found_vet == fileIsFound(fileNameAbsolute)) {
+      fileDelete(fileNameAbsolute);
+    } else {
+      fileGetDirectory(fileNameAbsolute, directoryPath);
+      fileMakeDirectories(directoryPath);
+    }
+    // resultPrintRow appends the frequency monitor cells to the rows of a timed region.
+    snprintf(headerAnnotated, sizeof(headerAnnotated), "%.*s%s", CHAR_BUFFER_SIZE - 1, fileHeader,
+             isMonitored ? monitorHeader : "");
+    if (fileCreate(fileNameAbsolute, headerAnnotated)) {
+      fileContext = fopen(fileNameAbsolute, "a+");
+    }
+  }
+  if (NULL == fileContext) {
+    asserterror();
+  } else {
+    printf("File %s opened in a+ mode.\n", fileNameAbsolute);
+  }
+  return fileContext;
+}
+
+/******************************************************************************
+* Closes a family result file and prints where it was written.
+* @return  None
+*****************************************************************************/
+void resultFileClose(FILE *fileContext, const char fileNameAbsolute[CHAR_BUFFER_SIZE]) {
+  if (NULL != fileContext) {
+    fclose(fileContext);
+    printFullPath(fileNameAbsolute);
+  }
+  return;
+}
+
+/******************************************************************************
+* Formats one result row, annotates it with the average frequency, hottest
+* temperature and throttle flag of its timed region, appends it to the
+* result file and optionally echos it to stdout. Rows of files without
+* monitor columns pass no region. Unknown cells stay empty.
+* @return  None
+*****************************************************************************/
+void resultPrintRow(FILE *fileContext, bool isEcho, const frequencySample_t *frequency, const char *format, ...) {
+  char printBuffer[CHAR_BUFFER_SIZE];
+  va_list formatArgs;
+  size_t length;
+
+  setCharArray(printBuffer);
+  va_start(formatArgs, format);
+  vsnprintf(printBuffer, CHAR_BUFFER_SIZE, format, formatArgs);
+  va_end(formatArgs);
+  if (NULL != frequency) {
+    length = strlen(printBuffer);
+    if (frequency->megahertz > 0.0) {
+      length += snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ", %.1f", frequency->megahertz);
+    } else {
+      length += snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ", ");
+    }
+    if ((length < CHAR_BUFFER_SIZE) && (frequency->celsius >= 0.0)) {
+      length += snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ", %.1f", frequency->celsius);
+    } else if (length < CHAR_BUFFER_SIZE) {
+      length += snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ", ");
+    }
+    if ((length < CHAR_BUFFER_SIZE) && frequency->isKnown) {
+      snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ", %d", frequency->isThrottled ? 1 : 0);
+    } else if (length < CHAR_BUFFER_SIZE) {
+      snprintf(printBuffer + length, CHAR_BUFFER_SIZE - length, ",");
+    }
+  }
+  if (isEcho) {
+    printf("%s\n", printBuffer);
+  }
+  if (NULL != fileContext) {
+    fprintf(fileContext, "%s\n", printBuffer);
+  }
+  return;
+}
+
 /******************************************************************************
 *
 * @return
 *****************************************************************************/
 int32_t printFullPath(const char *partialPath) {
   int32_t rc = 0;
-  char *fullPath = NULL;
-  safeAlloc<char>(fullPath, PATH_MAX);
+  char fullPath[PATH_MAX]; // Called once per result file, a scratch buffer rather than a run allocation
 #if (defined(_WIN32) | defined(_WIN64))
   if (_fullpath(fullPath, partialPath, PATH_MAX) != NULL) {
     printf("Path, %s, %s\n", partialPath, fullPath);
@@ -1320,6 +3432,97 @@ double getTime(void) {
 # endif
 }
 
+/******************************************************************************
+* Reads the time stamp counter, which ticks at the nominal frequency. Other
+* architectures derive reference cycles from the wall clock.
+* @return  reference cycles since an arbitrary point.
+*****************************************************************************/
+uint64_t getCycleCount(void) {
+#if defined(__x86_64__) | defined(__i386__)
+  return __rdtsc();
+#else // !(defined(__x86_64__) | defined(__i386__))
+  static long double cyclesPerSecond = 0.0;
+  if (cyclesPerSecond <= 0.0) {
+    cyclesPerSecond = getCPUFrequency() * 1000.0;
+  }
+  return (uint64_t) (getTime() * cyclesPerSecond);
+#endif // defined(__x86_64__) | defined(__i386__)
+}
+
+/******************************************************************************
+* Reads the data or unified cache size of a level from sysfs, falling back to
+* sysconf where the cache topology is not exported.
+* @return  cache size in bytes, 0 when unknown.
+*****************************************************************************/
+size_t getCacheSize(size_t level) {
+  size_t cacheSize = 0;
+#if defined(__linux__)
+  char fileName[CHAR_BUFFER_SIZE];
+  char cacheType[CHAR_BUFFER_SIZE];
+  char sizeUnit;
+  unsigned long cacheLevel;
+  unsigned long sizeValue;
+  FILE *fileContext;
+  bool isMatch;
+
+  for (size_t index = 0; (index < 16) && (0 == cacheSize); index++) {
+    snprintf(fileName, CHAR_BUFFER_SIZE, "/sys/devices/system/cpu/cpu0/cache/index%zu/level", index);
+    fileContext = fopen(fileName, "r");
+    if (NULL == fileContext) {
+      break;
+    }
+    isMatch = (1 == fscanf(fileContext, "%lu", &cacheLevel)) && (cacheLevel == level);
+    fclose(fileContext);
+    if (!isMatch) {
+      continue;
+    }
+    snprintf(fileName, CHAR_BUFFER_SIZE, "/sys/devices/system/cpu/cpu0/cache/index%zu/type", index);
+    fileContext = fopen(fileName, "r");
+    if (NULL == fileContext) {
+      continue;
+    }
+    isMatch = (1 == fscanf(fileContext, "%1023s", cacheType)) && (0 != strcmp(cacheType, "Instruction"));
+    fclose(fileContext);
+    if (!isMatch) {
+      continue;
+    }
+    snprintf(fileName, CHAR_BUFFER_SIZE, "/sys/devices/system/cpu/cpu0/cache/index%zu/size", index);
+    fileContext = fopen(fileName, "r");
+    if (NULL == fileContext) {
+      continue;
+    }
+    sizeUnit = 'B';
+    if (fscanf(fileContext, "%lu%c", &sizeValue, &sizeUnit) >= 1) {
+      cacheSize = sizeValue;
+      if ('K' == sizeUnit) {
+        cacheSize = sizeValue << 10;
+      } else if ('M' == sizeUnit) {
+        cacheSize = sizeValue << 20;
+      } else if ('G' == sizeUnit) {
+        cacheSize = sizeValue << 30;
+      }
+    }
+    fclose(fileContext);
+  }
+#if defined(_SC_LEVEL1_DCACHE_SIZE)
+  if (0 == cacheSize) {
+    long sysconfSize = -1;
+    if (1 == level) {
+      sysconfSize = sysconf(_SC_LEVEL1_DCACHE_SIZE);
+    } else if (2 == level) {
+      sysconfSize = sysconf(_SC_LEVEL2_CACHE_SIZE);
+    } else if (3 == level) {
+      sysconfSize = sysconf(_SC_LEVEL3_CACHE_SIZE);
+    }
+    cacheSize = (sysconfSize > 0) ? (size_t) sysconfSize : 0;
+  }
+#endif // defined(_SC_LEVEL1_DCACHE_SIZE)
+#else // !defined(__linux__)
+  (void) level;
+#endif // defined(__linux__)
+  return cacheSize;
+}
+
 /******************************************************************************
 *
 * @return
@@ -1571,6 +3774,59 @@ classType typelessValid(int select, bool debug) {
         isValid_Numerical = (FP_NORMAL == std::fpclassify(candidateValue.longdouble_data));
         snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=long_double, A=%Lf\n", candidateValue.longdouble_data);
         break;
+#if TYPELESS_INT128_ENABLE
+      case tse_int128_e:
+        candidateValue.int128_data = (typelessInt128_t) inType;
+        isValid_Numerical = true;
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=int128, A=%Lf\n", (long double) candidateValue.int128_data);
+        break;
+      case tse_uint128_e:
+        candidateValue.uint128_data = (typelessUInt128_t) inType;
+        isValid_Numerical = true;
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=uint128, A=%Lf\n",
+                 (long double) candidateValue.uint128_data);
+        break;
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+      case tse_float16_e:
+        candidateValue.float16_data = (typelessFloat16_t) inType;
+        isValid_Numerical = (FP_NORMAL == std::fpclassify((float) candidateValue.float16_data));
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=float16, A=%f\n", (float) candidateValue.float16_data);
+        break;
+#endif // TYPELESS_FLOAT16_ENABLE
+      case tse_bfloat16_e:
+        candidateValue.bfloat16_data = (typelessBFloat16_t) inType;
+        isValid_Numerical = (FP_NORMAL == std::fpclassify((float) candidateValue.bfloat16_data));
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=bfloat16, A=%f\n", (float) candidateValue.bfloat16_data);
+        break;
+#if TYPELESS_FLOAT128_ENABLE
+      case tse_float128_e:
+        candidateValue.float128_data = (typelessFloat128_t) inType;
+        isValid_Numerical = (FP_NORMAL == std::fpclassify((long double) candidateValue.float128_data));
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=float128, A=%Lf\n",
+                 (long double) candidateValue.float128_data);
+        break;
+#endif // TYPELESS_FLOAT128_ENABLE
+      case tse_fixed_q7_8_e:
+        candidateValue.fixedQ7_8_data = (typelessFixedQ7_8_t) inType;
+        isValid_Numerical = (0 != candidateValue.fixedQ7_8_data.raw);
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=fixedq7.8, A=%Lf\n",
+                 (long double) candidateValue.fixedQ7_8_data);
+        break;
+      case tse_fixed_q15_16_e:
+        candidateValue.fixedQ15_16_data = (typelessFixedQ15_16_t) inType;
+        isValid_Numerical = (0 != candidateValue.fixedQ15_16_data.raw);
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=fixedq15.16, A=%Lf\n",
+                 (long double) candidateValue.fixedQ15_16_data);
+        break;
+#if TYPELESS_INT128_ENABLE
+      case tse_fixed_q31_32_e:
+        candidateValue.fixedQ31_32_data = (typelessFixedQ31_32_t) inType;
+        isValid_Numerical = (0 != candidateValue.fixedQ31_32_data.raw);
+        snprintf(printBuffer, CHAR_BUFFER_SIZE, "Operation=fixedq31.32, A=%Lf\n",
+                 (long double) candidateValue.fixedQ31_32_data);
+        break;
+#endif // TYPELESS_INT128_ENABLE
       default:
         isValid_Numerical = false;
         asserterror();
@@ -1585,6 +3841,52 @@ classType typelessValid(int select, bool debug) {
   return inType;
 }
 
+/******************************************************************************
+* Mangled name of the type as typeid reports it.
+* @return  type name string.
+*****************************************************************************/
+template<class classType>
+const char *typelessTypeName(void) {
+  const char *typeName;
+#if TYPELESS_FLOAT16_ENABLE
+  // libstdc++ before GCC 13 exports no type_info for _Float16, its Itanium name is used instead.
+  if constexpr (std::is_same<classType, typelessFloat16_t>::value) {
+    typeName = "DF16_";
+  } else {
+    typeName = typeid(classType).name();
+  }
+#else // !TYPELESS_FLOAT16_ENABLE
+  typeName = typeid(classType).name();
+#endif // TYPELESS_FLOAT16_ENABLE
+  return typeName;
+}
+
+#if TYPELESS_INT128_ENABLE
+/******************************************************************************
+* Decimal digits of a 128 bit integer, printf has no conversion for them.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void typelessInt128String(classType inA, char printBuffer[TYPELESS_INT128_DIGITS]) {
+  char digits[TYPELESS_INT128_DIGITS];
+  size_t digitIndex = sizeof(digits) - 1;
+  typelessInt128_t value = (typelessInt128_t) inA;
+  bool isNegative = std::is_signed<classType>::value && (value < 0);
+  typelessUInt128_t magnitude = isNegative ? (0 - (typelessUInt128_t) value) : (typelessUInt128_t) inA;
+
+  digits[digitIndex] = '\0';
+  do {
+    digits[--digitIndex] = (char) ('0' + (int) (magnitude % 10));
+    magnitude /= 10;
+  } while (magnitude > 0);
+  if (isNegative) {
+    digits[--digitIndex] = '-';
+  }
+  snprintf(printBuffer, TYPELESS_INT128_DIGITS, "%s", &digits[digitIndex]);
+  return;
+}
+#endif // TYPELESS_INT128_ENABLE
+
 /******************************************************************************
 *
 * @return
@@ -1597,7 +3899,7 @@ TypeSystemEnumeration_t typelessClassify(classType inType) {
   size_t minSize;
 
   detectedType = tse_unknown_e;
-  inName = (char *) typeid(inType).name();
+  inName = (char *) typelessTypeName<classType>();
   inASize = strlen(inName);
   minSize = std::min(inASize, (size_t) CHAR_BUFFER_SIZE);
 
@@ -1612,6 +3914,20 @@ TypeSystemEnumeration_t typelessClassify(classType inType) {
   const char *float_Name = typeid(float).name();
   const char *double_Name = typeid(double).name();
   const char *long_double_Name = typeid(long double).name();
+  const char *bfloat16_Name = typeid(typelessBFloat16_t).name();
+  const char *fixed_q7_8_Name = typeid(typelessFixedQ7_8_t).name();
+  const char *fixed_q15_16_Name = typeid(typelessFixedQ15_16_t).name();
+#if TYPELESS_INT128_ENABLE
+  const char *int128_Name = typeid(typelessInt128_t).name();
+  const char *uint128_Name = typeid(typelessUInt128_t).name();
+  const char *fixed_q31_32_Name = typeid(typelessFixedQ31_32_t).name();
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+  const char *float16_Name = typelessTypeName<typelessFloat16_t>();
+#endif // TYPELESS_FLOAT16_ENABLE
+#if TYPELESS_FLOAT128_ENABLE
+  const char *float128_Name = typeid(typelessFloat128_t).name();
+#endif // TYPELESS_FLOAT128_ENABLE
 
   minSize = std::min(inASize, (size_t) strlen(uint8_Name));
   bool match_uint8_Name = (0 == strncmp(inName, uint8_Name, minSize));
@@ -1635,6 +3951,33 @@ TypeSystemEnumeration_t typelessClassify(classType inType) {
   bool match_double_Name = (0 == strncmp(inName, double_Name, minSize));
   minSize = std::min(inASize, (size_t) strlen(long_double_Name));
   bool match_long_double_Name = (0 == strncmp(inName, long_double_Name, minSize));
+  minSize = std::min(inASize, (size_t) strlen(bfloat16_Name));
+  bool match_bfloat16_Name = (0 == strncmp(inName, bfloat16_Name, minSize));
+  minSize = std::min(inASize, (size_t) strlen(fixed_q7_8_Name));
+  bool match_fixed_q7_8_Name = (0 == strncmp(inName, fixed_q7_8_Name, minSize));
+  minSize = std::min(inASize, (size_t) strlen(fixed_q15_16_Name));
+  bool match_fixed_q15_16_Name = (0 == strncmp(inName, fixed_q15_16_Name, minSize));
+  bool match_int128_Name = false;
+  bool match_uint128_Name = false;
+  bool match_fixed_q31_32_Name = false;
+  bool match_float16_Name = false;
+  bool match_float128_Name = false;
+#if TYPELESS_INT128_ENABLE
+  minSize = std::min(inASize, (size_t) strlen(int128_Name));
+  match_int128_Name = (0 == strncmp(inName, int128_Name, minSize));
+  minSize = std::min(inASize, (size_t) strlen(uint128_Name));
+  match_uint128_Name = (0 == strncmp(inName, uint128_Name, minSize));
+  minSize = std::min(inASize, (size_t) strlen(fixed_q31_32_Name));
+  match_fixed_q31_32_Name = (0 == strncmp(inName, fixed_q31_32_Name, minSize));
+#endif // TYPELESS_INT128_ENABLE
+#if TYPELESS_FLOAT16_ENABLE
+  minSize = std::min(inASize, (size_t) strlen(float16_Name));
+  match_float16_Name = (0 == strncmp(inName, float16_Name, minSize));
+#endif // TYPELESS_FLOAT16_ENABLE
+#if TYPELESS_FLOAT128_ENABLE
+  minSize = std::min(inASize, (size_t) strlen(float128_Name));
+  match_float128_Name = (0 == strncmp(inName, float128_Name, minSize));
+#endif // TYPELESS_FLOAT128_ENABLE
 
   if (match_int8_Name) {
     detectedType = tse_int8_e;
@@ -1658,6 +4001,22 @@ TypeSystemEnumeration_t typelessClassify(classType inType) {
     detectedType = tse_double_e;
   } else if (match_long_double_Name) {
     detectedType = tse_long_double_e;
+  } else if (match_int128_Name) {
+    detectedType = tse_int128_e;
+  } else if (match_uint128_Name) {
+    detectedType = tse_uint128_e;
+  } else if (match_float16_Name) {
+    detectedType = tse_float16_e;
+  } else if (match_bfloat16_Name) {
+    detectedType = tse_bfloat16_e;
+  } else if (match_float128_Name) {
+    detectedType = tse_float128_e;
+  } else if (match_fixed_q7_8_Name) {
+    detectedType = tse_fixed_q7_8_e;
+  } else if (match_fixed_q15_16_Name) {
+    detectedType = tse_fixed_q15_16_e;
+  } else if (match_fixed_q31_32_Name) {
+    detectedType = tse_fixed_q31_32_e;
   } else {
     detectedType = tse_unknown_e;
   }
@@ -1687,6 +4046,8 @@ bool fileCreate(char fileName[CHAR_BUFFER_SIZE], char headerString[CHAR_BUFFER_S
   bool isCreated = false;
   FILE *fileContext = fopen(fileName, "w");
   if (NULL != fileContext) {
+    hostProbeWriteMetadata(fileContext);
+    harnessResultFiles.push_back(fileName);
     if (NULL != headerString) {
       fprintf(fileContext, "%s", headerString);
     }
@@ -2064,125 +4425,15 @@ int fileGetDirectory(const char selectPath[CHAR_BUFFER_SIZE],
   return returnStatus;
 }
 
-/* Processor Specific Model Notes:
- $ lscpu | grep MHz
- CPU MHz:                         3200.011
- CPU max MHz:                     3500.0000
- CPU min MHz:                     1200.0000
-
- $ cat /proc/cpuinfo
- processor	: 0
- vendor_id	: GenuineIntel
- cpu family	: 6
- model		: 79
- model name	: Intel(R) Xeon(R) CPU E5-2687W v4 @ 3.00GHz
- stepping	: 1
- microcode	: 0xb00003e
- cpu MHz		: 3200.015
- cache size	: 30720 KB
- physical id	: 0
- siblings	: 12
- core id		: 0
- cpu cores	: 12
- apicid		: 0
- initial apicid	: 0
- fpu		: yes
- fpu_exception	: yes
- cpuid level	: 20
- wp		: yes
- flags		: fpu vme de pse tsc msr pae mce cx8 apic sep mtrr pge mca cmov pat pse36 clflush dts acpi mmx fxsr sse sse2 ss ht tm pbe syscall nx pdpe1gb rdtscp lm constant_tsc arch_perfmon pebs bts rep_good nopl xtopology nonstop_tsc cpuid aperfmperf pni pclmulqdq dtes64 monitor ds_cpl vmx smx est tm2 ssse3 sdbg fma cx16 xtpr pdcm pcid dca sse4_1 sse4_2 x2apic movbe popcnt tsc_deadline_timer aes xsave avx f16c rdrand lahf_lm abm 3dnowprefetch cpuid_fault epb cat_l3 cdp_l3 invpcid_single pti intel_ppin ssbd ibrs ibpb stibp tpr_shadow vnmi flexpriority ept vpid ept_ad fsgsbase tsc_adjust bmi1 hle avx2 smep bmi2 erms invpcid rtm cqm rdt_a rdseed adx smap intel_pt xsaveopt cqm_llc cqm_occup_llc cqm_mbm_total cqm_mbm_local dtherm ida arat pln pts md_clear flush_l1d
- bugs		: cpu_meltdown spectre_v1 spectre_v2 spec_store_bypass l1tf mds swapgs taa itlb_multihit
- bogomips	: 6000.02
- clflush size	: 64
- cache_alignment	: 64
- address sizes	: 46 bits physical, 48 bits virtual
- power management:
-*/
-double getCPUInfoTokenDouble(const char *matchString, uint64_t matchStringSize) {
-  double foundFrequency = 0.0;
-  static char buffer[CHAR_BUFFER_SIZE];
-  static char digits[CHAR_BUFFER_SIZE];
-  int64_t bufferLimit = CHAR_BUFFER_SIZE - 1;
-  int64_t minCompareSize;
-  int64_t characters;
-  uint64_t bufferIndex;
-  uint64_t digitsIndex;
-  uint64_t nextIndex;
-  FILE *cpuInfoFile;
-  int matchCode;
-  int foundFirstDigit, foundDigit;
-
-  // Set buffer ends to NULL char.
-  buffer[bufferLimit] = '\0';
-  digits[bufferLimit] = '\0';
-
-  // Open CPU info file.
-  cpuInfoFile = fopen("/proc/cpuinfo", "rb");
-  if (NULL == cpuInfoFile) {
-    fprintf(stderr, "ERROR! Cannot retrieve CPU Information from /proc/cpuinfo\n.");
-    return foundFrequency;
-  } else {
-    do {
-      characters = (int64_t)(fgets(buffer, bufferLimit, cpuInfoFile));
-      if ((int64_t)matchStringSize <= characters) {
-        minCompareSize = (int64_t)matchStringSize;
-      }
-      else {
-        minCompareSize = characters;
-      }
-      if (minCompareSize <= bufferLimit) {
-        minCompareSize = minCompareSize;
-      }
-      else {
-        minCompareSize = bufferLimit;
-      }
-      matchCode = strncmp(matchString, buffer, matchStringSize);
-      if (0 == matchCode) {
-        digitsIndex = 0;
-        foundFirstDigit = 0;
-        for (bufferIndex = 0; bufferIndex < bufferLimit; bufferIndex++) {
-          foundDigit = isdigit(buffer[bufferIndex]);
-          if ((0 == foundFirstDigit) && (1 == foundDigit)) {
-            foundFirstDigit = 1;
-          }
-
-          if ((1 == foundFirstDigit) && (1 == foundDigit)) {
-              digits[digitsIndex] = buffer[bufferIndex];
-              digitsIndex++;
-          }
-          else if ((1 == foundFirstDigit) && (0 == foundDigit)) {
-            break;
-          }
-        }
-        if (digitsIndex > 0) {
-          nextIndex = digitsIndex + 1;
-          if (nextIndex < bufferLimit) {
-            digits[digitsIndex + 1] = '\0';
-          }
-          foundFrequency = strtod(digits, NULL);
-          break;
-        }
-      }
-    } while ((int64_t) NULL != characters);
-  }
-  return foundFrequency;
-}
-
+/******************************************************************************
+* Processor frequency as /proc/cpuinfo reported it when the host was probed.
+* @return  frequency in KHz, 0 when unknown.
+*****************************************************************************/
 long double getCPUFrequency(void) {
   const double convertMegaToKilo = 1000;
-  char matchString[7];
-  matchString[0] = 'c';
-  matchString[1] = 'p';
-  matchString[2] = 'u';
-  matchString[3] = ' ';
-  matchString[4] = 'M';
-  matchString[5] = 'H';
-  matchString[6] = 'z';
-  int64_t matchStringSize = sizeof(matchString) / sizeof(matchString[0]);
-  double foundFreq = getCPUInfoTokenDouble(matchString, matchStringSize);
-  // Convert MHz to KHz
-  foundFreq = foundFreq * convertMegaToKilo;
-  return foundFreq;
+
+  hostProbeRun(harnessHost);
+  return harnessHost.cpuMegahertz * convertMegaToKilo;
 }
 
 #endif // _CPUBENCHMARKPARALLEL_CPP_
@@ -0,0 +1,560 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKROOFLINE_HPP_
+#define _CPUBENCHMARKROOFLINE_HPP_
+
+#define ROOFLINE_ITERATIONS_DEFAULT (1 << 22) // Rounds of independent multiply-adds per peak measurement
+#define ROOFLINE_ACCUMULATORS 12 // Independent chains, enough to cover multiply-add latency on two ports
+#define ROOFLINE_REPEAT 3 // Best of, for every bandwidth and kernel measurement
+#define ROOFLINE_BYTES_STREAMED (1ULL << 30) // Bytes read per bandwidth measurement
+#define ROOFLINE_DRAM_BYTES_MIN (256ULL << 20) // Smallest working set used for the memory level
+#define ROOFLINE_DRAM_BYTES_MAX (1ULL << 30) // Largest working set used for the memory level
+#define ROOFLINE_INTENSITY_MIN_LOG2 (-4) // Roofline curve samples from 1/16 ...
+#define ROOFLINE_INTENSITY_MAX_LOG2 6 // ... to 64 operations per byte
+
+// Widest vector the build targets, the vector peak is measured with GCC vector extensions of this size.
+#if defined(__AVX512F__)
+#define ROOFLINE_VECTOR_BYTES 64
+#elif defined(__AVX__)
+#define ROOFLINE_VECTOR_BYTES 32
+#else
+#define ROOFLINE_VECTOR_BYTES 16
+#endif
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum rooflineLevel_e {
+  rl_l1_e = 0,
+  rl_l2_e = 1,
+  rl_l3_e = 2,
+  rl_dram_e = 3,
+  rl_count_e = 4
+} rooflineLevel_et;
+
+typedef enum rooflineCompute_e {
+  rc_scalar_e = 0,
+  rc_vector_e = 1,
+  rc_count_e = 2
+} rooflineCompute_et;
+
+// Streaming kernels placed on the roofline, intensity is counted from the loop body.
+typedef enum rooflineKernel_e {
+  rk_sum_e = 0, // s += x[i]
+  rk_dot_e = 1, // s += x[i] * y[i]
+  rk_axpy_e = 2, // y[i] = a * x[i] + y[i]
+  rk_horner_e = 3, // y[i] = p(x[i]), degree TYPELESS_HORNER_DEGREE
+  rk_count_e = 4
+} rooflineKernel_et;
+
+template<class classType>
+struct rooflineVector {
+  typedef classType type __attribute__((vector_size(ROOFLINE_VECTOR_BYTES)));
+};
+
+typedef struct rooflineMemory {
+  size_t workingSet[rl_count_e]; // Bytes streamed per pass, 0 when the level does not exist
+  double bandwidth[rl_count_e]; // Bytes per second
+  frequencySample_t frequency[rl_count_e]; // Monitor values of the bandwidth measurement
+} rooflineMemory_t;
+
+typedef struct rooflinePeak {
+  double operationsPerSecond[rc_count_e]; // 0 when the compute kind does not exist for the type
+  frequencySample_t frequency[rc_count_e]; // Monitor values of the peak measurement
+} rooflinePeak_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *rooflineLevelName(rooflineLevel_et level);
+
+const char *rooflineKernelName(rooflineKernel_et kernel);
+
+template<class classType>
+classType rooflineScalarKernel(size_t iterations, classType multiplier, classType addend);
+
+template<class classType>
+classType rooflineVectorKernel(size_t iterations, classType multiplier, classType addend);
+
+template<class classType>
+void rooflinePeakMeasure(size_t iterations, rooflinePeak_t &peak);
+
+uint64_t rooflineReadKernel(const uint64_t *buffer, size_t bytes);
+
+void rooflineWorkingSetSelect(size_t workingSet[rl_count_e]);
+
+void rooflineMemoryMeasure(rooflineMemory_t &memory);
+
+template<class classType>
+double rooflineStreamKernel(rooflineKernel_et kernel, classType *x, classType *y, size_t length, size_t passes);
+
+template<class classType>
+void rooflineTypeReport(FILE *fileContext, size_t iterations, const rooflineMemory_t &memory, bool isKernelPlaced);
+
+int testharness_Roofline(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the memory level.
+*****************************************************************************/
+const char *rooflineLevelName(rooflineLevel_et level) {
+  const char *levelName;
+  switch (level) {
+    case rl_l1_e:
+      levelName = "L1";
+      break;
+    case rl_l2_e:
+      levelName = "L2";
+      break;
+    case rl_l3_e:
+      levelName = "L3";
+      break;
+    case rl_dram_e:
+      levelName = "DRAM";
+      break;
+    default:
+      levelName = "unknown";
+      break;
+  }
+  return levelName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the streaming kernel.
+*****************************************************************************/
+const char *rooflineKernelName(rooflineKernel_et kernel) {
+  const char *kernelName;
+  switch (kernel) {
+    case rk_sum_e:
+      kernelName = "sum";
+      break;
+    case rk_dot_e:
+      kernelName = "dot_product";
+      break;
+    case rk_axpy_e:
+      kernelName = "axpy";
+      break;
+    case rk_horner_e:
+      kernelName = "horner_polynomial";
+      break;
+    default:
+      kernelName = "unknown";
+      break;
+  }
+  return kernelName;
+}
+
+/******************************************************************************
+* Independent multiply-add chains kept scalar; vectorization is disabled for
+* this function only. Float and double use the fused form.
+* @return  sum of the accumulators to keep the chains alive.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline, optimize("no-tree-vectorize"))) classType rooflineScalarKernel(size_t iterations,
+                                                                                        classType multiplier,
+                                                                                        classType addend) {
+  classType accumulator[ROOFLINE_ACCUMULATORS];
+  classType accumulatorSum = 0;
+
+  for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+    accumulator[chain] = (classType) (chain + 1);
+  }
+  for (size_t index = 0; index < iterations; index++) {
+    // Fully unrolled so every accumulator lives in its own register.
+#pragma GCC unroll 16
+    for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+      if constexpr (std::is_same<classType, float>::value || std::is_same<classType, double>::value) {
+        accumulator[chain] = performTernaryOp<tFusedMultiplyAdd>(accumulator[chain], multiplier, addend);
+      } else {
+        accumulator[chain] = performTernaryOp<tMultiplyAdd>(accumulator[chain], multiplier, addend);
+      }
+    }
+  }
+  for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+    accumulatorSum = accumulatorSum + accumulator[chain];
+  }
+  return accumulatorSum;
+}
+
+/******************************************************************************
+* The same chains on full vector registers; the compiler contracts the
+* floating point multiply-add when the target has FMA.
+* @return  sum of the accumulator lanes to keep the chains alive.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline)) classType rooflineVectorKernel(size_t iterations, classType multiplier, classType addend) {
+  typedef typename rooflineVector<classType>::type vector_t;
+  const size_t lanes = ROOFLINE_VECTOR_BYTES / sizeof(classType);
+  vector_t accumulator[ROOFLINE_ACCUMULATORS];
+  vector_t multiplierVector, addendVector;
+  classType accumulatorSum = 0;
+
+  for (size_t lane = 0; lane < lanes; lane++) {
+    multiplierVector[lane] = multiplier;
+    addendVector[lane] = addend;
+  }
+  for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+    for (size_t lane = 0; lane < lanes; lane++) {
+      accumulator[chain][lane] = (classType) (chain + lane + 1);
+    }
+  }
+  for (size_t index = 0; index < iterations; index++) {
+#pragma GCC unroll 16
+    for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+      accumulator[chain] = accumulator[chain] * multiplierVector + addendVector;
+    }
+  }
+  for (size_t chain = 0; chain < ROOFLINE_ACCUMULATORS; chain++) {
+    for (size_t lane = 0; lane < lanes; lane++) {
+      accumulatorSum = accumulatorSum + accumulator[chain][lane];
+    }
+  }
+  return accumulatorSum;
+}
+
+/******************************************************************************
+* Multiplier one and addend zero come through volatiles, so the values stay
+* finite and the compiler cannot fold the chains away.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void rooflinePeakMeasure(size_t iterations, rooflinePeak_t &peak) {
+  volatile classType multiplierVolatile = 1;
+  volatile classType addendVolatile = 0;
+  volatile classType sink;
+  frequencySnapshot_t frequencyStart;
+  double operations;
+  double timeStart, timeDelta;
+
+  operations = 2.0 * (double) ROOFLINE_ACCUMULATORS * (double) iterations;
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  sink = rooflineScalarKernel<classType>(iterations, multiplierVolatile, addendVolatile);
+  timeDelta = getTime() - timeStart;
+  peak.frequency[rc_scalar_e] = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  peak.operationsPerSecond[rc_scalar_e] = (timeDelta > 0.0) ? (operations / timeDelta) : 0.0;
+
+  peak.operationsPerSecond[rc_vector_e] = 0.0;
+  peak.frequency[rc_vector_e] = frequencyUnknown;
+  if constexpr (!std::is_same<classType, long double>::value) {
+    operations *= (double) (ROOFLINE_VECTOR_BYTES / sizeof(classType));
+    frequencyStart = frequencyMonitorRead(harnessMonitor);
+    timeStart = getTime();
+    sink = rooflineVectorKernel<classType>(iterations, multiplierVolatile, addendVolatile);
+    timeDelta = getTime() - timeStart;
+    peak.frequency[rc_vector_e] = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+    peak.operationsPerSecond[rc_vector_e] = (timeDelta > 0.0) ? (operations / timeDelta) : 0.0;
+  }
+  (void) sink;
+  return;
+}
+
+/******************************************************************************
+* Reads the buffer once with eight independent xor chains on full vectors.
+* @return  folded xor of the buffer.
+*****************************************************************************/
+__attribute__((noinline)) uint64_t rooflineReadKernel(const uint64_t *buffer, size_t bytes) {
+  typedef rooflineVector<uint64_t>::type vector_t;
+  const vector_t *vectorBuffer = (const vector_t *) buffer;
+  size_t vectorCount = bytes / sizeof(vector_t);
+  vector_t accumulator0 = {}, accumulator1 = {}, accumulator2 = {}, accumulator3 = {};
+  vector_t accumulator4 = {}, accumulator5 = {}, accumulator6 = {}, accumulator7 = {};
+  uint64_t accumulatorFold = 0;
+
+  for (size_t index = 0; (index + 8) <= vectorCount; index += 8) {
+    accumulator0 ^= vectorBuffer[index];
+    accumulator1 ^= vectorBuffer[index + 1];
+    accumulator2 ^= vectorBuffer[index + 2];
+    accumulator3 ^= vectorBuffer[index + 3];
+    accumulator4 ^= vectorBuffer[index + 4];
+    accumulator5 ^= vectorBuffer[index + 5];
+    accumulator6 ^= vectorBuffer[index + 6];
+    accumulator7 ^= vectorBuffer[index + 7];
+  }
+  accumulator0 ^= accumulator1 ^ accumulator2 ^ accumulator3 ^ accumulator4 ^ accumulator5 ^ accumulator6 ^ accumulator7;
+  for (size_t lane = 0; lane < (ROOFLINE_VECTOR_BYTES / sizeof(uint64_t)); lane++) {
+    accumulatorFold ^= accumulator0[lane];
+  }
+  return accumulatorFold;
+}
+
+/******************************************************************************
+* Working sets are half of each cache level, and at least twice the level
+* below, so each level is measured with the level below it overflowed.
+* @return  None, bytes per level are returned in workingSet, 0 when the
+*          level does not exist.
+*****************************************************************************/
+void rooflineWorkingSetSelect(size_t workingSet[rl_count_e]) {
+  size_t cacheSize[rl_dram_e] = {getCacheSize(1), getCacheSize(2), getCacheSize(3)};
+  size_t workingSetBelow = 0;
+
+  for (size_t level = 0; level < rl_dram_e; level++) {
+    workingSet[level] = 0;
+    if (cacheSize[level] > 0) {
+      workingSet[level] = std::max(cacheSize[level] / 2, 2 * workingSetBelow);
+      workingSetBelow = workingSet[level];
+    }
+  }
+  workingSet[rl_dram_e] = std::min(std::max((size_t) ROOFLINE_DRAM_BYTES_MIN, 4 * cacheSize[rl_l3_e]),
+                                   (size_t) ROOFLINE_DRAM_BYTES_MAX);
+  for (size_t level = 0; level < rl_count_e; level++) {
+    // Whole vectors of eight accumulators.
+    workingSet[level] -= workingSet[level] % (8 * ROOFLINE_VECTOR_BYTES);
+  }
+  return;
+}
+
+/******************************************************************************
+* Streams the working set of each level, see rooflineWorkingSetSelect.
+* @return  None
+*****************************************************************************/
+void rooflineMemoryMeasure(rooflineMemory_t &memory) {
+  size_t workingSetMax = 0;
+  size_t passes;
+  uint64_t *buffer;
+  volatile uint64_t sink;
+  frequencySnapshot_t frequencyStart;
+  double timeStart, timeDelta, timeBest;
+
+  rooflineWorkingSetSelect(memory.workingSet);
+  for (size_t level = 0; level < rl_count_e; level++) {
+    workingSetMax = std::max(workingSetMax, memory.workingSet[level]);
+    memory.bandwidth[level] = 0.0;
+    memory.frequency[level] = frequencyUnknown;
+  }
+
+  buffer = (uint64_t *) aligned_alloc(ROOFLINE_VECTOR_BYTES, workingSetMax);
+  if (NULL == buffer) {
+    fprintf(stderr, "Error on line %d : %s.\n", __LINE__, strerror(errno));
+    return;
+  }
+  for (size_t index = 0; index < (workingSetMax / sizeof(uint64_t)); index++) {
+    buffer[index] = index;
+  }
+  for (size_t level = 0; level < rl_count_e; level++) {
+    if (0 == memory.workingSet[level]) {
+      continue;
+    }
+    passes = std::max((size_t) 1, (size_t) (ROOFLINE_BYTES_STREAMED / memory.workingSet[level]));
+    timeBest = 0.0;
+    frequencyStart = frequencyMonitorRead(harnessMonitor);
+    for (size_t repeat = 0; repeat < ROOFLINE_REPEAT; repeat++) {
+      timeStart = getTime();
+      for (size_t pass = 0; pass < passes; pass++) {
+        sink = rooflineReadKernel(buffer, memory.workingSet[level]);
+      }
+      timeDelta = getTime() - timeStart;
+      timeBest = ((0 == repeat) || (timeDelta < timeBest)) ? timeDelta : timeBest;
+    }
+    memory.frequency[level] = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+    memory.bandwidth[level] = (timeBest > 0.0) ?
+                              ((double) memory.workingSet[level] * (double) passes) / timeBest : 0.0;
+  }
+  (void) sink;
+  free(buffer);
+  return;
+}
+
+/******************************************************************************
+* Runs a streaming kernel over arrays of length elements, compiled like any
+* other loop of the harness.
+* @return  best time per pass in seconds.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline)) double rooflineStreamKernel(rooflineKernel_et kernel, classType *x, classType *y,
+                                                      size_t length, size_t passes) {
+  volatile classType scaleVolatile = (classType) 0.5;
+  volatile classType sink;
+  classType scale = scaleVolatile;
+  classType accumulator = 0;
+  classType value;
+  double timeStart, timeDelta, timeBest = 0.0;
+
+  for (size_t repeat = 0; repeat < ROOFLINE_REPEAT; repeat++) {
+    timeStart = getTime();
+    for (size_t pass = 0; pass < passes; pass++) {
+      switch (kernel) {
+        case rk_sum_e:
+          for (size_t index = 0; index < length; index++) {
+            accumulator = accumulator + x[index];
+          }
+          break;
+        case rk_dot_e:
+          for (size_t index = 0; index < length; index++) {
+            accumulator = accumulator + x[index] * y[index];
+          }
+          break;
+        case rk_axpy_e:
+          // Alternating sign keeps y bounded over many passes.
+          scale = -scale;
+          for (size_t index = 0; index < length; index++) {
+            y[index] = scale * x[index] + y[index];
+          }
+          break;
+        case rk_horner_e:
+          for (size_t index = 0; index < length; index++) {
+            value = scale;
+            for (size_t degree = 0; degree < TYPELESS_HORNER_DEGREE; degree++) {
+              value = value * x[index] + scale;
+            }
+            y[index] = value;
+          }
+          break;
+        default:
+          asserterror();
+          break;
+      }
+    }
+    timeDelta = (getTime() - timeStart) / (double) passes;
+    timeBest = ((0 == repeat) || (timeDelta < timeBest)) ? timeDelta : timeBest;
+  }
+  sink = accumulator;
+  (void) sink;
+  return timeBest;
+}
+
+/******************************************************************************
+* Emits peak, ridge point and roofline curve rows for one type, then places
+* the streaming kernels of float and double on the roofline.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void rooflineTypeReport(FILE *fileContext, size_t iterations, const rooflineMemory_t &memory, bool isKernelPlaced) {
+  const char *computeNames[rc_count_e] = {"scalar", "vector"};
+  // Operations and bytes moved per element of each streaming kernel.
+  const double kernelOperations[rk_count_e] = {1.0, 2.0, 2.0, 2.0 * TYPELESS_HORNER_DEGREE};
+  const double kernelElementsMoved[rk_count_e] = {1.0, 2.0, 3.0, 2.0};
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  rooflinePeak_t peak;
+  std::vector<classType> x, y;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+  double peakBest, ridge, intensity, attainable, achieved, timePass;
+  size_t length, passes;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  rooflinePeakMeasure<classType>(iterations, peak);
+  for (size_t compute = 0; compute < rc_count_e; compute++) {
+    if (peak.operationsPerSecond[compute] <= 0.0) {
+      continue;
+    }
+    resultPrintRow(fileContext, true, &peak.frequency[compute], "peak, %s, %s, , , , %f, , , , ",
+                   typeNameBuffer, computeNames[compute], peak.operationsPerSecond[compute]);
+    for (size_t level = 0; level < rl_count_e; level++) {
+      if (memory.bandwidth[level] <= 0.0) {
+        continue;
+      }
+      ridge = peak.operationsPerSecond[compute] / memory.bandwidth[level];
+      resultPrintRow(fileContext, true, &frequencyUnknown, "ridge, %s, %s, %s, %zu, %f, %f, %f, %f, 1.000000, ",
+                     typeNameBuffer, computeNames[compute], rooflineLevelName((rooflineLevel_et) level),
+                     memory.workingSet[level], ridge, peak.operationsPerSecond[compute], memory.bandwidth[level],
+                     peak.operationsPerSecond[compute]);
+      for (int exponent = ROOFLINE_INTENSITY_MIN_LOG2; exponent <= ROOFLINE_INTENSITY_MAX_LOG2; exponent++) {
+        intensity = std::ldexp(1.0, exponent);
+        attainable = std::min(peak.operationsPerSecond[compute], intensity * memory.bandwidth[level]);
+        resultPrintRow(fileContext, false, &frequencyUnknown, "curve, %s, %s, %s, %zu, %f, , %f, %f, , %s",
+                       typeNameBuffer, computeNames[compute], rooflineLevelName((rooflineLevel_et) level),
+                       memory.workingSet[level], intensity, memory.bandwidth[level], attainable,
+                       (intensity < ridge) ? "memory" : "compute");
+      }
+    }
+  }
+
+  if (!isKernelPlaced) {
+    return;
+  }
+  peakBest = std::max(peak.operationsPerSecond[rc_scalar_e], peak.operationsPerSecond[rc_vector_e]);
+  for (size_t level = 0; level < rl_count_e; level++) {
+    if ((memory.bandwidth[level] <= 0.0) || (peakBest <= 0.0)) {
+      continue;
+    }
+    // Two arrays share the working set of the level.
+    length = memory.workingSet[level] / (2 * sizeof(classType));
+    passes = std::max((size_t) 1, (size_t) (ROOFLINE_BYTES_STREAMED / memory.workingSet[level]) / 4);
+    x.assign(length, (classType) 0.25);
+    y.assign(length, (classType) 0.5);
+    for (size_t kernel = 0; kernel < rk_count_e; kernel++) {
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timePass = rooflineStreamKernel<classType>((rooflineKernel_et) kernel, x.data(), y.data(), length, passes);
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      intensity = kernelOperations[kernel] / (kernelElementsMoved[kernel] * (double) sizeof(classType));
+      attainable = std::min(peakBest, intensity * memory.bandwidth[level]);
+      achieved = (timePass > 0.0) ? (kernelOperations[kernel] * (double) length) / timePass : 0.0;
+      resultPrintRow(fileContext, true, &frequency, "kernel_%s, %s, measured, %s, %zu, %f, %f, %f, %f, %f, %s",
+                     rooflineKernelName((rooflineKernel_et) kernel), typeNameBuffer,
+                     rooflineLevelName((rooflineLevel_et) level), memory.workingSet[level], intensity, achieved,
+                     memory.bandwidth[level], attainable, (attainable > 0.0) ? (achieved / attainable) : 0.0,
+                     (intensity < (peakBest / memory.bandwidth[level])) ? "memory" : "compute");
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures peak scalar and vector operations per second for every type of
+* the type system and read bandwidth per memory level, then writes the
+* roofline: peaks, ridge points, sampled roofline curves and the placement of
+* the streaming kernels.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Roofline(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Record, Type System, Compute, Memory Level, Working Set Bytes, "
+                            "Arithmetic Intensity Operations per Byte, Operations per Second, Bytes per Second, "
+                            "Attainable Operations per Second, Fraction of Roofline, Bound";
+  size_t iterations = (options.iterations > 0) ? options.iterations : ROOFLINE_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  rooflineMemory_t memory;
+  FILE *fileContext;
+
+#if !defined(__OPTIMIZE__)
+  printf("Built without optimization, the roofline describes unoptimized code.\n");
+#endif // !defined(__OPTIMIZE__)
+  printf("Vector peaks use %d byte vectors. Integer types count a multiply and an add as two operations.\n",
+         ROOFLINE_VECTOR_BYTES);
+  fileContext = resultFileOpen("Roofline", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  rooflineMemoryMeasure(memory);
+  for (size_t level = 0; level < rl_count_e; level++) {
+    if (memory.bandwidth[level] > 0.0) {
+      resultPrintRow(fileContext, true, &memory.frequency[level], "bandwidth, , , %s, %zu, , , %f, , , ",
+                     rooflineLevelName((rooflineLevel_et) level), memory.workingSet[level], memory.bandwidth[level]);
+    }
+  }
+  rooflineTypeReport<int8_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<uint8_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<int16_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<uint16_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<int32_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<uint32_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<int64_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<uint64_t>(fileContext, iterations, memory, false);
+  rooflineTypeReport<float>(fileContext, iterations, memory, true);
+  rooflineTypeReport<double>(fileContext, iterations, memory, true);
+  rooflineTypeReport<long double>(fileContext, iterations, memory, false);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKROOFLINE_HPP_
@@ -0,0 +1,236 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the sort family for keys.
+
+#ifndef _CPUBENCHMARKSEARCH_HPP_
+#define _CPUBENCHMARKSEARCH_HPP_
+
+#define SEARCH_ELEMENTS_MIN (1 << 10) // Default sweep of the searched array, grows by SEARCH_ELEMENTS_STEP ...
+#define SEARCH_ELEMENTS_MAX (1 << 26) // ... up to this many, -n selects a single count
+#define SEARCH_ELEMENTS_STEP 4
+#define SEARCH_QUERIES (1 << 20) // Lookups per measurement, half are keys of the array
+#define SEARCH_PREFETCH_LEVELS 4 // Eytzinger prefetch distance in tree levels, 16 nodes share a line at 4 bytes
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum searchAlgorithm_e {
+  sa_binary_e = 0, // std::lower_bound, a branch per level
+  sa_branchless_e = 1, // Halving base pointer with a conditional move per level
+  sa_eytzinger_e = 2, // Breadth first layout, branch free descent with prefetch of the great grandchildren
+  sa_count_e = 3
+} searchAlgorithm_et;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *searchAlgorithmName(searchAlgorithm_et algorithm);
+
+template<class classType>
+size_t searchEytzingerBuild(const classType *sorted, classType *tree, size_t sortedIndex, size_t treeIndex,
+                            size_t length);
+
+template<class classType>
+uint64_t searchMeasure(searchAlgorithm_et algorithm, const std::vector<classType> &sorted,
+                       const std::vector<classType> &tree, const std::vector<classType> &queries);
+
+template<class classType>
+void searchMeasureType(FILE *fileContext, size_t elementsOption);
+
+int testharness_Search(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the search.
+*****************************************************************************/
+const char *searchAlgorithmName(searchAlgorithm_et algorithm) {
+  const char *algorithmName;
+  switch (algorithm) {
+    case sa_binary_e:
+      algorithmName = "binary";
+      break;
+    case sa_branchless_e:
+      algorithmName = "branchless";
+      break;
+    case sa_eytzinger_e:
+      algorithmName = "eytzinger";
+      break;
+    default:
+      algorithmName = "unknown";
+      break;
+  }
+  return algorithmName;
+}
+
+/******************************************************************************
+* In order walk of the implicit tree rooted at treeIndex (1 based), filling
+* it from the sorted array.
+* @return  next index of the sorted array.
+*****************************************************************************/
+template<class classType>
+size_t searchEytzingerBuild(const classType *sorted, classType *tree, size_t sortedIndex, size_t treeIndex,
+                            size_t length) {
+  if (treeIndex <= length) {
+    sortedIndex = searchEytzingerBuild<classType>(sorted, tree, sortedIndex, 2 * treeIndex, length);
+    tree[treeIndex] = sorted[sortedIndex++];
+    sortedIndex = searchEytzingerBuild<classType>(sorted, tree, sortedIndex, 2 * treeIndex + 1, length);
+  }
+  return sortedIndex;
+}
+
+/******************************************************************************
+* Runs every query; the result of a query is the first element not less than
+* it, or the largest value of the type past the end.
+* @return  sum of the results, equal across algorithms.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+uint64_t searchMeasure(searchAlgorithm_et algorithm, const std::vector<classType> &sorted,
+                       const std::vector<classType> &tree, const std::vector<classType> &queries) {
+  const classType notFound = std::numeric_limits<classType>::max();
+  const size_t length = sorted.size();
+  const classType *base;
+  const classType *treeData = tree.data();
+  uint64_t checksum = 0, bits;
+  classType result;
+  size_t remaining, half, node;
+
+  for (size_t query = 0; query < queries.size(); query++) {
+    const classType key = queries[query];
+    switch (algorithm) {
+      case sa_branchless_e:
+        base = sorted.data();
+        remaining = length;
+        while (remaining > 1) {
+          half = remaining / 2;
+          base = (base[half] < key) ? (base + half) : base;
+          remaining -= half;
+        }
+        base += (*base < key) ? 1 : 0;
+        result = (base < (sorted.data() + length)) ? *base : notFound;
+        break;
+      case sa_eytzinger_e:
+        node = 1;
+        while (node <= length) {
+          __builtin_prefetch(treeData + (node << SEARCH_PREFETCH_LEVELS));
+          node = 2 * node + ((treeData[node] < key) ? 1 : 0);
+        }
+        // Drop the trailing right turns and the last left turn, what is left is the answer.
+        node >>= __builtin_ffsll((long long) ~node);
+        result = (0 != node) ? treeData[node] : notFound;
+        break;
+      case sa_binary_e:
+      default:
+        base = std::lower_bound(sorted.data(), sorted.data() + length, key);
+        result = (base < (sorted.data() + length)) ? *base : notFound;
+        break;
+    }
+    bits = 0;
+    memcpy(&bits, &result, std::min(sizeof(bits), sizeof(result)));
+    checksum += bits;
+  }
+  return checksum;
+}
+
+/******************************************************************************
+* Every search of one type over the array lengths.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void searchMeasureType(FILE *fileContext, size_t elementsOption) {
+  size_t elementsFirst = (elementsOption > 0) ? elementsOption : SEARCH_ELEMENTS_MIN;
+  size_t elementsLast = (elementsOption > 0) ? elementsOption : SEARCH_ELEMENTS_MAX;
+  std::vector<classType> sorted, tree, queries(SEARCH_QUERIES);
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  uint64_t checksum, checksumReference = 0, cycleStart, cycleDelta;
+  double timeStart, timeDelta;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  for (size_t elements = elementsFirst; elements <= elementsLast; elements *= SEARCH_ELEMENTS_STEP) {
+    sorted.resize(elements);
+    sortKeyFill<classType>(sorted);
+    std::sort(sorted.begin(), sorted.end());
+    tree.resize(elements + 1);
+    tree[0] = sorted[0];
+    searchEytzingerBuild<classType>(sorted.data(), tree.data(), 0, 1, elements);
+    sortKeyFill<classType>(queries);
+    for (size_t query = 0; query < SEARCH_QUERIES; query += 2) {
+      queries[query] = sorted[(size_t) (gauss_rand<double>(1) * (double) (elements - 1))];
+    }
+    for (size_t algorithm = 0; algorithm < sa_count_e; algorithm++) {
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      timeStart = getTime();
+      cycleStart = getCycleCount();
+      checksum = searchMeasure<classType>((searchAlgorithm_et) algorithm, sorted, tree, queries);
+      cycleDelta = getCycleCount() - cycleStart;
+      timeDelta = getTime() - timeStart;
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      if (sa_binary_e == algorithm) {
+        checksumReference = checksum;
+      }
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %d, %f, %f, %f, %f, %d",
+                     searchAlgorithmName((searchAlgorithm_et) algorithm), typeNameBuffer, elements,
+                     elements * sizeof(classType), SEARCH_QUERIES, timeDelta,
+                     (timeDelta * 1e9) / (double) SEARCH_QUERIES, (double) cycleDelta / (double) SEARCH_QUERIES,
+                     (timeDelta > 0.0) ? ((double) SEARCH_QUERIES / timeDelta / 1e6) : 0.0,
+                     (checksum == checksumReference) ? 1 : 0);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Looks up random keys, half present, in sorted arrays of every integer
+* width and both floating types with std::lower_bound, a branchless binary
+* search and an Eytzinger layout.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Search(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Algorithm, Type System, Elements, Array Bytes, Queries, Time for Operations, "
+                            "Nanoseconds per Query, Cycles per Query, Million Queries per Second, Matches Binary";
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("Search", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  searchMeasureType<int8_t>(fileContext, options.iterations);
+  searchMeasureType<uint8_t>(fileContext, options.iterations);
+  searchMeasureType<int16_t>(fileContext, options.iterations);
+  searchMeasureType<uint16_t>(fileContext, options.iterations);
+  searchMeasureType<int32_t>(fileContext, options.iterations);
+  searchMeasureType<uint32_t>(fileContext, options.iterations);
+  searchMeasureType<int64_t>(fileContext, options.iterations);
+  searchMeasureType<uint64_t>(fileContext, options.iterations);
+#if TYPELESS_INT128_ENABLE
+  searchMeasureType<typelessInt128_t>(fileContext, options.iterations);
+  searchMeasureType<typelessUInt128_t>(fileContext, options.iterations);
+#endif // TYPELESS_INT128_ENABLE
+  searchMeasureType<float>(fileContext, options.iterations);
+  searchMeasureType<double>(fileContext, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSEARCH_HPP_
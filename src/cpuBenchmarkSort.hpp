@@ -0,0 +1,368 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKSORT_HPP_
+#define _CPUBENCHMARKSORT_HPP_
+
+#include <algorithm>
+
+#define SORT_ELEMENTS_MIN (1 << 10) // Default sweep, elements grow by SORT_ELEMENTS_STEP ...
+#define SORT_ELEMENTS_MAX (1 << 24) // ... up to this many, -n selects a single count
+#define SORT_ELEMENTS_STEP 4
+#define SORT_ELEMENTS_PER_MEASUREMENT (1 << 24) // Sorts are repeated up to this many elements
+#define SORT_RADIX_BITS 8 // Digit of the least significant digit radix sort
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum sortAlgorithm_e {
+  so_stdSort_e = 0, // std::sort, introsort
+  so_radix_e = 1, // Least significant digit radix sort on order preserving unsigned keys
+  so_parallelMerge_e = 2, // std::sort of one chunk per thread, then parallel pairwise std::merge rounds
+  so_count_e = 3
+} sortAlgorithm_et;
+
+// Thread arguments are written by the owning thread, so they are padded.
+typedef struct alignas(CACHE_LINE_SIZE) sortThread {
+  void *source; // Chunk to sort, or first run to merge
+  void *destination; // Merge output, NULL sorts the chunk in place
+  size_t length; // Elements of the chunk, or of the first run
+  size_t lengthSecond; // Elements of the second run, may be 0 for a lone run
+} sortThread_t;
+
+// Unsigned integer of the key width, the radix sort digit source.
+template<class classType>
+struct sortRadixUnsigned {
+  typedef typename std::make_unsigned<classType>::type type;
+};
+
+template<>
+struct sortRadixUnsigned<float> {
+  typedef uint32_t type;
+};
+
+template<>
+struct sortRadixUnsigned<double> {
+  typedef uint64_t type;
+};
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *sortAlgorithmName(sortAlgorithm_et algorithm);
+
+template<class classType>
+void sortKeyFill(std::vector<classType> &keys);
+
+template<class classType>
+typename sortRadixUnsigned<classType>::type sortRadixKey(classType key);
+
+template<class classType>
+void sortRadix(classType *keys, classType *buffer, size_t length);
+
+template<class classType>
+void *sort_Pthread(void *inArgs);
+
+template<class classType>
+bool sortParallelMerge(classType *keys, classType *buffer, size_t length, size_t threadCount);
+
+template<class classType>
+void sortMeasureType(FILE *fileContext, size_t threadCount, size_t elementsOption);
+
+int testharness_Sort(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the sort.
+*****************************************************************************/
+const char *sortAlgorithmName(sortAlgorithm_et algorithm) {
+  const char *algorithmName;
+  switch (algorithm) {
+    case so_stdSort_e:
+      algorithmName = "std_sort";
+      break;
+    case so_radix_e:
+      algorithmName = "radix";
+      break;
+    case so_parallelMerge_e:
+      algorithmName = "parallel_merge";
+      break;
+    default:
+      algorithmName = "unknown";
+      break;
+  }
+  return algorithmName;
+}
+
+/******************************************************************************
+* Keys from the harness random number generator: integers take uniform bits
+* over their full width, 128 bit keys from two 64 bit draws, floats are
+* standard normal values scaled by 1000.
+* Also used by the search and hash families.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void sortKeyFill(std::vector<classType> &keys) {
+  uint64_t bits;
+
+  for (size_t index = 0; index < keys.size(); index++) {
+    if constexpr (std::is_floating_point<classType>::value) {
+      keys[index] = (classType) (1000.0 * gauss_rand<double>(3));
+    } else {
+      keys[index] = 0;
+      for (size_t word = 0; word < sizeof(classType); word += sizeof(uint64_t)) {
+        // Three draws of 24 bits cover 64 bit keys.
+        bits = (uint64_t) (gauss_rand<double>(1) * (double) (1 << 24));
+        bits = (bits << 24) ^ (uint64_t) (gauss_rand<double>(1) * (double) (1 << 24));
+        bits = (bits << 24) ^ (uint64_t) (gauss_rand<double>(1) * (double) (1 << 24));
+        keys[index] |= (classType) bits << (8 * word);
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Maps the key to an unsigned integer of the same width with the same order:
+* the sign bit of integers is flipped, negative floats are inverted.
+* @return  order preserving unsigned key.
+*****************************************************************************/
+template<class classType>
+typename sortRadixUnsigned<classType>::type sortRadixKey(classType key) {
+  typedef typename sortRadixUnsigned<classType>::type unsignedType;
+  const unsignedType signBit = (unsignedType) 1 << (8 * sizeof(unsignedType) - 1);
+  unsignedType bits;
+
+  memcpy(&bits, &key, sizeof(bits));
+  if constexpr (std::is_floating_point<classType>::value) {
+    bits = (0 != (bits & signBit)) ? (unsignedType) ~bits : (unsignedType) (bits | signBit);
+  } else if constexpr (std::is_signed<classType>::value) {
+    bits ^= signBit;
+  }
+  return bits;
+}
+
+/******************************************************************************
+* One counting pass per SORT_RADIX_BITS digit, ping-ponging between keys and
+* buffer; the sorted keys end in keys.
+* @return  None
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+void sortRadix(classType *keys, classType *buffer, size_t length) {
+  const size_t digits = (8 * sizeof(classType)) / SORT_RADIX_BITS;
+  const size_t buckets = (size_t) 1 << SORT_RADIX_BITS;
+  size_t count[(size_t) 1 << SORT_RADIX_BITS];
+  classType *source = keys, *destination = buffer;
+  size_t offset, total, digitValue;
+
+  for (size_t digit = 0; digit < digits; digit++) {
+    memset(count, 0, sizeof(count));
+    for (size_t index = 0; index < length; index++) {
+      count[(sortRadixKey<classType>(source[index]) >> (digit * SORT_RADIX_BITS)) & (buckets - 1)]++;
+    }
+    total = 0;
+    for (size_t bucket = 0; bucket < buckets; bucket++) {
+      offset = count[bucket];
+      count[bucket] = total;
+      total += offset;
+    }
+    for (size_t index = 0; index < length; index++) {
+      digitValue = (sortRadixKey<classType>(source[index]) >> (digit * SORT_RADIX_BITS)) & (buckets - 1);
+      destination[count[digitValue]++] = source[index];
+    }
+    std::swap(source, destination);
+  }
+  if (source != keys) {
+    memcpy(keys, source, length * sizeof(classType));
+  }
+  return;
+}
+
+/******************************************************************************
+* Sorts one chunk, or merges two adjacent runs into the destination.
+* @return  the thread arguments.
+*****************************************************************************/
+template<class classType>
+void *sort_Pthread(void *inArgs) {
+  sortThread_t *threadInfo = (sortThread_t *) inArgs;
+  classType *source = (classType *) threadInfo->source;
+
+  if (NULL == threadInfo->destination) {
+    std::sort(source, source + threadInfo->length);
+  } else {
+    std::merge(source, source + threadInfo->length, source + threadInfo->length,
+               source + threadInfo->length + threadInfo->lengthSecond, (classType *) threadInfo->destination);
+  }
+  return inArgs;
+}
+
+/******************************************************************************
+* Each round halves the runs, one thread per pair; a lone run merges with
+* an empty one, which copies it through.
+* @return  true when every thread team ran; the sorted keys end in keys.
+*****************************************************************************/
+template<class classType>
+bool sortParallelMerge(classType *keys, classType *buffer, size_t length, size_t threadCount) {
+  size_t runLength = (length + threadCount - 1) / threadCount;
+  size_t runs = (length + runLength - 1) / runLength;
+  classType *source = keys, *destination = buffer;
+  std::vector<sortThread_t> threadInfo(runs);
+  std::vector<void *> threadArgs(runs);
+  size_t start, first, second;
+  bool isValid;
+
+  for (size_t run = 0; run < runs; run++) {
+    start = run * runLength;
+    threadInfo[run].source = keys + start;
+    threadInfo[run].destination = NULL;
+    threadInfo[run].length = std::min(runLength, length - start);
+    threadInfo[run].lengthSecond = 0;
+    threadArgs[run] = &threadInfo[run];
+  }
+  isValid = threadTeamRun(sort_Pthread<classType>, threadArgs, true);
+
+  for (; isValid && (runLength < length); runLength *= 2) {
+    runs = (length + 2 * runLength - 1) / (2 * runLength);
+    threadArgs.resize(runs);
+    for (size_t pair = 0; pair < runs; pair++) {
+      start = pair * 2 * runLength;
+      first = std::min(runLength, length - start);
+      second = std::min(runLength, length - start - first);
+      threadInfo[pair].source = source + start;
+      threadInfo[pair].destination = destination + start;
+      threadInfo[pair].length = first;
+      threadInfo[pair].lengthSecond = second;
+      threadArgs[pair] = &threadInfo[pair];
+    }
+    isValid = threadTeamRun(sort_Pthread<classType>, threadArgs, true);
+    std::swap(source, destination);
+  }
+  if (isValid && (source != keys)) {
+    memcpy(keys, source, length * sizeof(classType));
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* Every sort of one type over the element counts; each result is checked
+* against std::sort.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void sortMeasureType(FILE *fileContext, size_t threadCount, size_t elementsOption) {
+  size_t elementsFirst = (elementsOption > 0) ? elementsOption : SORT_ELEMENTS_MIN;
+  size_t elementsLast = (elementsOption > 0) ? elementsOption : SORT_ELEMENTS_MAX;
+  std::vector<classType> input, keys, buffer, reference;
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  size_t passes, threads;
+  double timeStart, timeDelta, elementsSorted;
+  uint64_t cycleStart, cycleDelta;
+  bool isValid, isSorted;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  for (size_t elements = elementsFirst; elements <= elementsLast; elements *= SORT_ELEMENTS_STEP) {
+    input.resize(elements);
+    sortKeyFill<classType>(input);
+    reference = input;
+    std::sort(reference.begin(), reference.end());
+    buffer.resize(elements);
+    passes = std::max((size_t) 1, (size_t) SORT_ELEMENTS_PER_MEASUREMENT / elements);
+    for (size_t algorithm = 0; algorithm < so_count_e; algorithm++) {
+      threads = (so_parallelMerge_e == algorithm) ? threadCount : 1;
+      isValid = true;
+      timeDelta = 0.0;
+      cycleDelta = 0;
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      // Every pass sorts a fresh copy, the copy is outside of the timed region.
+      for (size_t pass = 0; (pass < passes) && isValid; pass++) {
+        keys = input;
+        timeStart = getTime();
+        cycleStart = getCycleCount();
+        switch (algorithm) {
+          case so_radix_e:
+            sortRadix<classType>(keys.data(), buffer.data(), elements);
+            break;
+          case so_parallelMerge_e:
+            isValid = sortParallelMerge<classType>(keys.data(), buffer.data(), elements, threads);
+            break;
+          case so_stdSort_e:
+          default:
+            std::sort(keys.begin(), keys.end());
+            break;
+        }
+        cycleDelta += getCycleCount() - cycleStart;
+        timeDelta += getTime() - timeStart;
+      }
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      // Compared by bits; equal floats of either zero sign may legally swap, so those fall back to an order check.
+      isSorted = isValid && (0 == memcmp(keys.data(), reference.data(), elements * sizeof(classType)));
+      if (!isSorted && std::is_floating_point<classType>::value && isValid) {
+        isSorted = std::is_sorted(keys.begin(), keys.end());
+      }
+      elementsSorted = (double) elements * (double) passes;
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %zu, %f, %f, %f, %f, %d",
+                     sortAlgorithmName((sortAlgorithm_et) algorithm), typeNameBuffer, elements, threads, passes,
+                     timeDelta, (timeDelta * 1e9) / elementsSorted, (double) cycleDelta / elementsSorted,
+                     (timeDelta > 0.0) ? (elementsSorted / timeDelta / 1e6) : 0.0, isSorted ? 1 : 0);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Sorts random keys of every integer width and both floating types with
+* std::sort, an LSD radix sort and a parallel merge sort.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Sort(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Algorithm, Type System, Elements, Threads, Passes, Time for Operations, "
+                            "Nanoseconds per Element, Cycles per Element, Million Elements per Second, Sorted";
+  size_t threadCount = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("Sort", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  sortMeasureType<int8_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<uint8_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<int16_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<uint16_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<int32_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<uint32_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<int64_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<uint64_t>(fileContext, threadCount, options.iterations);
+#if TYPELESS_INT128_ENABLE
+  sortMeasureType<typelessInt128_t>(fileContext, threadCount, options.iterations);
+  sortMeasureType<typelessUInt128_t>(fileContext, threadCount, options.iterations);
+#endif // TYPELESS_INT128_ENABLE
+  sortMeasureType<float>(fileContext, threadCount, options.iterations);
+  sortMeasureType<double>(fileContext, threadCount, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSORT_HPP_
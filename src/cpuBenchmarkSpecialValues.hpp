@@ -0,0 +1,439 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKSPECIALVALUES_HPP_
+#define _CPUBENCHMARKSPECIALVALUES_HPP_
+
+#include <limits>
+#include <utility>
+
+// Flush-to-zero and denormals-are-zero live in MXCSR, which only controls SSE/AVX arithmetic.
+#if defined(__x86_64__) | defined(__i386__)
+#define SPECIALVALUES_MXCSR_ENABLE 1
+#define SPECIALVALUES_MXCSR_FTZ 0x8000 // Bit 15, subnormal results are flushed to zero
+#define SPECIALVALUES_MXCSR_DAZ 0x0040 // Bit 6, subnormal operands are read as zero
+#else
+#define SPECIALVALUES_MXCSR_ENABLE 0
+#endif
+
+#define SPECIALVALUES_ITERATIONS_DEFAULT (1 << 20)
+#define SPECIALVALUES_ARRAY_SIZE (1 << 12) // Power of two, the index wraps with a mask.
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum specialValuesOp_e {
+  sv_addition_e = 0, // a + b, both operands from the class
+  sv_multiplication_e = 1, // a * b, b normal in [0.5, 2) so products stay in the class
+  sv_division_e = 2, // a / b, b normal in [0.5, 2)
+  sv_fma_e = 3, // a * b + a
+  sv_sqrt_e = 4, // sqrt(|a|)
+  sv_count_e = 5
+} specialValuesOp_et;
+
+typedef enum specialValuesClass_e {
+  sc_normal_e = 0, // Reference class of the slowdown factor
+  sc_subnormal_e = 1,
+  sc_zero_e = 2,
+  sc_infinity_e = 3,
+  sc_nan_e = 4,
+  sc_mixed1_e = 5, // 1% subnormal, the rest normal
+  sc_mixed10_e = 6, // 10% subnormal
+  sc_mixed50_e = 7, // 50% subnormal
+  sc_count_e = 8
+} specialValuesClass_et;
+
+typedef enum specialValuesMode_e {
+  sm_ieee_e = 0, // Gradual underflow
+  sm_ftz_e = 1,
+  sm_daz_e = 2,
+  sm_ftzDaz_e = 3,
+  sm_count_e = 4
+} specialValuesMode_et;
+
+typedef struct specialValuesTiming {
+  double timeDelta; // Seconds for the loop
+  uint64_t cycleDelta; // Time stamp counter cycles for the loop
+} specialValuesTiming_t;
+
+template<class classType>
+using specialValuesMeasure_ft = specialValuesTiming_t (*)(const classType *a, const classType *b, classType *out,
+                                                         size_t iterations);
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *specialValuesOpName(specialValuesOp_et op);
+
+const char *specialValuesClassName(specialValuesClass_et operandClass);
+
+const char *specialValuesModeName(specialValuesMode_et mode);
+
+double specialValuesSubnormalFraction(specialValuesClass_et operandClass);
+
+bool specialValuesModeSet(specialValuesMode_et mode);
+
+template<class classType>
+void specialValuesFill(specialValuesClass_et operandClass, classType *a, classType *b);
+
+template<size_t op, class classType>
+specialValuesTiming_t specialValuesMeasure(const classType *a, const classType *b, classType *out, size_t iterations);
+
+template<class classType, size_t... op>
+void specialValuesMeasureTableFill(specialValuesMeasure_ft<classType> measureTable[sv_count_e],
+                                   std::index_sequence<op...>);
+
+template<class classType>
+void specialValuesMeasureType(FILE *fileContext, size_t iterations);
+
+int testharness_SpecialValues(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the operation.
+*****************************************************************************/
+const char *specialValuesOpName(specialValuesOp_et op) {
+  const char *opName;
+  switch (op) {
+    case sv_addition_e:
+      opName = "addition";
+      break;
+    case sv_multiplication_e:
+      opName = "multiplication";
+      break;
+    case sv_division_e:
+      opName = "division";
+      break;
+    case sv_fma_e:
+      opName = "fused_multiply-add";
+      break;
+    case sv_sqrt_e:
+      opName = "sqrt";
+      break;
+    default:
+      opName = "unknown";
+      break;
+  }
+  return opName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the operand class.
+*****************************************************************************/
+const char *specialValuesClassName(specialValuesClass_et operandClass) {
+  const char *className;
+  switch (operandClass) {
+    case sc_normal_e:
+      className = "normal";
+      break;
+    case sc_subnormal_e:
+      className = "subnormal";
+      break;
+    case sc_zero_e:
+      className = "zero";
+      break;
+    case sc_infinity_e:
+      className = "infinity";
+      break;
+    case sc_nan_e:
+      className = "nan";
+      break;
+    case sc_mixed1_e:
+      className = "mixed_1pct";
+      break;
+    case sc_mixed10_e:
+      className = "mixed_10pct";
+      break;
+    case sc_mixed50_e:
+      className = "mixed_50pct";
+      break;
+    default:
+      className = "unknown";
+      break;
+  }
+  return className;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the MXCSR mode.
+*****************************************************************************/
+const char *specialValuesModeName(specialValuesMode_et mode) {
+  const char *modeName;
+  switch (mode) {
+    case sm_ieee_e:
+      modeName = "ieee";
+      break;
+    case sm_ftz_e:
+      modeName = "ftz";
+      break;
+    case sm_daz_e:
+      modeName = "daz";
+      break;
+    case sm_ftzDaz_e:
+      modeName = "ftz_daz";
+      break;
+    default:
+      modeName = "unknown";
+      break;
+  }
+  return modeName;
+}
+
+/******************************************************************************
+*
+* @return  fraction of subnormal operands the class generates.
+*****************************************************************************/
+double specialValuesSubnormalFraction(specialValuesClass_et operandClass) {
+  double fraction;
+  switch (operandClass) {
+    case sc_subnormal_e:
+      fraction = 1.0;
+      break;
+    case sc_mixed1_e:
+      fraction = 0.01;
+      break;
+    case sc_mixed10_e:
+      fraction = 0.10;
+      break;
+    case sc_mixed50_e:
+      fraction = 0.50;
+      break;
+    default:
+      fraction = 0.0;
+      break;
+  }
+  return fraction;
+}
+
+/******************************************************************************
+* Sets FTZ and DAZ of this thread's MXCSR, the other bits are kept.
+* @return  true when the mode is in effect.
+*****************************************************************************/
+bool specialValuesModeSet(specialValuesMode_et mode) {
+#if SPECIALVALUES_MXCSR_ENABLE
+  unsigned int control = _mm_getcsr() & ~(SPECIALVALUES_MXCSR_FTZ | SPECIALVALUES_MXCSR_DAZ);
+
+  if ((sm_ftz_e == mode) || (sm_ftzDaz_e == mode)) {
+    control |= SPECIALVALUES_MXCSR_FTZ;
+  }
+  if ((sm_daz_e == mode) || (sm_ftzDaz_e == mode)) {
+    control |= SPECIALVALUES_MXCSR_DAZ;
+  }
+  _mm_setcsr(control);
+  return true;
+#else // !SPECIALVALUES_MXCSR_ENABLE
+  return (sm_ieee_e == mode);
+#endif // SPECIALVALUES_MXCSR_ENABLE
+}
+
+/******************************************************************************
+* Operands of the class in a; b holds the second operand of addition from the
+* same class and a normal value in [0.5, 2) for the other operations at the
+* odd half of the array. Filled in the IEEE mode so subnormals survive.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void specialValuesFill(specialValuesClass_et operandClass, classType *a, classType *b) {
+  const long double subnormalMax = (long double) std::numeric_limits<classType>::min();
+  double fraction = specialValuesSubnormalFraction(operandClass);
+  double uniform;
+  classType value;
+
+  for (size_t index = 0; index < 2 * SPECIALVALUES_ARRAY_SIZE; index++) {
+    uniform = gauss_rand<double>(1);
+    switch (operandClass) {
+      case sc_subnormal_e:
+        value = (classType) (subnormalMax * uniform * 0.999);
+        break;
+      case sc_zero_e:
+        value = (index & 1) ? (classType) -0.0 : (classType) 0.0;
+        break;
+      case sc_infinity_e:
+        value = (index & 1) ? -std::numeric_limits<classType>::infinity() : std::numeric_limits<classType>::infinity();
+        break;
+      case sc_nan_e:
+        value = std::numeric_limits<classType>::quiet_NaN();
+        break;
+      case sc_mixed1_e:
+      case sc_mixed10_e:
+      case sc_mixed50_e:
+        if (gauss_rand<double>(1) <= fraction) {
+          value = (classType) (subnormalMax * uniform * 0.999);
+        } else {
+          value = (classType) (1.0 + uniform);
+        }
+        break;
+      case sc_normal_e:
+      default:
+        value = (classType) (1.0 + uniform);
+        break;
+    }
+    if (index < SPECIALVALUES_ARRAY_SIZE) {
+      a[index] = value;
+    } else {
+      b[index - SPECIALVALUES_ARRAY_SIZE] = value;
+    }
+  }
+  // Multiplier and divisor operands stay normal, the upper half of b is read by those operations.
+  for (size_t index = SPECIALVALUES_ARRAY_SIZE; index < 2 * SPECIALVALUES_ARRAY_SIZE; index++) {
+    b[index] = (classType) (0.5 + 1.5 * gauss_rand<double>(1));
+  }
+  return;
+}
+
+/******************************************************************************
+* Independent operations over the operand arrays, kept scalar so the cost
+* of each instruction is measured.
+* @return  loop time and cycles.
+*****************************************************************************/
+template<size_t op, class classType>
+__attribute__((noinline, optimize("no-tree-vectorize")))
+specialValuesTiming_t specialValuesMeasure(const classType *a, const classType *b, classType *out, size_t iterations) {
+  const classType *multiplier = b + ((sv_addition_e == op) ? 0 : SPECIALVALUES_ARRAY_SIZE);
+  specialValuesTiming_t timing;
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    if constexpr (sv_addition_e == op) {
+      out[index] = a[index] + multiplier[index];
+    } else if constexpr (sv_multiplication_e == op) {
+      out[index] = a[index] * multiplier[index];
+    } else if constexpr (sv_division_e == op) {
+      out[index] = a[index] / multiplier[index];
+    } else if constexpr (sv_fma_e == op) {
+      out[index] = std::fma(a[index], multiplier[index], a[index]);
+    } else {
+      out[index] = std::sqrt(std::fabs(a[index]));
+    }
+    index = (index + 1) & (SPECIALVALUES_ARRAY_SIZE - 1);
+  }
+  timing.cycleDelta = getCycleCount() - cycleStart;
+  timing.timeDelta = getTime() - timeStart;
+  return timing;
+}
+
+/******************************************************************************
+* Measurement loops indexed by specialValuesOp_et.
+* @return  None
+*****************************************************************************/
+template<class classType, size_t... op>
+void specialValuesMeasureTableFill(specialValuesMeasure_ft<classType> measureTable[sv_count_e],
+                                   std::index_sequence<op...>) {
+  ((measureTable[op] = specialValuesMeasure<op, classType>), ...);
+  return;
+}
+
+/******************************************************************************
+* Every operation, MXCSR mode and operand class of one type. The normal class
+* runs first in each mode and is the reference of the slowdown factor.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void specialValuesMeasureType(FILE *fileContext, size_t iterations) {
+  specialValuesMeasure_ft<classType> measureTable[sv_count_e];
+  std::vector<classType> a(SPECIALVALUES_ARRAY_SIZE), b(2 * SPECIALVALUES_ARRAY_SIZE), out(SPECIALVALUES_ARRAY_SIZE);
+  std::vector<classType> operandsA[sc_count_e], operandsB[sc_count_e];
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  double normalTime[sv_count_e];
+  specialValuesTiming_t timing;
+  size_t subnormalResults;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  specialValuesMeasureTableFill<classType>(measureTable, std::make_index_sequence<sv_count_e>{});
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  specialValuesModeSet(sm_ieee_e);
+  for (size_t operandClass = 0; operandClass < sc_count_e; operandClass++) {
+    operandsA[operandClass].resize(SPECIALVALUES_ARRAY_SIZE);
+    operandsB[operandClass].resize(2 * SPECIALVALUES_ARRAY_SIZE);
+    specialValuesFill<classType>((specialValuesClass_et) operandClass, operandsA[operandClass].data(),
+                                 operandsB[operandClass].data());
+  }
+
+  for (size_t mode = 0; mode < sm_count_e; mode++) {
+    if (!specialValuesModeSet((specialValuesMode_et) mode)) {
+      continue;
+    }
+    for (size_t op = 0; op < sv_count_e; op++) {
+      for (size_t operandClass = 0; operandClass < sc_count_e; operandClass++) {
+        frequencyStart = frequencyMonitorRead(harnessMonitor);
+        timing = measureTable[op](operandsA[operandClass].data(), operandsB[operandClass].data(), out.data(),
+                                  iterations);
+        frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+        if (sc_normal_e == operandClass) {
+          normalTime[op] = timing.timeDelta;
+        }
+        subnormalResults = 0;
+        for (size_t index = 0; index < std::min(iterations, (size_t) SPECIALVALUES_ARRAY_SIZE); index++) {
+          subnormalResults += (FP_SUBNORMAL == std::fpclassify(out[index])) ? 1 : 0;
+        }
+        resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %f, %s, %zu, %f, %f, %f, %f, %f",
+                       specialValuesOpName((specialValuesOp_et) op), typeNameBuffer,
+                       specialValuesClassName((specialValuesClass_et) operandClass),
+                       specialValuesSubnormalFraction((specialValuesClass_et) operandClass),
+                       specialValuesModeName((specialValuesMode_et) mode), iterations,
+                       (timing.timeDelta * 1e9) / (double) iterations,
+                       (double) timing.cycleDelta / (double) iterations,
+                       (timing.timeDelta > 0.0) ? ((double) iterations / timing.timeDelta) : 0.0,
+                       (normalTime[op] > 0.0) ? (timing.timeDelta / normalTime[op]) : 0.0,
+                       (double) subnormalResults / (double) std::min(iterations, (size_t) SPECIALVALUES_ARRAY_SIZE));
+      }
+    }
+  }
+  specialValuesModeSet(sm_ieee_e);
+  return;
+}
+
+/******************************************************************************
+* Times floating point kernels on normal, subnormal, zero, infinite, NaN and
+* mixed operands with flush-to-zero and denormals-are-zero off and on, and
+* reports each class relative to normal operands.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_SpecialValues(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Operation, Type System, Operand Class, Subnormal Operand Fraction, MXCSR Mode, Operations, "
+                            "Nanoseconds per Operation, Cycles per Operation, Operations per Second, "
+                            "Slowdown versus Normal, Subnormal Result Fraction";
+  size_t iterations = (options.iterations > 0) ? options.iterations : SPECIALVALUES_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+#if !SPECIALVALUES_MXCSR_ENABLE
+  printf("MXCSR is not available, only the IEEE mode is measured.\n");
+#endif // !SPECIALVALUES_MXCSR_ENABLE
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("SpecialValues", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  specialValuesMeasureType<float>(fileContext, iterations);
+  specialValuesMeasureType<double>(fileContext, iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSPECIALVALUES_HPP_
@@ -0,0 +1,324 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes, uses the roofline family for working sets.
+
+#ifndef _CPUBENCHMARKSTENCIL_HPP_
+#define _CPUBENCHMARKSTENCIL_HPP_
+
+#define STENCIL_POINTS_PER_MEASUREMENT (1ULL << 30) // Sweeps are repeated up to this many point updates
+#define STENCIL_EDGE_MIN 8 // Smallest grid edge, boundaries included
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum stencilShape_e {
+  ss_1d3_e = 0, // 3 point line
+  ss_2d5_e = 1, // 5 point plane
+  ss_3d7_e = 2, // 7 point volume
+  ss_count_e = 3
+} stencilShape_et;
+
+// Thread arguments are written by the owning thread, so they are padded.
+typedef struct alignas(CACHE_LINE_SIZE) stencilThread {
+  stencilShape_et shape; // Stencil under test
+  size_t edge; // Points per dimension, boundaries included
+  size_t outerStart; // First interior index of the outermost dimension owned by the thread
+  size_t outerEnd; // One past the last owned index
+  size_t sweeps; // Jacobi sweeps, the grids swap after each
+  void *gridA; // Initial grid
+  void *gridB; // Second grid
+  pthread_barrier_t *sweepBarrier; // Separates sweeps, also releases all threads at once
+  double timeStart; // Right after the first barrier
+  double timeStop; // After the barrier of the last sweep
+} stencilThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *stencilShapeName(stencilShape_et shape);
+
+size_t stencilDimensions(stencilShape_et shape);
+
+template<class classType>
+void stencilSweep(stencilShape_et shape, const classType *in, classType *out, size_t edge, size_t outerStart,
+                  size_t outerEnd);
+
+template<class classType>
+void *stencil_Pthread(void *inArgs);
+
+template<class classType>
+double stencilMeasure(stencilShape_et shape, classType *gridA, classType *gridB, size_t edge, size_t threadCount,
+                      size_t sweeps);
+
+template<class classType>
+void stencilMeasureType(FILE *fileContext, size_t threadMax, size_t sweepsOption);
+
+int testharness_Stencil(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the stencil.
+*****************************************************************************/
+const char *stencilShapeName(stencilShape_et shape) {
+  const char *shapeName;
+  switch (shape) {
+    case ss_1d3_e:
+      shapeName = "1d_3point";
+      break;
+    case ss_2d5_e:
+      shapeName = "2d_5point";
+      break;
+    case ss_3d7_e:
+      shapeName = "3d_7point";
+      break;
+    default:
+      shapeName = "unknown";
+      break;
+  }
+  return shapeName;
+}
+
+/******************************************************************************
+*
+* @return  dimensions of the grid.
+*****************************************************************************/
+size_t stencilDimensions(stencilShape_et shape) {
+  return (size_t) shape + 1;
+}
+
+/******************************************************************************
+* One Jacobi sweep of the interior over outermost indices [outerStart,
+* outerEnd); out = center * c0 + (sum of neighbors) * c1. Compiled like any
+* other loop of the harness.
+* @return  None
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+void stencilSweep(stencilShape_et shape, const classType *in, classType *out, size_t edge, size_t outerStart,
+                  size_t outerEnd) {
+  const classType center = (classType) 0.5;
+  const classType neighbor = (classType) 0.5 / (classType) (2 * stencilDimensions(shape));
+  const size_t plane = edge * edge;
+  size_t base;
+
+  switch (shape) {
+    case ss_1d3_e:
+      for (size_t index = outerStart; index < outerEnd; index++) {
+        out[index] = center * in[index] + neighbor * (in[index - 1] + in[index + 1]);
+      }
+      break;
+    case ss_2d5_e:
+      for (size_t row = outerStart; row < outerEnd; row++) {
+        base = row * edge;
+        for (size_t column = 1; column < (edge - 1); column++) {
+          out[base + column] = center * in[base + column] +
+                               neighbor * (in[base + column - 1] + in[base + column + 1] +
+                                           in[base + column - edge] + in[base + column + edge]);
+        }
+      }
+      break;
+    case ss_3d7_e:
+    default:
+      for (size_t depth = outerStart; depth < outerEnd; depth++) {
+        for (size_t row = 1; row < (edge - 1); row++) {
+          base = depth * plane + row * edge;
+          for (size_t column = 1; column < (edge - 1); column++) {
+            out[base + column] = center * in[base + column] +
+                                 neighbor * (in[base + column - 1] + in[base + column + 1] +
+                                             in[base + column - edge] + in[base + column + edge] +
+                                             in[base + column - plane] + in[base + column + plane]);
+          }
+        }
+      }
+      break;
+  }
+  return;
+}
+
+/******************************************************************************
+* Sweeps the owned slab, waiting for the team between sweeps.
+* @return  the thread arguments.
+*****************************************************************************/
+template<class classType>
+void *stencil_Pthread(void *inArgs) {
+  stencilThread_t *threadInfo = (stencilThread_t *) inArgs;
+  classType *in = (classType *) threadInfo->gridA;
+  classType *out = (classType *) threadInfo->gridB;
+
+  pthread_barrier_wait(threadInfo->sweepBarrier);
+  threadInfo->timeStart = getTime();
+  for (size_t sweep = 0; sweep < threadInfo->sweeps; sweep++) {
+    stencilSweep<classType>(threadInfo->shape, in, out, threadInfo->edge, threadInfo->outerStart,
+                            threadInfo->outerEnd);
+    std::swap(in, out);
+    pthread_barrier_wait(threadInfo->sweepBarrier);
+  }
+  threadInfo->timeStop = getTime();
+  return inArgs;
+}
+
+/******************************************************************************
+* Splits the outermost interior dimension over the thread team.
+* @return  wall time from the first thread leaving the barrier to the last
+*          thread finishing, negative on failure.
+*****************************************************************************/
+template<class classType>
+double stencilMeasure(stencilShape_et shape, classType *gridA, classType *gridB, size_t edge, size_t threadCount,
+                      size_t sweeps) {
+  size_t interior = edge - 2;
+  size_t slab = (interior + threadCount - 1) / threadCount;
+  std::vector<stencilThread_t> threadInfo(threadCount);
+  std::vector<void *> threadArgs(threadCount);
+  pthread_barrier_t sweepBarrier;
+  double timeStart = 0.0, timeStop = 0.0;
+  bool isValid;
+
+  pthread_barrier_init(&sweepBarrier, NULL, threadCount);
+  for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+    threadInfo[threadIndex].shape = shape;
+    threadInfo[threadIndex].edge = edge;
+    threadInfo[threadIndex].outerStart = 1 + std::min(interior, threadIndex * slab);
+    threadInfo[threadIndex].outerEnd = 1 + std::min(interior, (threadIndex + 1) * slab);
+    threadInfo[threadIndex].sweeps = sweeps;
+    threadInfo[threadIndex].gridA = gridA;
+    threadInfo[threadIndex].gridB = gridB;
+    threadInfo[threadIndex].sweepBarrier = &sweepBarrier;
+    threadInfo[threadIndex].timeStart = 0.0;
+    threadInfo[threadIndex].timeStop = 0.0;
+    threadArgs[threadIndex] = &threadInfo[threadIndex];
+  }
+  isValid = threadTeamRun(stencil_Pthread<classType>, threadArgs, true);
+  pthread_barrier_destroy(&sweepBarrier);
+
+  if (isValid) {
+    timeStart = threadInfo[0].timeStart;
+    for (size_t threadIndex = 0; threadIndex < threadCount; threadIndex++) {
+      timeStart = std::min(timeStart, threadInfo[threadIndex].timeStart);
+      timeStop = std::max(timeStop, threadInfo[threadIndex].timeStop);
+    }
+  }
+  return isValid ? (timeStop - timeStart) : -1.0;
+}
+
+/******************************************************************************
+* Every stencil of one type on the roofline working sets, for thread counts
+* doubling up to threadMax. The single thread grid is the reference of the
+* parallel ones.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void stencilMeasureType(FILE *fileContext, size_t threadMax, size_t sweepsOption) {
+  size_t workingSetLevel[rl_count_e];
+  size_t edge, edgeLast, points, interiorPoints, sweeps, dimensions;
+  std::vector<classType> gridA, gridB, reference;
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  double timeDelta, updates, difference;
+  const classType *result;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  rooflineWorkingSetSelect(workingSetLevel);
+  for (size_t shape = 0; shape < ss_count_e; shape++) {
+    dimensions = stencilDimensions((stencilShape_et) shape);
+    edgeLast = 0;
+    for (size_t level = 0; level < rl_count_e; level++) {
+      if (0 == workingSetLevel[level]) {
+        continue;
+      }
+      // Two grids make up the working set.
+      points = workingSetLevel[level] / (2 * sizeof(classType));
+      edge = (size_t) std::pow((double) points, 1.0 / (double) dimensions);
+      edge = std::max((size_t) STENCIL_EDGE_MIN, edge);
+      if (edge == edgeLast) {
+        continue;
+      }
+      edgeLast = edge;
+      points = 1;
+      interiorPoints = 1;
+      for (size_t dimension = 0; dimension < dimensions; dimension++) {
+        points *= edge;
+        interiorPoints *= edge - 2;
+      }
+      sweeps = (sweepsOption > 0) ? sweepsOption
+                                  : std::max((size_t) 1, (size_t) (STENCIL_POINTS_PER_MEASUREMENT / interiorPoints));
+      updates = (double) interiorPoints * (double) sweeps;
+
+      for (size_t threadCount = 1; threadCount <= threadMax;) {
+        gridA.assign(points, 0);
+        for (size_t index = 0; index < points; index++) {
+          gridA[index] = (classType) ((index % 17) + 1) / (classType) 17;
+        }
+        gridB = gridA;
+        frequencyStart = frequencyMonitorRead(harnessMonitor);
+        timeDelta = stencilMeasure<classType>((stencilShape_et) shape, gridA.data(), gridB.data(), edge, threadCount,
+                                              sweeps);
+        frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+        result = (0 == (sweeps & 1)) ? gridA.data() : gridB.data();
+        if (1 == threadCount) {
+          reference.assign(result, result + points);
+        }
+        difference = 0.0;
+        for (size_t index = 0; index < points; index++) {
+          difference = std::max(difference, (double) std::fabs(result[index] - reference[index]));
+        }
+        resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %zu, %s, %zu, %zu, %f, %f, %f, %f, %e",
+                       stencilShapeName((stencilShape_et) shape), typeNameBuffer, edge,
+                       2 * points * sizeof(classType), rooflineLevelName((rooflineLevel_et) level), threadCount,
+                       sweeps, timeDelta, (timeDelta > 0.0) ? (updates / timeDelta / 1e6) : 0.0,
+                       (timeDelta > 0.0) ? (updates * (double) (2 * dimensions + 2) / timeDelta / 1e9) : 0.0,
+                       (timeDelta > 0.0) ? (updates * 2.0 * sizeof(classType) / timeDelta / 1e9) : 0.0,
+                       difference);
+        if ((threadCount < threadMax) && ((2 * threadCount) > threadMax)) {
+          threadCount = threadMax;
+        } else {
+          threadCount *= 2;
+        }
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures 1D, 2D and 3D Jacobi stencils with working sets from L1 to DRAM,
+* single threaded and split over the thread team.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Stencil(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Stencil, Type System, Edge, Working Set Bytes, Memory Level, Threads, Sweeps, "
+                            "Time for Operations, Million Updates per Second, GFLOP per Second, "
+                            "Compulsory Gigabytes per Second, Max Difference versus Single Thread";
+  size_t threadMax = (options.threadCount > 0) ? options.threadCount : getNumCores();
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  printf("Compulsory traffic is one read and one write of every updated point.\n");
+  fileContext = resultFileOpen("Stencil", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  stencilMeasureType<float>(fileContext, threadMax, options.iterations);
+  stencilMeasureType<double>(fileContext, threadMax, options.iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSTENCIL_HPP_
@@ -0,0 +1,443 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKSTORE_HPP_
+#define _CPUBENCHMARKSTORE_HPP_
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+#define STORE_RUN_DIRECTORY "runs" // Immutable run files below the store directory
+#define STORE_INDEX_FILE "index.cvs" // Append only index below the store directory
+#define STORE_INDEX_HEADER "Fingerprint, Git Revision, Created, Family, Type System, Operation, Run File"
+#define STORE_INDEX_COLUMNS 7 // Cells of an index line
+#define STORE_RUN_SUFFIX_MAX 100 // Suffixes tried when two result files would get the same run file name
+#define STORE_STEP_RUNS 3 // Runs pooled on either side of a candidate step change
+#define STORE_STEP_RUNS_MAX 8 // Widest window, used when fewer samples can not reach --significance
+#define STORE_FAMILY_PREFIX "cpuBenchmark" // Result file name prefix dropped from the family name
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+// One line of the index, a row of a stored run file.
+typedef struct storeEntry {
+  std::string fingerprint; // Host fingerprint of the run
+  std::string revision; // Git revision the harness was built from
+  std::string created; // UTC time the result file was created, sorts as text
+  std::string family; // Result file name without prefix and extension
+  std::string typeName; // Type System cell, empty for families without one
+  std::string operation; // Remaining key cells, operation and thread configuration
+  std::string runFile; // Path of the run file relative to the store directory
+} storeEntry_t;
+
+// Entries of one fingerprint, family, type and operation, oldest first.
+typedef struct storeSeries {
+  std::vector<const storeEntry_t *> entries;
+} storeSeries_t;
+
+// Samples of one metric for one entry of a series.
+typedef struct storePoint {
+  const storeEntry_t *entry; // Run the samples come from
+  std::vector<double> samples; // One per repetition of the run
+  double median; // Median of the samples
+  double change; // Percent change of the pooled windows around the point, positive is worse
+  double pValue; // Mann-Whitney p value of the pooled windows
+  bool isStep; // Largest significant change within STORE_STEP_RUNS points
+  bool isTestable; // The windows hold enough samples to reach --significance
+} storePoint_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+void storeKeySplit(const compareFile_t &file, const compareRow_t &row, std::string &typeName,
+                   std::string &operation);
+
+std::string storeFamilyName(const std::string &fileName);
+
+bool storeFileCopy(const char *sourceName, const char *destinationName);
+
+bool storeRunAppend(const char *storeDirectory);
+
+bool storeIndexLoad(const char *storeDirectory, std::vector<storeEntry_t> &entries);
+
+bool storeEntryCompare(const storeEntry_t *left, const storeEntry_t *right);
+
+double storeSmallestPValue(size_t leftCount, size_t rightCount);
+
+void storeStepsFind(std::vector<storePoint_t> &points, bool isHigherBetter, const benchmarkOptions_t &options);
+
+int testharness_Query(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+* Splits the key of a row into the type and the rest, the operation together
+* with its sizes and thread configuration.
+* @return  None
+*****************************************************************************/
+void storeKeySplit(const compareFile_t &file, const compareRow_t &row, std::string &typeName,
+                   std::string &operation) {
+  typeName.clear();
+  operation.clear();
+  for (size_t column = 0; column < row.keyCells.size(); column++) {
+    if ("Type System" == file.columns[column]) {
+      typeName = row.keyCells[column];
+    } else {
+      operation += operation.empty() ? row.keyCells[column] : (COMPARE_KEY_SEPARATOR + row.keyCells[column]);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+*
+* @return  family of a result file, cpuBenchmarkSyscall.cvs gives Syscall.
+*****************************************************************************/
+std::string storeFamilyName(const std::string &fileName) {
+  size_t start = fileName.find_last_of("/\\");
+  std::string family = fileName.substr((std::string::npos == start) ? 0 : (start + 1));
+
+  if (0 == family.compare(0, strlen(STORE_FAMILY_PREFIX), STORE_FAMILY_PREFIX)) {
+    family.erase(0, strlen(STORE_FAMILY_PREFIX));
+  }
+  family = family.substr(0, family.find_last_of('.'));
+  return family;
+}
+
+/******************************************************************************
+* Copies a result file into the store. The destination must not exist and is
+* made read only, run files are never changed once written.
+* @return  true if the whole file was copied.
+*****************************************************************************/
+bool storeFileCopy(const char *sourceName, const char *destinationName) {
+  std::vector<char> buffer(COMPARE_LINE_SIZE);
+  FILE *sourceContext, *destinationContext;
+  bool isCopied = true;
+  size_t bytesRead;
+
+  sourceContext = fopen(sourceName, "rb");
+  if (NULL == sourceContext) {
+    return false;
+  }
+  destinationContext = fopen(destinationName, "wbx");
+  if (NULL == destinationContext) {
+    fclose(sourceContext);
+    return false;
+  }
+  while (isCopied && (0 < (bytesRead = fread(buffer.data(), 1, buffer.size(), sourceContext)))) {
+    isCopied = (bytesRead == fwrite(buffer.data(), 1, bytesRead, destinationContext));
+  }
+  isCopied = isCopied && !ferror(sourceContext);
+  fclose(sourceContext);
+  isCopied = (0 == fclose(destinationContext)) && isCopied;
+  if (isCopied) {
+    chmod(destinationName, S_IRUSR | S_IRGRP | S_IROTH);
+  }
+  return isCopied;
+}
+
+/******************************************************************************
+* Copies every result file this run created into the run directory of the
+* store and appends one index line per row. Files without a measurement
+* column are stored but not indexed.
+* @return  true if every file was stored and indexed.
+*****************************************************************************/
+bool storeRunAppend(const char *storeDirectory) {
+  std::vector<std::string> resultFiles(harnessResultFiles);
+  std::string runDirectory = std::string(storeDirectory) + "/" + STORE_RUN_DIRECTORY;
+  std::string indexName = std::string(storeDirectory) + "/" + STORE_INDEX_FILE;
+  std::string typeName, operation, runName, runPath;
+  size_t storedCount = 0, indexedCount = 0;
+  bool isValid = true, isIndexNew;
+  FILE *indexContext;
+
+  std::sort(resultFiles.begin(), resultFiles.end());
+  resultFiles.erase(std::unique(resultFiles.begin(), resultFiles.end()), resultFiles.end());
+  fileMakeDirectories(runDirectory.c_str());
+  isIndexNew = (fs_Found_vet != fileIsFound(indexName.c_str()));
+  indexContext = fopen(indexName.c_str(), "a");
+  if (NULL == indexContext) {
+    fprintf(stderr, "Unable to append to %s : %s.\n", indexName.c_str(), strerror(errno));
+    return false;
+  }
+  if (isIndexNew) {
+    fprintf(indexContext, "%s\n", STORE_INDEX_HEADER);
+  }
+
+  for (size_t fileIndex = 0; fileIndex < resultFiles.size(); fileIndex++) {
+    compareFile_t file;
+    bool isIndexed = compareFileLoad(resultFiles[fileIndex].c_str(), NULL, file);
+    std::string created = file.metadata["created"];
+    std::string createdCompact;
+    std::string revision = file.metadata.count("git_revision") ? file.metadata["git_revision"] : GIT_REVISION;
+    std::string family = storeFamilyName(resultFiles[fileIndex]);
+
+    for (size_t character = 0; character < created.size(); character++) {
+      if (('-' != created[character]) && (':' != created[character])) {
+        createdCompact += created[character];
+      }
+    }
+    runName.clear();
+    for (size_t suffix = 0; suffix < STORE_RUN_SUFFIX_MAX; suffix++) {
+      std::string candidateName = createdCompact + "_" + file.fingerprint + "_" + revision + "_" + family +
+                                  ((0 == suffix) ? std::string() : ("_" + std::to_string(suffix))) + ".cvs";
+      runPath = runDirectory + "/" + candidateName;
+      if (fs_Found_vet != fileIsFound(runPath.c_str())) {
+        runName = std::string(STORE_RUN_DIRECTORY) + "/" + candidateName;
+        break;
+      }
+    }
+    if (runName.empty() || !storeFileCopy(resultFiles[fileIndex].c_str(), runPath.c_str())) {
+      fprintf(stderr, "Unable to store %s in %s.\n", resultFiles[fileIndex].c_str(), runDirectory.c_str());
+      isValid = false;
+      continue;
+    }
+    storedCount++;
+    for (size_t row = 0; isIndexed && (row < file.rows.size()); row++) {
+      storeKeySplit(file, file.rows[row], typeName, operation);
+      fprintf(indexContext, "%s, %s, %s, %s, %s, %s, %s\n", file.fingerprint.c_str(), revision.c_str(),
+              created.c_str(), family.c_str(), typeName.c_str(), operation.c_str(), runName.c_str());
+      indexedCount++;
+    }
+  }
+  fclose(indexContext);
+  printf("Stored %zu result files in %s, indexed %zu rows.\n", storedCount, storeDirectory, indexedCount);
+  return isValid;
+}
+
+/******************************************************************************
+*
+* @return  true if the index of the store was read.
+*****************************************************************************/
+bool storeIndexLoad(const char *storeDirectory, std::vector<storeEntry_t> &entries) {
+  std::string indexName = std::string(storeDirectory) + "/" + STORE_INDEX_FILE;
+  std::vector<char> line(COMPARE_LINE_SIZE);
+  std::vector<std::string> cells;
+  FILE *indexContext;
+
+  entries.clear();
+  indexContext = fopen(indexName.c_str(), "r");
+  if (NULL == indexContext) {
+    fprintf(stderr, "Unable to read %s : %s.\n", indexName.c_str(), strerror(errno));
+    return false;
+  }
+  while (NULL != fgets(line.data(), (int) line.size(), indexContext)) {
+    compareSplitCells(line.data(), cells);
+    if ((STORE_INDEX_COLUMNS != cells.size()) || ("Fingerprint" == cells[0])) {
+      continue;
+    }
+    storeEntry_t entry;
+    entry.fingerprint = cells[0];
+    entry.revision = cells[1];
+    entry.created = cells[2];
+    entry.family = cells[3];
+    entry.typeName = cells[4];
+    entry.operation = cells[5];
+    entry.runFile = cells[6];
+    entries.push_back(entry);
+  }
+  fclose(indexContext);
+  return true;
+}
+
+/******************************************************************************
+*
+* @return  true if the left entry was created before the right one.
+*****************************************************************************/
+bool storeEntryCompare(const storeEntry_t *left, const storeEntry_t *right) {
+  if (left->created != right->created) {
+    return left->created < right->created;
+  }
+  return left->runFile < right->runFile;
+}
+
+/******************************************************************************
+* Smallest two sided p value of the exact Mann-Whitney test, both samples
+* completely separated, 2 / C(left + right, left).
+* @return  the p value no shift of samples this size can go below.
+*****************************************************************************/
+double storeSmallestPValue(size_t leftCount, size_t rightCount) {
+  double orderings = 1;
+
+  for (size_t sample = 1; sample <= leftCount; sample++) {
+    orderings = orderings * (double) (rightCount + sample) / (double) sample;
+  }
+  return std::min(1.0, 2 / orderings);
+}
+
+/******************************************************************************
+* A step is a point where the samples of the runs after it differ from those
+* of the runs before it, significant at --significance and by more than
+* --threshold percent. The windows start at STORE_STEP_RUNS runs and widen up
+* to STORE_STEP_RUNS_MAX while their sample counts can not reach the
+* significance, runs stored without --repeat hold one sample each. Of
+* neighbouring candidates only the largest change is kept, a single step
+* lifts every window that straddles it.
+* @return  None
+*****************************************************************************/
+void storeStepsFind(std::vector<storePoint_t> &points, bool isHigherBetter, const benchmarkOptions_t &options) {
+  std::vector<bool> isCandidate(points.size(), false);
+  double statisticU, medianBefore;
+
+  for (size_t point = 1; point < points.size(); point++) {
+    std::vector<double> before, after;
+    for (size_t runs = STORE_STEP_RUNS; runs <= STORE_STEP_RUNS_MAX; runs++) {
+      before.clear();
+      after.clear();
+      for (size_t window = ((point > runs) ? (point - runs) : 0); window < point; window++) {
+        before.insert(before.end(), points[window].samples.begin(), points[window].samples.end());
+      }
+      for (size_t window = point; window < std::min(points.size(), point + runs); window++) {
+        after.insert(after.end(), points[window].samples.begin(), points[window].samples.end());
+      }
+      points[point].isTestable = (storeSmallestPValue(before.size(), after.size()) < options.significance);
+      if (points[point].isTestable || ((point <= runs) && ((point + runs) >= points.size()))) {
+        break;
+      }
+    }
+    medianBefore = compareMedian(before);
+    points[point].change = (0 != medianBefore) ? (100 * (compareMedian(after) - medianBefore) / fabs(medianBefore))
+                                               : 0;
+    points[point].change = isHigherBetter ? -points[point].change : points[point].change;
+    points[point].pValue = compareMannWhitney(before, after, statisticU);
+    isCandidate[point] = (points[point].pValue < options.significance) &&
+                         (fabs(points[point].change) > options.threshold);
+  }
+  for (size_t point = 1; point < points.size(); point++) {
+    points[point].isStep = isCandidate[point];
+    for (size_t other = 1; points[point].isStep && (other < points.size()); other++) {
+      size_t distance = (other > point) ? (other - point) : (point - other);
+      if ((other == point) || !isCandidate[other] || (distance >= STORE_STEP_RUNS)) {
+        continue;
+      }
+      if ((fabs(points[other].change) > fabs(points[point].change)) ||
+          ((fabs(points[other].change) == fabs(points[point].change)) && (other < point))) {
+        points[point].isStep = false;
+      }
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Prints the time series of every metric for the index entries that match
+* --fingerprint, --family, --type and --operation, one series per host,
+* family, type and operation, and flags the step changes in each.
+* @return  EXIT_SUCCESS if the store was read, EXIT_FAILURE otherwise.
+*****************************************************************************/
+int testharness_Query(const benchmarkOptions_t &options) {
+  std::vector<storeEntry_t> entries;
+  std::map<std::string, storeSeries_t> seriesMap;
+  std::map<std::string, compareFile_t> runCache;
+  std::string typeName, operation;
+  size_t seriesCount = 0, stepCount = 0;
+
+  if (NULL == options.storeDirectory) {
+    fprintf(stderr, "Mode query requires --store DIR.\n");
+    return EXIT_FAILURE;
+  }
+  if (!storeIndexLoad(options.storeDirectory, entries)) {
+    return EXIT_FAILURE;
+  }
+  for (size_t entry = 0; entry < entries.size(); entry++) {
+    const storeEntry_t &item = entries[entry];
+    if (((NULL != options.fingerprint) && (0 != item.fingerprint.compare(0, strlen(options.fingerprint),
+                                                                          options.fingerprint))) ||
+        ((NULL != options.family) && (item.family != options.family)) ||
+        ((NULL != options.typeName) && (item.typeName != options.typeName)) ||
+        ((NULL != options.operation) && (std::string::npos == item.operation.find(options.operation)))) {
+      continue;
+    }
+    std::string seriesKey = item.fingerprint + COMPARE_KEY_SEPARATOR + item.family + COMPARE_KEY_SEPARATOR +
+                            item.typeName + COMPARE_KEY_SEPARATOR + item.operation;
+    seriesMap[seriesKey].entries.push_back(&item);
+  }
+
+  for (std::map<std::string, storeSeries_t>::iterator series = seriesMap.begin(); series != seriesMap.end();
+       ++series) {
+    std::vector<const storeEntry_t *> &seriesEntries = series->second.entries;
+    const storeEntry_t &first = *seriesEntries[0];
+    std::string runPath = std::string(options.storeDirectory) + "/" + first.runFile;
+    compareFile_t header;
+
+    std::sort(seriesEntries.begin(), seriesEntries.end(), storeEntryCompare);
+    if (!compareFileLoad(runPath.c_str(), NULL, header)) {
+      continue;
+    }
+    seriesCount++;
+    printf("Series %s, %s, %s, %s, %zu runs\n", first.fingerprint.c_str(), first.family.c_str(),
+           first.typeName.empty() ? "-" : first.typeName.c_str(), first.operation.c_str(), seriesEntries.size());
+    for (size_t column = header.keyColumns; column < header.columns.size(); column++) {
+      const std::string &metric = header.columns[column];
+      std::vector<storePoint_t> points;
+      if (((NULL != options.metric) && (metric != options.metric)) ||
+          ((NULL == options.metric) && !compareIsMeasurement(metric))) {
+        continue;
+      }
+      for (size_t entry = 0; entry < seriesEntries.size(); entry++) {
+        std::string cacheKey = seriesEntries[entry]->runFile + COMPARE_KEY_SEPARATOR + metric;
+        if (runCache.end() == runCache.find(cacheKey)) {
+          runPath = std::string(options.storeDirectory) + "/" + seriesEntries[entry]->runFile;
+          compareFileLoad(runPath.c_str(), metric.c_str(), runCache[cacheKey]);
+        }
+        const compareFile_t &run = runCache[cacheKey];
+        for (size_t row = 0; row < run.rows.size(); row++) {
+          storeKeySplit(run, run.rows[row], typeName, operation);
+          if ((typeName == seriesEntries[entry]->typeName) && (operation == seriesEntries[entry]->operation)) {
+            storePoint_t point = {seriesEntries[entry], run.rows[row].samples, 0, 0, 1, false, false};
+            point.median = compareMedian(point.samples);
+            points.push_back(point);
+            break;
+          }
+        }
+      }
+      if (points.empty()) {
+        continue;
+      }
+      size_t untestableCount = 0;
+      storeStepsFind(points, compareIsHigherBetter(metric), options);
+      printf("  %s, %s is better\n", metric.c_str(), compareIsHigherBetter(metric) ? "higher" : "lower");
+      printf("    %-20s %-12s %16s %8s %10s %10s  %s\n", "Created", "Revision", "Median", "Samples", "Change %", "p",
+             "Step");
+      for (size_t point = 0; point < points.size(); point++) {
+        const storePoint_t &item = points[point];
+        printf("    %-20s %-12s %16.6g %8zu", item.entry->created.c_str(), item.entry->revision.c_str(), item.median,
+               item.samples.size());
+        if (0 == point) {
+          printf("\n");
+        } else {
+          printf(" %+10.2f %10.3g%s\n", item.change, item.pValue,
+                 item.isStep ? ((item.change > 0) ? "  step, worse" : "  step, better") : "");
+        }
+        stepCount += item.isStep ? 1 : 0;
+        untestableCount += ((0 < point) && !item.isTestable) ? 1 : 0;
+      }
+      if (untestableCount > 0) {
+        printf("    %zu runs have too few samples around them to reach p < %.3g, store more runs or use --repeat.\n",
+               untestableCount, options.significance);
+      }
+    }
+  }
+  printf("Queried %zu series of %zu index entries, %zu step changes, threshold %.2f%% at p < %.3g.\n",
+         seriesCount, entries.size(), stepCount, options.threshold, options.significance);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSTORE_HPP_
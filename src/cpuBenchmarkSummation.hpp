@@ -0,0 +1,448 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKSUMMATION_HPP_
+#define _CPUBENCHMARKSUMMATION_HPP_
+
+#include <limits>
+
+#define SUMMATION_LENGTH_DEFAULT (1 << 20) // Elements per reduction
+#define SUMMATION_ELEMENTS_PER_RUN (1 << 25) // Elements reduced per measurement, split into repeated passes
+#define SUMMATION_PAIRWISE_BLOCK 128 // Leaf size of the pairwise recursion
+#define SUMMATION_WIDE_EXPONENT 40 // Binary exponent range of the wide distribution is [-40, 40]
+
+// Reference accumulator, quad precision when the compiler has it.
+#if TYPELESS_FLOAT128_ENABLE
+typedef typelessFloat128_t summationReference_t;
+#else // !TYPELESS_FLOAT128_ENABLE
+typedef long double summationReference_t;
+#endif // TYPELESS_FLOAT128_ENABLE
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum summationKernel_e {
+  su_naive_e = 0, // Left to right in the input type
+  su_pairwise_e = 1, // Recursive halving down to SUMMATION_PAIRWISE_BLOCK naive leaves
+  su_kahan_e = 2, // Kahan compensated
+  su_neumaier_e = 3, // Neumaier compensated, also exact when the addend is larger than the sum
+  su_wide_e = 4, // Left to right in the next wider type, float to double and double to long double
+  su_count_e = 5
+} summationKernel_et;
+
+typedef enum summationDistribution_e {
+  sd_uniform_e = 0, // (0, 1], all positive and well conditioned
+  sd_gaussian_e = 1, // Standard normal, mixed signs
+  sd_wide_e = 2, // Random sign and mantissa over 2^[-40, 40]
+  sd_cancel_e = 3, // Large values with their negations plus small uniform values, ill conditioned
+  sd_count_e = 4
+} summationDistribution_et;
+
+typedef struct summationResult {
+  double timeDelta; // Seconds for all passes
+  uint64_t cycleDelta; // Time stamp counter cycles for all passes
+  long double sum; // Result of the last pass
+} summationResult_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *summationKernelName(summationKernel_et kernel);
+
+const char *summationDistributionName(summationDistribution_et distribution);
+
+template<class classType>
+void summationFill(summationDistribution_et distribution, std::vector<classType> &values);
+
+template<class classType>
+void summationReference(const std::vector<classType> &values, summationReference_t &sum, summationReference_t &sumAbsolute);
+
+template<class classType>
+classType summationNaive(const classType *values, size_t length);
+
+template<class classType>
+classType summationPairwise(const classType *values, size_t length);
+
+template<class classType>
+classType summationKahan(const classType *values, size_t length);
+
+template<class classType>
+classType summationNeumaier(const classType *values, size_t length);
+
+template<class classType, class wideType>
+wideType summationWide(const classType *values, size_t length);
+
+template<class classType, class wideType>
+summationResult_t summationMeasure(summationKernel_et kernel, const std::vector<classType> &values, size_t passes);
+
+template<class classType, class wideType>
+void summationMeasureType(FILE *fileContext, summationDistribution_et distribution, size_t length);
+
+int testharness_Summation(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the reduction kernel.
+*****************************************************************************/
+const char *summationKernelName(summationKernel_et kernel) {
+  const char *kernelName;
+  switch (kernel) {
+    case su_naive_e:
+      kernelName = "naive";
+      break;
+    case su_pairwise_e:
+      kernelName = "pairwise";
+      break;
+    case su_kahan_e:
+      kernelName = "kahan";
+      break;
+    case su_neumaier_e:
+      kernelName = "neumaier";
+      break;
+    case su_wide_e:
+      kernelName = "wide_accumulator";
+      break;
+    default:
+      kernelName = "unknown";
+      break;
+  }
+  return kernelName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the input distribution, also the --distribution
+*          parameter.
+*****************************************************************************/
+const char *summationDistributionName(summationDistribution_et distribution) {
+  const char *distributionName;
+  switch (distribution) {
+    case sd_uniform_e:
+      distributionName = "uniform";
+      break;
+    case sd_gaussian_e:
+      distributionName = "gaussian";
+      break;
+    case sd_wide_e:
+      distributionName = "wide";
+      break;
+    case sd_cancel_e:
+      distributionName = "cancel";
+      break;
+    default:
+      distributionName = "unknown";
+      break;
+  }
+  return distributionName;
+}
+
+/******************************************************************************
+* Draws the inputs from the harness random number generator.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void summationFill(summationDistribution_et distribution, std::vector<classType> &values) {
+  size_t length = values.size();
+  size_t swapIndex;
+  double sign;
+  int exponent;
+
+  for (size_t index = 0; index < length; index++) {
+    sign = (gauss_rand<double>(1) > 0.5) ? 1.0 : -1.0;
+    switch (distribution) {
+      case sd_gaussian_e:
+        values[index] = (classType) gauss_rand<double>(3);
+        break;
+      case sd_wide_e:
+        // The draw is in (0, 1], the top bucket is clamped so the exponents stay in [-40, 40].
+        exponent = std::min((int) (gauss_rand<double>(1) * (2 * SUMMATION_WIDE_EXPONENT + 1)),
+                            2 * SUMMATION_WIDE_EXPONENT) - SUMMATION_WIDE_EXPONENT;
+        values[index] = (classType) (sign * std::ldexp(1.0 + gauss_rand<double>(1), exponent));
+        break;
+      case sd_cancel_e:
+        // Every other pair is a large value followed by its negation, the rest are small.
+        if (0 == (index & 2)) {
+          values[index] = (0 == (index & 1)) ? (classType) (sign * std::ldexp(gauss_rand<double>(1), 24))
+                                             : (classType) -values[index - 1];
+        } else {
+          values[index] = (classType) gauss_rand<double>(1);
+        }
+        break;
+      case sd_uniform_e:
+      default:
+        values[index] = (classType) gauss_rand<double>(1);
+        break;
+    }
+  }
+  if (sd_cancel_e == distribution) {
+    // Spread the cancelling pairs so their partial sums are exposed to rounding.
+    for (size_t index = length - 1; index > 0; index--) {
+      swapIndex = (size_t) (gauss_rand<double>(1) * (double) index);
+      std::swap(values[index], values[std::min(swapIndex, index)]);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Neumaier sum in the reference type. With quad precision the error is far
+* below a unit in the last place of float and double, so it serves as the
+* exact sum.
+* @return  None, the sum and the sum of magnitudes are returned by reference.
+*****************************************************************************/
+template<class classType>
+void summationReference(const std::vector<classType> &values, summationReference_t &sum,
+                        summationReference_t &sumAbsolute) {
+  summationReference_t compensation = 0, value, total;
+
+  sum = 0;
+  sumAbsolute = 0;
+  for (size_t index = 0; index < values.size(); index++) {
+    value = (summationReference_t) values[index];
+    total = sum + value;
+    if (((sum < 0) ? -sum : sum) >= ((value < 0) ? -value : value)) {
+      compensation += (sum - total) + value;
+    } else {
+      compensation += (value - total) + sum;
+    }
+    sum = total;
+    sumAbsolute += (value < 0) ? -value : value;
+  }
+  sum += compensation;
+  return;
+}
+
+/******************************************************************************
+*
+* @return  left to right sum.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+classType summationNaive(const classType *values, size_t length) {
+  classType sum = 0;
+
+  for (size_t index = 0; index < length; index++) {
+    sum += values[index];
+  }
+  return sum;
+}
+
+/******************************************************************************
+* Error grows with log2(length) instead of length.
+* @return  pairwise sum.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+classType summationPairwise(const classType *values, size_t length) {
+  size_t half;
+
+  if (length <= SUMMATION_PAIRWISE_BLOCK) {
+    return summationNaive<classType>(values, length);
+  }
+  half = length / 2;
+  return summationPairwise<classType>(values, half) + summationPairwise<classType>(values + half, length - half);
+}
+
+/******************************************************************************
+*
+* @return  Kahan compensated sum.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+classType summationKahan(const classType *values, size_t length) {
+  classType sum = 0, compensation = 0, corrected, total;
+
+  for (size_t index = 0; index < length; index++) {
+    corrected = values[index] - compensation;
+    total = sum + corrected;
+    compensation = (total - sum) - corrected;
+    sum = total;
+  }
+  return sum;
+}
+
+/******************************************************************************
+*
+* @return  Neumaier compensated sum.
+*****************************************************************************/
+template<class classType>
+__attribute__((noinline))
+classType summationNeumaier(const classType *values, size_t length) {
+  classType sum = 0, compensation = 0, total;
+
+  for (size_t index = 0; index < length; index++) {
+    total = sum + values[index];
+    if (std::fabs(sum) >= std::fabs(values[index])) {
+      compensation += (sum - total) + values[index];
+    } else {
+      compensation += (values[index] - total) + sum;
+    }
+    sum = total;
+  }
+  return sum + compensation;
+}
+
+/******************************************************************************
+*
+* @return  left to right sum in the wider type.
+*****************************************************************************/
+template<class classType, class wideType>
+__attribute__((noinline))
+wideType summationWide(const classType *values, size_t length) {
+  wideType sum = 0;
+
+  for (size_t index = 0; index < length; index++) {
+    sum += (wideType) values[index];
+  }
+  return sum;
+}
+
+/******************************************************************************
+* Repeats the reduction over the same inputs.
+* @return  time, cycles and the result of the last pass.
+*****************************************************************************/
+template<class classType, class wideType>
+summationResult_t summationMeasure(summationKernel_et kernel, const std::vector<classType> &values, size_t passes) {
+  summationResult_t result;
+  volatile long double sink = 0;
+  long double sum = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t pass = 0; pass < passes; pass++) {
+    switch (kernel) {
+      case su_pairwise_e:
+        sum = (long double) summationPairwise<classType>(values.data(), values.size());
+        break;
+      case su_kahan_e:
+        sum = (long double) summationKahan<classType>(values.data(), values.size());
+        break;
+      case su_neumaier_e:
+        sum = (long double) summationNeumaier<classType>(values.data(), values.size());
+        break;
+      case su_wide_e:
+        // The wide result is rounded to the input type, the precision an aggregator would store.
+        sum = (long double) (classType) summationWide<classType, wideType>(values.data(), values.size());
+        break;
+      case su_naive_e:
+      default:
+        sum = (long double) summationNaive<classType>(values.data(), values.size());
+        break;
+    }
+    sink = sink + sum;
+  }
+  result.cycleDelta = getCycleCount() - cycleStart;
+  result.timeDelta = getTime() - timeStart;
+  result.sum = sum;
+  return result;
+}
+
+/******************************************************************************
+* Every kernel of one input type over one distribution.
+* @return  None
+*****************************************************************************/
+template<class classType, class wideType>
+void summationMeasureType(FILE *fileContext, summationDistribution_et distribution, size_t length) {
+  std::vector<classType> values(length);
+  size_t passes = std::max((size_t) 1, (size_t) SUMMATION_ELEMENTS_PER_RUN / length);
+  const long double unitRoundoff = (long double) std::numeric_limits<classType>::epsilon() / 2;
+  summationReference_t referenceSum, referenceAbsolute;
+  long double reference, error, relativeError, ulpError, condition;
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  summationResult_t result;
+  double elements;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  summationFill<classType>(distribution, values);
+  summationReference<classType>(values, referenceSum, referenceAbsolute);
+  reference = (long double) referenceSum;
+  condition = (0 != reference) ? ((long double) referenceAbsolute / std::fabs(reference)) : INFINITY;
+  for (size_t kernel = 0; kernel < su_count_e; kernel++) {
+    frequencyStart = frequencyMonitorRead(harnessMonitor);
+    result = summationMeasure<classType, wideType>((summationKernel_et) kernel, values, passes);
+    frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+    elements = (double) passes * (double) length;
+    error = (long double) ((summationReference_t) result.sum - referenceSum);
+    error = std::fabs(error);
+    relativeError = (0 != reference) ? (error / std::fabs(reference)) : error;
+    // A unit in the last place of the exact sum rounded to the input type.
+    ulpError = (0 != reference)
+               ? (error / (std::fabs(reference) * 2 * unitRoundoff))
+               : 0;
+    resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %zu, %zu, %f, %f, %f, %e, %Le, %Le, %Lf, %Le",
+                   summationKernelName((summationKernel_et) kernel), typeNameBuffer,
+                   summationDistributionName(distribution), length, passes,
+                   (result.timeDelta * 1e9) / elements, (double) result.cycleDelta / elements,
+                   (result.timeDelta > 0.0) ? (elements / result.timeDelta) : 0.0,
+                   (result.timeDelta > 0.0) ? ((elements * sizeof(classType)) / result.timeDelta / 1e9) : 0.0,
+                   relativeError, error, ulpError, condition);
+  }
+  return;
+}
+
+/******************************************************************************
+* Reduces random inputs with naive, pairwise, compensated and wide
+* accumulator sums and reports speed beside the error against a quad
+* precision reference.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Summation(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Kernel, Type System, Distribution, Elements, Passes, Nanoseconds per Element, "
+                            "Cycles per Element, Elements per Second, Gigabytes per Second, Relative Error, "
+                            "Absolute Error, Error in ULPs, Condition Number";
+  size_t length = (options.iterations > 0) ? options.iterations : SUMMATION_LENGTH_DEFAULT;
+  size_t distributionFirst = 0, distributionLast = sd_count_e;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  FILE *fileContext;
+
+  if (NULL != options.distribution) {
+    for (distributionFirst = 0; distributionFirst < sd_count_e; distributionFirst++) {
+      if (0 == strcmp(options.distribution, summationDistributionName((summationDistribution_et) distributionFirst))) {
+        break;
+      }
+    }
+    if (sd_count_e == distributionFirst) {
+      fprintf(stderr, "Unknown distribution %s.\n", options.distribution);
+      return EXIT_FAILURE;
+    }
+    distributionLast = distributionFirst + 1;
+  }
+#if !TYPELESS_FLOAT128_ENABLE
+  printf("Quad precision is not available, the reference sum is long double.\n");
+#endif // !TYPELESS_FLOAT128_ENABLE
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("Summation", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  for (size_t distribution = distributionFirst; distribution < distributionLast; distribution++) {
+    summationMeasureType<float, double>(fileContext, (summationDistribution_et) distribution, length);
+    summationMeasureType<double, long double>(fileContext, (summationDistribution_et) distribution, length);
+  }
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKSUMMATION_HPP_
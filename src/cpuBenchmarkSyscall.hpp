@@ -0,0 +1,453 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKSYSCALL_HPP_
+#define _CPUBENCHMARKSYSCALL_HPP_
+
+// futex, eventfd and fork are Linux specific.
+#if defined(__linux__)
+#define SYSCALL_ENABLE 1
+#include <linux/futex.h>
+#include <sys/eventfd.h>
+#include <sys/syscall.h>
+#include <sys/wait.h>
+#else
+#define SYSCALL_ENABLE 0
+#endif
+
+#define SYSCALL_CALLS_DEFAULT (1 << 22) // Iterations of the plain calls
+#define SYSCALL_ROUND_TRIPS_DEFAULT (1 << 16) // Iterations of the ping-pong operations
+#define SYSCALL_THREADS_DEFAULT (1 << 12) // Iterations of pthread_create and join
+#define SYSCALL_FORKS_DEFAULT (1 << 10) // Iterations of fork and wait
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum syscallOp_e {
+  sy_getpidLibc_e = 0, // getpid through the C library
+  sy_getpidSyscall_e = 1, // syscall(SYS_getpid), always enters the kernel
+  sy_clockVdso_e = 2, // clock_gettime(CLOCK_MONOTONIC), served by the vDSO
+  sy_clockSyscall_e = 3, // syscall(SYS_clock_gettime), the same call through the kernel
+  sy_futexPingPong_e = 4, // Two threads hand a futex word back and forth
+  sy_pipePingPong_e = 5, // One byte each way through two pipes
+  sy_eventfdPingPong_e = 6, // One counter each way through two eventfds
+  sy_threadCreateJoin_e = 7, // pthread_create of an empty thread, then pthread_join
+  sy_forkWait_e = 8, // fork of a child that exits at once, then waitpid
+  sy_count_e = 9
+} syscallOp_et;
+
+typedef enum syscallPlacement_e {
+  sp_single_e = 0, // One thread, the caller
+  sp_sameCore_e = 1, // Both ping-pong threads on one core, every hand off is a context switch
+  sp_crossCore_e = 2, // Ping-pong threads on different cores, hand offs are wake ups
+  sp_count_e = 3
+} syscallPlacement_et;
+
+typedef struct alignas(CACHE_LINE_SIZE) syscallThread {
+  syscallOp_et op; // Ping-pong mechanism
+  size_t threadIndex; // Thread 0 starts every round trip and is timed
+  size_t core; // Core the thread pins itself to
+  size_t roundTrips; // Round trips to run
+  int *futexWord; // Shared futex word, 0 when thread 0 owns the ball
+  int sendDescriptor; // Pipe write end or eventfd towards the partner
+  int receiveDescriptor; // Pipe read end or eventfd from the partner
+  pthread_barrier_t *startBarrier; // Releases both threads at once
+  bool isValid; // Every call succeeded
+  double timeDelta; // Time for the round trips
+} syscallThread_t;
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+const char *syscallOpName(syscallOp_et op);
+
+const char *syscallPlacementName(syscallPlacement_et placement);
+
+#if SYSCALL_ENABLE
+void syscallFutexWait(int *word, int value);
+
+void syscallFutexWake(int *word);
+
+void *syscallEmpty_Pthread(void *inArgs);
+
+void *syscallPingPong_Pthread(void *inArgs);
+
+bool syscallRunSingle(syscallOp_et op, size_t iterations);
+
+bool syscallRunPingPong(syscallOp_et op, size_t roundTrips, size_t cores[2], double &timeDelta);
+
+void syscallMeasure(FILE *fileContext, syscallOp_et op, syscallPlacement_et placement, size_t iterations);
+#endif // SYSCALL_ENABLE
+
+int testharness_Syscall(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+*
+* @return  printable name of the operation.
+*****************************************************************************/
+const char *syscallOpName(syscallOp_et op) {
+  const char *opName;
+  switch (op) {
+    case sy_getpidLibc_e:
+      opName = "getpid_libc";
+      break;
+    case sy_getpidSyscall_e:
+      opName = "getpid_syscall";
+      break;
+    case sy_clockVdso_e:
+      opName = "clock_gettime_vdso";
+      break;
+    case sy_clockSyscall_e:
+      opName = "clock_gettime_syscall";
+      break;
+    case sy_futexPingPong_e:
+      opName = "futex_ping_pong";
+      break;
+    case sy_pipePingPong_e:
+      opName = "pipe_ping_pong";
+      break;
+    case sy_eventfdPingPong_e:
+      opName = "eventfd_ping_pong";
+      break;
+    case sy_threadCreateJoin_e:
+      opName = "pthread_create_join";
+      break;
+    case sy_forkWait_e:
+      opName = "fork_wait";
+      break;
+    default:
+      opName = "unknown";
+      break;
+  }
+  return opName;
+}
+
+/******************************************************************************
+*
+* @return  printable name of the placement.
+*****************************************************************************/
+const char *syscallPlacementName(syscallPlacement_et placement) {
+  const char *placementName;
+  switch (placement) {
+    case sp_single_e:
+      placementName = "single";
+      break;
+    case sp_sameCore_e:
+      placementName = "same_core";
+      break;
+    case sp_crossCore_e:
+      placementName = "cross_core";
+      break;
+    default:
+      placementName = "unknown";
+      break;
+  }
+  return placementName;
+}
+
+#if SYSCALL_ENABLE
+/******************************************************************************
+* Sleeps while the word holds value, spurious wake ups are left to the
+* caller's loop.
+* @return  None
+*****************************************************************************/
+void syscallFutexWait(int *word, int value) {
+  syscall(SYS_futex, word, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+  return;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+void syscallFutexWake(int *word) {
+  syscall(SYS_futex, word, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+  return;
+}
+
+/******************************************************************************
+*
+* @return  the thread arguments.
+*****************************************************************************/
+void *syscallEmpty_Pthread(void *inArgs) {
+  return inArgs;
+}
+
+/******************************************************************************
+* Thread 0 sends and waits for the reply, thread 1 waits and replies; a round
+* trip is two hand offs.
+* @return  the thread arguments.
+*****************************************************************************/
+void *syscallPingPong_Pthread(void *inArgs) {
+  syscallThread_t *threadInfo = (syscallThread_t *) inArgs;
+  const bool isInitiator = (0 == threadInfo->threadIndex);
+  const int ownValue = isInitiator ? 0 : 1; // Futex value while this thread holds the ball
+  uint64_t counter = 1;
+  uint8_t byte = 1;
+  double timeStart;
+  cpu_set_t coreSet;
+
+  CPU_ZERO(&coreSet);
+  CPU_SET(threadInfo->core, &coreSet);
+  threadInfo->isValid = (0 == pthread_setaffinity_np(pthread_self(), sizeof(coreSet), &coreSet));
+  pthread_barrier_wait(threadInfo->startBarrier);
+  timeStart = getTime();
+  for (size_t roundTrip = 0; roundTrip < threadInfo->roundTrips; roundTrip++) {
+    switch (threadInfo->op) {
+      case sy_futexPingPong_e:
+        while (ownValue != __atomic_load_n(threadInfo->futexWord, __ATOMIC_ACQUIRE)) {
+          syscallFutexWait(threadInfo->futexWord, 1 - ownValue);
+        }
+        __atomic_store_n(threadInfo->futexWord, 1 - ownValue, __ATOMIC_RELEASE);
+        syscallFutexWake(threadInfo->futexWord);
+        break;
+      case sy_eventfdPingPong_e:
+        if (isInitiator) {
+          threadInfo->isValid &= (sizeof(counter) == write(threadInfo->sendDescriptor, &counter, sizeof(counter)));
+          threadInfo->isValid &= (sizeof(counter) == read(threadInfo->receiveDescriptor, &counter, sizeof(counter)));
+        } else {
+          threadInfo->isValid &= (sizeof(counter) == read(threadInfo->receiveDescriptor, &counter, sizeof(counter)));
+          threadInfo->isValid &= (sizeof(counter) == write(threadInfo->sendDescriptor, &counter, sizeof(counter)));
+        }
+        break;
+      case sy_pipePingPong_e:
+      default:
+        if (isInitiator) {
+          threadInfo->isValid &= (1 == write(threadInfo->sendDescriptor, &byte, 1));
+          threadInfo->isValid &= (1 == read(threadInfo->receiveDescriptor, &byte, 1));
+        } else {
+          threadInfo->isValid &= (1 == read(threadInfo->receiveDescriptor, &byte, 1));
+          threadInfo->isValid &= (1 == write(threadInfo->sendDescriptor, &byte, 1));
+        }
+        break;
+    }
+  }
+  threadInfo->timeDelta = getTime() - timeStart;
+  return inArgs;
+}
+
+/******************************************************************************
+* Plain calls, thread creation and fork on the calling thread.
+* @return  true when every call succeeded.
+*****************************************************************************/
+__attribute__((noinline))
+bool syscallRunSingle(syscallOp_et op, size_t iterations) {
+  struct timespec timeValue;
+  pthread_t threadContext;
+  bool isValid = true;
+  pid_t childId;
+  int childStatus;
+
+  for (size_t iteration = 0; isValid && (iteration < iterations); iteration++) {
+    switch (op) {
+      case sy_getpidLibc_e:
+        isValid = (getpid() > 0);
+        break;
+      case sy_getpidSyscall_e:
+        isValid = (syscall(SYS_getpid) > 0);
+        break;
+      case sy_clockVdso_e:
+        isValid = (0 == clock_gettime(CLOCK_MONOTONIC, &timeValue));
+        break;
+      case sy_clockSyscall_e:
+        isValid = (0 == syscall(SYS_clock_gettime, CLOCK_MONOTONIC, &timeValue));
+        break;
+      case sy_threadCreateJoin_e:
+        isValid = (0 == pthread_create(&threadContext, NULL, syscallEmpty_Pthread, NULL)) &&
+                  (0 == pthread_join(threadContext, NULL));
+        break;
+      case sy_forkWait_e:
+        childId = fork();
+        if (0 == childId) {
+          _exit(0);
+        }
+        isValid = (childId > 0) && (childId == waitpid(childId, &childStatus, 0)) && WIFEXITED(childStatus);
+        break;
+      default:
+        isValid = false;
+        break;
+    }
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* Runs a pinned pair through the thread team; the threads pin themselves so
+* both may share one core.
+* @return  true when every call succeeded.
+*****************************************************************************/
+bool syscallRunPingPong(syscallOp_et op, size_t roundTrips, size_t cores[2], double &timeDelta) {
+  std::vector<syscallThread_t> threadInfo(2);
+  std::vector<void *> threadArgs(2);
+  pthread_barrier_t startBarrier;
+  int forward[2] = {-1, -1}, backward[2] = {-1, -1};
+  int futexWord = 0;
+  bool isValid = true;
+
+  switch (op) {
+    case sy_pipePingPong_e:
+      isValid = (0 == pipe(forward)) && (0 == pipe(backward));
+      break;
+    case sy_eventfdPingPong_e:
+      forward[0] = eventfd(0, 0);
+      forward[1] = forward[0];
+      backward[0] = eventfd(0, 0);
+      backward[1] = backward[0];
+      isValid = (forward[0] >= 0) && (backward[0] >= 0);
+      break;
+    default:
+      break;
+  }
+  if (isValid) {
+    pthread_barrier_init(&startBarrier, NULL, 2);
+    for (size_t threadIndex = 0; threadIndex < 2; threadIndex++) {
+      threadInfo[threadIndex].op = op;
+      threadInfo[threadIndex].threadIndex = threadIndex;
+      threadInfo[threadIndex].core = cores[threadIndex];
+      threadInfo[threadIndex].roundTrips = roundTrips;
+      threadInfo[threadIndex].futexWord = &futexWord;
+      threadInfo[threadIndex].sendDescriptor = (0 == threadIndex) ? forward[1] : backward[1];
+      threadInfo[threadIndex].receiveDescriptor = (0 == threadIndex) ? backward[0] : forward[0];
+      threadInfo[threadIndex].startBarrier = &startBarrier;
+      threadInfo[threadIndex].isValid = false;
+      threadInfo[threadIndex].timeDelta = 0.0;
+      threadArgs[threadIndex] = &threadInfo[threadIndex];
+    }
+    isValid = threadTeamRun(syscallPingPong_Pthread, threadArgs, false);
+    pthread_barrier_destroy(&startBarrier);
+    isValid = isValid && threadInfo[0].isValid && threadInfo[1].isValid;
+    timeDelta = threadInfo[0].timeDelta;
+  }
+  // An eventfd is both ends of its channel, close it once.
+  for (size_t end = 0; end < ((sy_eventfdPingPong_e == op) ? 1 : 2); end++) {
+    if (forward[end] >= 0) {
+      close(forward[end]);
+    }
+    if (backward[end] >= 0) {
+      close(backward[end]);
+    }
+  }
+  return isValid;
+}
+
+/******************************************************************************
+* One untimed operation first resolves the lazy library bindings and faults
+* in the stacks and buffers, so the first timed call is not a cold one.
+* @return  None
+*****************************************************************************/
+void syscallMeasure(FILE *fileContext, syscallOp_et op, syscallPlacement_et placement, size_t iterations) {
+  size_t cores[2] = {threadCoreSelect(0), threadCoreSelect((sp_crossCore_e == placement) ? 1 : 0)};
+  uint64_t cycleStart, cycleDelta;
+  double timeStart, timeDelta = 0.0;
+  bool isWarm;
+  bool isValid;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  if (sp_single_e == placement) {
+    isWarm = syscallRunSingle(op, 1);
+  } else {
+    isWarm = syscallRunPingPong(op, 1, cores, timeDelta);
+  }
+  frequencyStart = frequencyMonitorRead(harnessMonitor);
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  if (sp_single_e == placement) {
+    isValid = syscallRunSingle(op, iterations);
+    timeDelta = getTime() - timeStart;
+  } else {
+    isValid = syscallRunPingPong(op, iterations, cores, timeDelta);
+  }
+  cycleDelta = getCycleCount() - cycleStart;
+  frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+  isValid = isValid && isWarm;
+  // Plain calls have no hand off, the ping-pong cycles would include the thread start up; both cells stay empty.
+  if (sp_single_e == placement) {
+    resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %f, %f, , %f, %d", syscallOpName(op),
+                   syscallPlacementName(placement), iterations, timeDelta, (timeDelta * 1e9) / (double) iterations,
+                   (double) cycleDelta / (double) iterations, isValid ? 1 : 0);
+  } else {
+    resultPrintRow(fileContext, true, &frequency, "%s, %s, %zu, %f, %f, %f, , %d", syscallOpName(op),
+                   syscallPlacementName(placement), iterations, timeDelta, (timeDelta * 1e9) / (double) iterations,
+                   (timeDelta * 1e9) / (double) (2 * iterations), isValid ? 1 : 0);
+  }
+  return;
+}
+#endif // SYSCALL_ENABLE
+
+/******************************************************************************
+* Measures getpid and clock_gettime through the C library and as raw system
+* calls, futex, pipe and eventfd ping-pong between two pinned threads on one
+* core and on two cores, pthread_create with join and fork with wait.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Syscall(const benchmarkOptions_t &options) {
+#if SYSCALL_ENABLE
+  const char fileHeader[] = "Operation, Placement, Operations, Time for Operations, Nanoseconds per Operation, "
+                            "Nanoseconds per Hand Off, Cycles per Operation, Verified";
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  bool hasSecondCore = (threadCoreSelect(0) != threadCoreSelect(1));
+  size_t iterations;
+  FILE *fileContext;
+
+  if (!hasSecondCore) {
+    printf("Only one core is allowed, the cross core ping-pong is skipped.\n");
+  }
+  printf("Cycles are time stamp counter (nominal frequency) cycles, ping-pong operations are round trips.\n");
+  fileContext = resultFileOpen("Syscall", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  for (size_t op = 0; op < sy_count_e; op++) {
+    switch (op) {
+      case sy_futexPingPong_e:
+      case sy_pipePingPong_e:
+      case sy_eventfdPingPong_e:
+        iterations = (options.iterations > 0) ? options.iterations : SYSCALL_ROUND_TRIPS_DEFAULT;
+        syscallMeasure(fileContext, (syscallOp_et) op, sp_sameCore_e, iterations);
+        if (hasSecondCore) {
+          syscallMeasure(fileContext, (syscallOp_et) op, sp_crossCore_e, iterations);
+        }
+        break;
+      case sy_threadCreateJoin_e:
+        iterations = (options.iterations > 0) ? options.iterations : SYSCALL_THREADS_DEFAULT;
+        syscallMeasure(fileContext, (syscallOp_et) op, sp_single_e, iterations);
+        break;
+      case sy_forkWait_e:
+        iterations = (options.iterations > 0) ? options.iterations : SYSCALL_FORKS_DEFAULT;
+        syscallMeasure(fileContext, (syscallOp_et) op, sp_single_e, iterations);
+        break;
+      default:
+        iterations = (options.iterations > 0) ? options.iterations : SYSCALL_CALLS_DEFAULT;
+        syscallMeasure(fileContext, (syscallOp_et) op, sp_single_e, iterations);
+        break;
+    }
+  }
+  resultFileClose(fileContext, fileNameAbsolute);
+  return EXIT_SUCCESS;
+#else // !SYSCALL_ENABLE
+  (void) options;
+  printf("The system call family needs futex, eventfd and fork.\n");
+  return EXIT_FAILURE;
+#endif // SYSCALL_ENABLE
+}
+
+#endif // _CPUBENCHMARKSYSCALL_HPP_
@@ -0,0 +1,647 @@
+/*
+ * Written by Joseph Tarango. The original work was to develop a dynamic data
+ * type for precision related code in embedded processors. Joseph
+ * Tarango webpages can be found at http://www.josephtarango.com
+ *
+ *THIS SOFTWARE IS PROVIDED "AS IS" AND ANY EXPRESS OR IMPLIED WARRANTIES,
+ *INCLUDING, BUT NOT LIMITED TO, THE IMPLIED WARRANTIES OF MERCHANTABILITY
+ *AND FITNESS FOR A PARTICULAR PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL
+ *THE CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ *EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ *PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+ *OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+ *WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+ *OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+ *ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ =============================================================================*/
+// Included by cpuBenchmarkParallel.cpp after the harness prototypes.
+
+#ifndef _CPUBENCHMARKTRANSCENDENTAL_HPP_
+#define _CPUBENCHMARKTRANSCENDENTAL_HPP_
+
+#include <limits>
+#include <utility>
+
+// Vector libm (libmvec) entry points are resolved at run time, AVX2 variants only.
+#if (defined(__x86_64__) | defined(__i386__)) && defined(__linux__)
+#include <dlfcn.h>
+#define TRANSCENDENTAL_VECTOR_ENABLE 1
+#else
+#define TRANSCENDENTAL_VECTOR_ENABLE 0
+#endif
+
+#define TRANSCENDENTAL_ITERATIONS_DEFAULT (1 << 20)
+#define TRANSCENDENTAL_ARRAY_SIZE (1 << 12) // Power of two, the index wraps with a mask.
+#define TRANSCENDENTAL_VECTOR_BYTES 32 // AVX2 register width of the libmvec 'd' variants
+
+/*======================================================================================================================
+ * Data structures
+ * ===================================================================================================================*/
+typedef enum transcendentalOp_e {
+  to_exp_e = 0,
+  to_log_e = 1,
+  to_pow_e = 2,
+  to_sin_e = 3,
+  to_cos_e = 4,
+  to_tan_e = 5,
+  to_atan2_e = 6,
+  to_cbrt_e = 7,
+  to_hypot_e = 8,
+  to_fma_e = 9,
+  to_rsqrt_e = 10, // 1 / sqrt(x)
+  to_rcp_e = 11, // 1 / x
+  to_rsqrtApprox_e = 12, // Hardware estimate refined with Newton-Raphson
+  to_rcpApprox_e = 13, // Hardware estimate refined with Newton-Raphson
+  to_count_e = 14
+} transcendentalOp_et;
+
+typedef struct transcendentalOpInfo {
+  const char *name; // Printable function name
+  const char *vectorName; // libmvec base name, NULL when there is no vector variant
+  size_t arity; // Operands consumed
+  double lowerA, upperA; // Operand a domain
+  double lowerB, upperB; // Operand b domain
+} transcendentalOpInfo_t;
+
+// Operand domains stay away from poles and overflow so every type returns finite results.
+const transcendentalOpInfo_t transcendentalOpTable[to_count_e] = {
+  {"exp", "exp", 1, -10.0, 10.0, 0.0, 0.0},
+  {"log", "log", 1, 1e-3, 1e3, 0.0, 0.0},
+  {"pow", "pow", 2, 1e-2, 10.0, -4.0, 4.0},
+  {"sin", "sin", 1, -3.14159, 3.14159, 0.0, 0.0},
+  {"cos", "cos", 1, -3.14159, 3.14159, 0.0, 0.0},
+  {"tan", "tan", 1, -1.5, 1.5, 0.0, 0.0},
+  {"atan2", "atan2", 2, -10.0, 10.0, -10.0, 10.0},
+  {"cbrt", "cbrt", 1, -1e3, 1e3, 0.0, 0.0},
+  {"hypot", "hypot", 2, -1e2, 1e2, -1e2, 1e2},
+  {"fma", NULL, 3, -1.0, 1.0, -1.0, 1.0},
+  {"rsqrt", NULL, 1, 1e-3, 1e3, 0.0, 0.0},
+  {"rcp", NULL, 1, 1e-3, 1e3, 0.0, 0.0},
+  {"rsqrt_approx", NULL, 1, 1e-3, 1e3, 0.0, 0.0},
+  {"rcp_approx", NULL, 1, 1e-3, 1e3, 0.0, 0.0}
+};
+
+typedef struct transcendentalResult {
+  size_t resultsPerCall; // Vector width, 1 for scalar libm
+  size_t resultsFilled; // Leading entries of out written by the throughput pass
+  double latencyCycles; // Dependent chain cycles per call, chain overhead removed
+  double latencyTime; // Dependent chain seconds per call, chain overhead removed
+  double throughputCycles; // Independent cycles per result
+  double throughputTime; // Independent seconds per result
+  double ulpMax; // Largest error in units in the last place, negative when there is no reference
+  double ulpMean; // Mean error in units in the last place
+} transcendentalResult_t;
+
+template<class classType>
+struct transcendentalOperands {
+  std::vector<classType> a, b, c; // Operands in the domain of the function
+  std::vector<classType> out; // Results of the throughput pass
+};
+
+template<class classType>
+using transcendentalMeasure_ft = bool (*)(transcendentalOperands<classType> &operands, size_t iterations,
+                                         double chainCycles, double chainTime, transcendentalResult_t &result);
+
+/*======================================================================================================================
+ * Functions prototypes
+ * ===================================================================================================================*/
+template<class classType>
+classType transcendentalRsqrtApprox(classType x);
+
+template<class classType>
+classType transcendentalRcpApprox(classType x);
+
+template<size_t op, class classType>
+classType transcendentalScalar(classType a, classType b, classType c);
+
+template<class classType>
+double transcendentalUlpError(classType value, long double reference);
+
+template<class classType>
+void transcendentalOperandsFill(transcendentalOperands<classType> &operands, transcendentalOp_et op);
+
+template<class classType>
+void transcendentalUlpSummary(transcendentalOperands<classType> &operands, transcendentalOp_et op,
+                              transcendentalResult_t &result);
+
+template<class classType>
+void transcendentalChainOverhead(transcendentalOperands<classType> &operands, size_t iterations, double &chainCycles,
+                                 double &chainTime);
+
+template<size_t op, class classType>
+bool transcendentalMeasureScalar(transcendentalOperands<classType> &operands, size_t iterations,
+                                 double chainCycles, double chainTime, transcendentalResult_t &result);
+
+template<class classType, size_t... op>
+void transcendentalMeasureTableFill(transcendentalMeasure_ft<classType> measureTable[], std::index_sequence<op...>);
+
+#if TRANSCENDENTAL_VECTOR_ENABLE
+void *transcendentalVectorSymbol(void *libraryHandle, transcendentalOp_et op, bool isFloat);
+
+template<class classType>
+__attribute__((target("avx2"))) bool transcendentalMeasureVector(void *symbol, size_t arity,
+                                                                 transcendentalOperands<classType> &operands,
+                                                                 size_t iterations, double chainCycles,
+                                                                 double chainTime, transcendentalResult_t &result);
+#endif // TRANSCENDENTAL_VECTOR_ENABLE
+
+template<class classType>
+void transcendentalMeasureType(FILE *fileContext, void *libraryHandle, size_t iterations);
+
+int testharness_Transcendental(const benchmarkOptions_t &options);
+
+/*======================================================================================================================
+ * Function definition and implementation
+ * ===================================================================================================================*/
+/******************************************************************************
+* Reciprocal square root from the 12 bit hardware estimate, one Newton-Raphson
+* step for float and two for double. Long double has no estimate instruction.
+* @return  approximation of 1 / sqrt(x).
+*****************************************************************************/
+template<class classType>
+inline classType transcendentalRsqrtApprox(classType x) {
+#if defined(__x86_64__) | defined(__i386__)
+  if constexpr (std::is_same<classType, float>::value) {
+    float y = _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss(x)));
+    return y * (1.5f - 0.5f * x * y * y);
+  } else if constexpr (std::is_same<classType, double>::value) {
+    double y = (double) _mm_cvtss_f32(_mm_rsqrt_ss(_mm_set_ss((float) x)));
+    y = y * (1.5 - 0.5 * x * y * y);
+    return y * (1.5 - 0.5 * x * y * y);
+  }
+#endif
+  return (classType) 1 / std::sqrt(x);
+}
+
+/******************************************************************************
+* Reciprocal from the 12 bit hardware estimate, refined as in
+* transcendentalRsqrtApprox.
+* @return  approximation of 1 / x.
+*****************************************************************************/
+template<class classType>
+inline classType transcendentalRcpApprox(classType x) {
+#if defined(__x86_64__) | defined(__i386__)
+  if constexpr (std::is_same<classType, float>::value) {
+    float y = _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss(x)));
+    return y * (2.0f - x * y);
+  } else if constexpr (std::is_same<classType, double>::value) {
+    double y = (double) _mm_cvtss_f32(_mm_rcp_ss(_mm_set_ss((float) x)));
+    y = y * (2.0 - x * y);
+    return y * (2.0 - x * y);
+  }
+#endif
+  return (classType) 1 / x;
+}
+
+/******************************************************************************
+* The std:: overloads select expf, exp or expl from the operand type.
+* @return  op applied to the operands.
+*****************************************************************************/
+template<size_t op, class classType>
+inline classType transcendentalScalar(classType a, classType b, classType c) {
+  (void) b;
+  (void) c;
+  if constexpr (to_exp_e == op) {
+    return std::exp(a);
+  } else if constexpr (to_log_e == op) {
+    return std::log(a);
+  } else if constexpr (to_pow_e == op) {
+    return std::pow(a, b);
+  } else if constexpr (to_sin_e == op) {
+    return std::sin(a);
+  } else if constexpr (to_cos_e == op) {
+    return std::cos(a);
+  } else if constexpr (to_tan_e == op) {
+    return std::tan(a);
+  } else if constexpr (to_atan2_e == op) {
+    return std::atan2(a, b);
+  } else if constexpr (to_cbrt_e == op) {
+    return std::cbrt(a);
+  } else if constexpr (to_hypot_e == op) {
+    return std::hypot(a, b);
+  } else if constexpr (to_fma_e == op) {
+    return std::fma(a, b, c);
+  } else if constexpr (to_rsqrt_e == op) {
+    return (classType) 1 / std::sqrt(a);
+  } else if constexpr (to_rcp_e == op) {
+    return (classType) 1 / a;
+  } else if constexpr (to_rsqrtApprox_e == op) {
+    return transcendentalRsqrtApprox<classType>(a);
+  } else {
+    return transcendentalRcpApprox<classType>(a);
+  }
+}
+
+/******************************************************************************
+* Distance to the long double reference in units in the last place of
+* classType at the reference.
+* @return  error in ULP.
+*****************************************************************************/
+template<class classType>
+double transcendentalUlpError(classType value, long double reference) {
+  classType referenceRounded = (classType) reference;
+  long double ulp;
+
+  if (!std::isfinite(reference) || !std::isfinite(value)) {
+    return (value == referenceRounded) ? 0.0 : (double) std::numeric_limits<classType>::max();
+  }
+  ulp = (long double) std::nextafter(std::fabs(referenceRounded), std::numeric_limits<classType>::infinity()) -
+        (long double) std::fabs(referenceRounded);
+  if (ulp <= 0.0L) {
+    return 0.0;
+  }
+  return (double) (std::fabs((long double) value - reference) / ulp);
+}
+
+/******************************************************************************
+* Fills the operand arrays uniformly over the domain of op.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void transcendentalOperandsFill(transcendentalOperands<classType> &operands, transcendentalOp_et op) {
+  const transcendentalOpInfo_t &info = transcendentalOpTable[op];
+
+  operands.a.resize(TRANSCENDENTAL_ARRAY_SIZE);
+  operands.b.resize(TRANSCENDENTAL_ARRAY_SIZE);
+  operands.c.resize(TRANSCENDENTAL_ARRAY_SIZE);
+  operands.out.resize(TRANSCENDENTAL_ARRAY_SIZE);
+  for (size_t index = 0; index < TRANSCENDENTAL_ARRAY_SIZE; index++) {
+    operands.a[index] = (classType) (info.lowerA + (info.upperA - info.lowerA) * gauss_rand<double>(1));
+    operands.b[index] = (classType) (info.lowerB + (info.upperB - info.lowerB) * gauss_rand<double>(1));
+    operands.c[index] = (classType) (info.lowerB + (info.upperB - info.lowerB) * gauss_rand<double>(1));
+    operands.out[index] = 0;
+  }
+  return;
+}
+
+/******************************************************************************
+* Compares the throughput pass results against op evaluated in long double,
+* only the entries that pass wrote are checked. Long double itself has no
+* wider reference and reports a negative error.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void transcendentalUlpSummary(transcendentalOperands<classType> &operands, transcendentalOp_et op,
+                              transcendentalResult_t &result) {
+  long double reference;
+  double ulpError;
+  double ulpSum = 0.0;
+
+  result.ulpMax = -1.0;
+  result.ulpMean = -1.0;
+  if (std::is_same<classType, long double>::value || (0 == result.resultsFilled)) {
+    return;
+  }
+  result.ulpMax = 0.0;
+  for (size_t index = 0; index < result.resultsFilled; index++) {
+    long double a = operands.a[index];
+    long double b = operands.b[index];
+    long double c = operands.c[index];
+    switch (op) {
+      case to_exp_e:
+        reference = transcendentalScalar<to_exp_e, long double>(a, b, c);
+        break;
+      case to_log_e:
+        reference = transcendentalScalar<to_log_e, long double>(a, b, c);
+        break;
+      case to_pow_e:
+        reference = transcendentalScalar<to_pow_e, long double>(a, b, c);
+        break;
+      case to_sin_e:
+        reference = transcendentalScalar<to_sin_e, long double>(a, b, c);
+        break;
+      case to_cos_e:
+        reference = transcendentalScalar<to_cos_e, long double>(a, b, c);
+        break;
+      case to_tan_e:
+        reference = transcendentalScalar<to_tan_e, long double>(a, b, c);
+        break;
+      case to_atan2_e:
+        reference = transcendentalScalar<to_atan2_e, long double>(a, b, c);
+        break;
+      case to_cbrt_e:
+        reference = transcendentalScalar<to_cbrt_e, long double>(a, b, c);
+        break;
+      case to_hypot_e:
+        reference = transcendentalScalar<to_hypot_e, long double>(a, b, c);
+        break;
+      case to_fma_e:
+        reference = transcendentalScalar<to_fma_e, long double>(a, b, c);
+        break;
+      case to_rsqrt_e:
+      case to_rsqrtApprox_e:
+        reference = transcendentalScalar<to_rsqrt_e, long double>(a, b, c);
+        break;
+      case to_rcp_e:
+      case to_rcpApprox_e:
+      default:
+        reference = transcendentalScalar<to_rcp_e, long double>(a, b, c);
+        break;
+    }
+    ulpError = transcendentalUlpError<classType>(operands.out[index], reference);
+    result.ulpMax = std::max(result.ulpMax, ulpError);
+    ulpSum += ulpError;
+  }
+  result.ulpMean = ulpSum / (double) result.resultsFilled;
+  return;
+}
+
+/******************************************************************************
+* Times the dependent chain with the identity in place of the function, so
+* the operand injection a + accumulator * 0 can be removed from the latency.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void transcendentalChainOverhead(transcendentalOperands<classType> &operands, size_t iterations, double &chainCycles,
+                                 double &chainTime) {
+  volatile classType zeroVolatile = 0;
+  volatile classType sink;
+  classType zero = zeroVolatile;
+  classType accumulator = 0;
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    accumulator = operands.a[index] + accumulator * zero;
+    index = (index + 1) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+  }
+  chainCycles = (double) (getCycleCount() - cycleStart) / (double) iterations;
+  chainTime = (getTime() - timeStart) / (double) iterations;
+  sink = accumulator;
+  (void) sink;
+  return;
+}
+
+/******************************************************************************
+* Latency is a chain where each operand depends on the previous result
+* through a + result * 0; throughput is independent calls over the arrays.
+* @return  true, scalar libm is always available.
+*****************************************************************************/
+template<size_t op, class classType>
+bool transcendentalMeasureScalar(transcendentalOperands<classType> &operands, size_t iterations,
+                                 double chainCycles, double chainTime, transcendentalResult_t &result) {
+  volatile classType zeroVolatile = 0;
+  volatile classType sink;
+  classType zero = zeroVolatile;
+  classType accumulator = 0;
+  const classType *a = operands.a.data();
+  const classType *b = operands.b.data();
+  const classType *c = operands.c.data();
+  classType *out = operands.out.data();
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  result.resultsPerCall = 1;
+  result.resultsFilled = std::min(iterations, (size_t) TRANSCENDENTAL_ARRAY_SIZE);
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    accumulator = transcendentalScalar<op, classType>(a[index] + accumulator * zero, b[index], c[index]);
+    index = (index + 1) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+  }
+  result.latencyCycles = (double) (getCycleCount() - cycleStart) / (double) iterations - chainCycles;
+  result.latencyTime = (getTime() - timeStart) / (double) iterations - chainTime;
+  sink = accumulator;
+
+  index = 0;
+  timeStart = getTime();
+  cycleStart = getCycleCount();
+  for (size_t count = 0; count < iterations; count++) {
+    out[index] = transcendentalScalar<op, classType>(a[index], b[index], c[index]);
+    index = (index + 1) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+  }
+  result.throughputCycles = (double) (getCycleCount() - cycleStart) / (double) iterations;
+  result.throughputTime = (getTime() - timeStart) / (double) iterations;
+  (void) sink;
+  return true;
+}
+
+/******************************************************************************
+*
+* @return  None
+*****************************************************************************/
+template<class classType, size_t... op>
+void transcendentalMeasureTableFill(transcendentalMeasure_ft<classType> measureTable[], std::index_sequence<op...>) {
+  ((measureTable[op] = transcendentalMeasureScalar<op, classType>), ...);
+  return;
+}
+
+#if TRANSCENDENTAL_VECTOR_ENABLE
+/******************************************************************************
+* Looks up the AVX2 libmvec variant, i.e. _ZGVdN4v_exp or _ZGVdN8vv_powf.
+* @return  entry point, NULL when libmvec or the variant is unavailable.
+*****************************************************************************/
+void *transcendentalVectorSymbol(void *libraryHandle, transcendentalOp_et op, bool isFloat) {
+  const transcendentalOpInfo_t &info = transcendentalOpTable[op];
+  char symbolName[CHAR_BUFFER_SIZE];
+  size_t lanes = TRANSCENDENTAL_VECTOR_BYTES / (isFloat ? sizeof(float) : sizeof(double));
+
+  if ((NULL == libraryHandle) || (NULL == info.vectorName) || !__builtin_cpu_supports("avx2")) {
+    return NULL;
+  }
+  snprintf(symbolName, CHAR_BUFFER_SIZE, "_ZGVdN%zu%s_%s%s", lanes, (2 == info.arity) ? "vv" : "v",
+           info.vectorName, isFloat ? "f" : "");
+  return dlsym(libraryHandle, symbolName);
+}
+
+/******************************************************************************
+* Same latency and throughput passes as transcendentalMeasureScalar, one
+* libmvec call per AVX2 register of operands.
+* @return  true when classType has a libmvec variant.
+*****************************************************************************/
+template<class classType>
+__attribute__((target("avx2"))) bool transcendentalMeasureVector(void *symbol, size_t arity,
+                                                                 transcendentalOperands<classType> &operands,
+                                                                 size_t iterations, double chainCycles,
+                                                                 double chainTime, transcendentalResult_t &result) {
+  const size_t lanes = TRANSCENDENTAL_VECTOR_BYTES / sizeof(classType);
+  size_t calls = std::max((size_t) 1, iterations / lanes);
+  const classType *a = operands.a.data();
+  const classType *b = operands.b.data();
+  classType *out = operands.out.data();
+  volatile classType zeroVolatile = 0;
+  volatile classType sink;
+  size_t index = 0;
+  uint64_t cycleStart;
+  double timeStart;
+
+  if (NULL == symbol) {
+    return false;
+  }
+  result.resultsPerCall = lanes;
+  result.resultsFilled = std::min(calls * lanes, (size_t) TRANSCENDENTAL_ARRAY_SIZE);
+  if constexpr (std::is_same<classType, double>::value) {
+    typedef __m256d (*unary_ft)(__m256d);
+    typedef __m256d (*binary_ft)(__m256d, __m256d);
+    unary_ft unary = (unary_ft) symbol;
+    binary_ft binary = (binary_ft) symbol;
+    __m256d zero = _mm256_set1_pd(zeroVolatile);
+    __m256d accumulator = _mm256_setzero_pd();
+    __m256d operand;
+
+    timeStart = getTime();
+    cycleStart = getCycleCount();
+    for (size_t count = 0; count < calls; count++) {
+      operand = _mm256_add_pd(_mm256_loadu_pd(&a[index]), _mm256_mul_pd(accumulator, zero));
+      accumulator = (2 == arity) ? binary(operand, _mm256_loadu_pd(&b[index])) : unary(operand);
+      index = (index + lanes) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+    }
+    result.latencyCycles = (double) (getCycleCount() - cycleStart) / (double) calls - chainCycles;
+    result.latencyTime = (getTime() - timeStart) / (double) calls - chainTime;
+    sink = _mm256_cvtsd_f64(accumulator);
+
+    index = 0;
+    timeStart = getTime();
+    cycleStart = getCycleCount();
+    for (size_t count = 0; count < calls; count++) {
+      operand = _mm256_loadu_pd(&a[index]);
+      _mm256_storeu_pd(&out[index], (2 == arity) ? binary(operand, _mm256_loadu_pd(&b[index])) : unary(operand));
+      index = (index + lanes) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+    }
+  } else if constexpr (std::is_same<classType, float>::value) {
+    typedef __m256 (*unary_ft)(__m256);
+    typedef __m256 (*binary_ft)(__m256, __m256);
+    unary_ft unary = (unary_ft) symbol;
+    binary_ft binary = (binary_ft) symbol;
+    __m256 zero = _mm256_set1_ps(zeroVolatile);
+    __m256 accumulator = _mm256_setzero_ps();
+    __m256 operand;
+
+    timeStart = getTime();
+    cycleStart = getCycleCount();
+    for (size_t count = 0; count < calls; count++) {
+      operand = _mm256_add_ps(_mm256_loadu_ps(&a[index]), _mm256_mul_ps(accumulator, zero));
+      accumulator = (2 == arity) ? binary(operand, _mm256_loadu_ps(&b[index])) : unary(operand);
+      index = (index + lanes) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+    }
+    result.latencyCycles = (double) (getCycleCount() - cycleStart) / (double) calls - chainCycles;
+    result.latencyTime = (getTime() - timeStart) / (double) calls - chainTime;
+    sink = _mm256_cvtss_f32(accumulator);
+
+    index = 0;
+    timeStart = getTime();
+    cycleStart = getCycleCount();
+    for (size_t count = 0; count < calls; count++) {
+      operand = _mm256_loadu_ps(&a[index]);
+      _mm256_storeu_ps(&out[index], (2 == arity) ? binary(operand, _mm256_loadu_ps(&b[index])) : unary(operand));
+      index = (index + lanes) & (TRANSCENDENTAL_ARRAY_SIZE - 1);
+    }
+  } else {
+    return false;
+  }
+  result.throughputCycles = (double) (getCycleCount() - cycleStart) / (double) (calls * lanes);
+  result.throughputTime = (getTime() - timeStart) / (double) (calls * lanes);
+  (void) sink;
+  return true;
+}
+#endif // TRANSCENDENTAL_VECTOR_ENABLE
+
+/******************************************************************************
+* Measures every function for one type with scalar libm and, for float and
+* double, with libmvec.
+* @return  None
+*****************************************************************************/
+template<class classType>
+void transcendentalMeasureType(FILE *fileContext, void *libraryHandle, size_t iterations) {
+  const char *implementationNames[2] = {"libm", "libmvec"};
+  transcendentalMeasure_ft<classType> measureTable[to_count_e];
+  transcendentalOperands<classType> operands;
+  transcendentalResult_t result;
+  char typeNameBuffer[CHAR_BUFFER_SIZE];
+  char ulpMaxBuffer[CHAR_BUFFER_SIZE];
+  char ulpMeanBuffer[CHAR_BUFFER_SIZE];
+  double chainCycles, chainTime;
+  bool isMeasured;
+  void *symbol;
+  frequencySnapshot_t frequencyStart;
+  frequencySample_t frequency;
+
+  transcendentalMeasureTableFill<classType>(measureTable, std::make_index_sequence<to_count_e>{});
+  typelessStringName<classType>((classType) 0, typeNameBuffer, false);
+  for (size_t op = 0; op < to_count_e; op++) {
+    transcendentalOperandsFill<classType>(operands, (transcendentalOp_et) op);
+    transcendentalChainOverhead<classType>(operands, iterations, chainCycles, chainTime);
+    for (size_t implementation = 0; implementation < 2; implementation++) {
+      memset(&result, 0, sizeof(transcendentalResult_t));
+      frequencyStart = frequencyMonitorRead(harnessMonitor);
+      if (0 == implementation) {
+        isMeasured = measureTable[op](operands, iterations, chainCycles, chainTime, result);
+      } else {
+        symbol = NULL;
+        isMeasured = false;
+#if TRANSCENDENTAL_VECTOR_ENABLE
+        if (!std::is_same<classType, long double>::value) {
+          symbol = transcendentalVectorSymbol(libraryHandle, (transcendentalOp_et) op,
+                                              std::is_same<classType, float>::value);
+        }
+        isMeasured = transcendentalMeasureVector<classType>(symbol, transcendentalOpTable[op].arity, operands,
+                                                            iterations, chainCycles, chainTime, result);
+#endif // TRANSCENDENTAL_VECTOR_ENABLE
+        (void) libraryHandle;
+        (void) symbol;
+      }
+      frequency = frequencyMonitorDelta(harnessMonitor, frequencyStart);
+      if (!isMeasured) {
+        continue;
+      }
+      transcendentalUlpSummary<classType>(operands, (transcendentalOp_et) op, result);
+      // Long double has no wider reference; the error columns are left empty.
+      ulpMaxBuffer[0] = '\0';
+      ulpMeanBuffer[0] = '\0';
+      if (result.ulpMax >= 0.0) {
+        snprintf(ulpMaxBuffer, CHAR_BUFFER_SIZE, "%f", result.ulpMax);
+        snprintf(ulpMeanBuffer, CHAR_BUFFER_SIZE, "%f", result.ulpMean);
+      }
+      resultPrintRow(fileContext, true, &frequency, "%s, %s, %s, %zu, %zu, %f, %f, %f, %f, %f, %s, %s",
+                     transcendentalOpTable[op].name, typeNameBuffer, implementationNames[implementation],
+                     result.resultsPerCall, iterations, result.latencyCycles, result.latencyTime * 1e9,
+                     result.throughputCycles, result.throughputTime * 1e9,
+                     (result.throughputTime > 0.0) ? (1.0 / result.throughputTime) : 0.0,
+                     ulpMaxBuffer, ulpMeanBuffer);
+    }
+  }
+  return;
+}
+
+/******************************************************************************
+* Measures latency, throughput and accuracy of the math library functions for
+* float, double and long double, and the libmvec vector variants.
+* @return EXIT_SUCCESS when every measurement ran.
+*****************************************************************************/
+int testharness_Transcendental(const benchmarkOptions_t &options) {
+  const char fileHeader[] = "Function, Type System, Implementation, Results per Call, Results, Latency Cycles per Call, "
+                            "Latency Nanoseconds per Call, Throughput Cycles per Result, "
+                            "Throughput Nanoseconds per Result, Results per Second, Max ULP Error, Mean ULP Error";
+  size_t iterations = (options.iterations > 0) ? options.iterations : TRANSCENDENTAL_ITERATIONS_DEFAULT;
+  char fileNameAbsolute[CHAR_BUFFER_SIZE];
+  void *libraryHandle = NULL;
+  FILE *fileContext;
+
+#if TRANSCENDENTAL_VECTOR_ENABLE
+  libraryHandle = dlopen("libmvec.so.1", RTLD_NOW);
+  if (NULL == libraryHandle) {
+    printf("libmvec is not available, only scalar libm is measured.\n");
+  }
+#endif // TRANSCENDENTAL_VECTOR_ENABLE
+  printf("Cycles are time stamp counter (nominal frequency) cycles.\n");
+  fileContext = resultFileOpen("Transcendental", fileHeader, true, fileNameAbsolute);
+  if (NULL == fileContext) {
+    return EXIT_FAILURE;
+  }
+  transcendentalMeasureType<float>(fileContext, libraryHandle, iterations);
+  transcendentalMeasureType<double>(fileContext, libraryHandle, iterations);
+  transcendentalMeasureType<long double>(fileContext, libraryHandle, iterations);
+  resultFileClose(fileContext, fileNameAbsolute);
+#if TRANSCENDENTAL_VECTOR_ENABLE
+  if (NULL != libraryHandle) {
+    dlclose(libraryHandle);
+  }
+#endif // TRANSCENDENTAL_VECTOR_ENABLE
+  return EXIT_SUCCESS;
+}
+
+#endif // _CPUBENCHMARKTRANSCENDENTAL_HPP_